@@ -36,10 +36,17 @@
 namespace BlackLib
 {
 
+    // names of the BlackADC::flags values, they are used as error labels of metrics
+    static const char *const adcFlagNames[BlackIoMetrics::flagCount] =
+    {
+        "cpmgrErr", "ocpErr", "helperErr", "dtErr",
+        "readErr"
+    };
+
+
     // ######################################### BLACKCOREADC DEFINITION STARTS ########################################## //
-    BlackCoreADC::BlackCoreADC()
+    BlackCoreADC::BlackCoreADC() : adcCoreErrors(this->getErrorsFromCore())
     {
-        this->adcCoreErrors = new errorCoreADC( this->getErrorsFromCore() );
 
         this->loadDeviceTree();
         this->findHelperName();
@@ -47,26 +54,19 @@ namespace BlackLib
 
     BlackCoreADC::~BlackCoreADC()
     {
-        delete this->adcCoreErrors;
     }
 
 
     bool        BlackCoreADC::loadDeviceTree()
     {
-        std::string file = this->getSlotsFilePath();
-        std::ofstream slotsFile;
-        slotsFile.open(file.c_str(), std::ios::out);
-        if(slotsFile.fail())
+        if( not this->loadOverlay("cape-bone-iio") )
         {
-            slotsFile.close();
-            this->adcCoreErrors->dtError = true;
+            this->adcCoreErrors.dtError = true;
             return false;
         }
         else
         {
-            slotsFile << "cape-bone-iio";
-            slotsFile.close();
-            this->adcCoreErrors->dtError = false;
+            this->adcCoreErrors.dtError = false;
             return true;
         }
     }
@@ -78,13 +78,13 @@ namespace BlackLib
         if(limitedSearchResult == SEARCH_DIR_NOT_FOUND)
         {
             this->helperName = "helper." + DEFAULT_HELPER_NUMBER;
-            this->adcCoreErrors->helperError = true;
+            this->adcCoreErrors.helperError = true;
             return false;
         }
         else
         {
             this->helperName = limitedSearchResult;
-            this->adcCoreErrors->helperError = false;
+            this->adcCoreErrors.helperError = false;
             return true;
         }
     }
@@ -97,7 +97,7 @@ namespace BlackLib
 
     errorCoreADC *BlackCoreADC::getErrorsFromCoreADC()
     {
-        return (this->adcCoreErrors);
+        return &(this->adcCoreErrors);
     }
 
     // ########################################## BLACKCOREADC DEFINITION ENDS ########################################### //
@@ -112,41 +112,44 @@ namespace BlackLib
 
 
     // ########################################### BLACKADC DEFINITION STARTS ############################################ //
-    BlackADC::BlackADC(adcName adc)
+    BlackADC::BlackADC(adcName adc) : adcErrors(this->getErrorsFromCoreADC()), ioMetrics("adc", adcFlagNames)
     {
-        this->adcErrors                 = new errorADC( this->getErrorsFromCoreADC() );
         this->ainName                   = adc;
         this->ainPath                   = this->getHelperPath() + "/AIN" + tostr(this->ainName);
+        this->ainFD                     = -1;
     }
 
 
     BlackADC::~BlackADC()
     {
-        delete this->adcErrors;
+        if( this->ainFD >= 0 )
+        {
+            ::close(this->ainFD);
+        }
     }
 
 
-    std::string BlackADC::getValue()
+    bool        BlackADC::openAinFile()
     {
-        std::string returnStr = FILE_COULD_NOT_OPEN_STRING;
-        std::ifstream adcValueFile;
-
-        adcValueFile.open(ainPath.c_str(),std::ios::in);
-        if(adcValueFile.fail())
+        if( this->ainFD < 0 )
         {
-            adcValueFile.close();
-            this->adcErrors->readError = true;
+            this->ainFD = ::open(this->ainPath.c_str(), O_RDONLY | O_CLOEXEC);
         }
-        else
-        {
-            returnStr.clear();
-            adcValueFile >> returnStr;
 
-            adcValueFile.close();
-            this->adcErrors->readError = false;
+        return (this->ainFD >= 0);
+    }
+
+
+    std::string BlackADC::getValue()
+    {
+        BlackResult<int> result = this->tryGetValue();
+
+        if( not result )
+        {
+            return FILE_COULD_NOT_OPEN_STRING;
         }
 
-        return returnStr;
+        return intToString(result.getValue());
     }
 
     adcName     BlackADC::getName()
@@ -157,47 +160,52 @@ namespace BlackLib
 
     int         BlackADC::getNumericValue()
     {
-        int readValue = FILE_COULD_NOT_OPEN_INT;
-        std::ifstream adcValueFile;
+        return this->tryGetValue().getValueOr(FILE_COULD_NOT_OPEN_INT);
+    }
 
-        adcValueFile.open(this->ainPath.c_str(),std::ios::in);
-        if(adcValueFile.fail())
+    BlackResult<int> BlackADC::tryGetValue()
+    {
+        BLACKLIB_TRACE_SCOPE(TraceAdcRead, static_cast<uint32_t>(this->ainName), 0, this->adcErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 0, readErr, this->adcErrors.readError);
+
+        if( ! this->openAinFile() )
         {
-            adcValueFile.close();
-            this->adcErrors->readError=true;
+            this->adcErrors.readError = true;
+            return BlackResult<int>(BlackError::OpenFailed, errno);
         }
-        else
+
+        char readBuffer[16];
+        ssize_t readSize = ::pread(this->ainFD, readBuffer, sizeof(readBuffer), 0);
+        if( readSize < 0 )
+        {
+            this->adcErrors.readError = true;
+            return BlackResult<int>(BlackError::ReadFailed, errno);
+        }
+        BLACKLIB_TRACE_BYTES(readSize);
+        BLACKLIB_METRICS_BYTES(readSize);
+
+        int64_t readValue = 0;
+        if( ! charsToInt(readBuffer, static_cast<size_t>(readSize), readValue) )
         {
-            adcValueFile >> readValue;
-            adcValueFile.close();
-            this->adcErrors->readError=false;
+            this->adcErrors.readError = true;
+            return BlackResult<int>(BlackError::ParseFailed, 0);
         }
 
-        return readValue;
+        this->adcErrors.readError = false;
+        return BlackResult<int>(static_cast<int>(readValue));
     }
 
     float       BlackADC::getConvertedValue(digitAfterPoint mode)
     {
-        int valueInt = 0;
-
-        std::ifstream adcValueFile;
+        BlackResult<int> result = this->tryGetValue();
 
-        adcValueFile.open(this->ainPath.c_str(),std::ios::in);
-        if(adcValueFile.fail())
+        if( not result )
         {
-            adcValueFile.close();
-            this->adcErrors->readError=true;
             return FILE_COULD_NOT_OPEN_FLOAT;
         }
-        else
-        {
-            adcValueFile >> valueInt;
-            adcValueFile.close();
-            this->adcErrors->readError=false;
-        }
 
 
-        float valueFloat    = static_cast<float>(valueInt);
+        float valueFloat    = static_cast<float>(result.getValue());
 
         if( mode == dap3 )
         {
@@ -225,71 +233,42 @@ namespace BlackLib
 
     bool        BlackADC::fail()
     {
-        return (this->adcErrors->adcCoreErrors->coreErrors->capeMgrError or
-                this->adcErrors->adcCoreErrors->coreErrors->ocpError or
-                this->adcErrors->adcCoreErrors->helperError or
-                this->adcErrors->adcCoreErrors->dtError or
-                this->adcErrors->readError);
+        return (this->adcErrors.adcCoreErrors->coreErrors->capeMgrError or
+                this->adcErrors.adcCoreErrors->coreErrors->ocpError or
+                this->adcErrors.adcCoreErrors->helperError or
+                this->adcErrors.adcCoreErrors->dtError or
+                this->adcErrors.readError);
     }
 
     bool        BlackADC::fail(BlackADC::flags f)
     {
-        if(f==cpmgrErr) { return this->adcErrors->adcCoreErrors->coreErrors->capeMgrError;  }
-        if(f==ocpErr)   { return this->adcErrors->adcCoreErrors->coreErrors->ocpError;      }
-        if(f==helperErr){ return this->adcErrors->adcCoreErrors->helperError;               }
-        if(f==dtErr)    { return this->adcErrors->adcCoreErrors->dtError;                   }
-        if(f==readErr)  { return this->adcErrors->readError;                                }
+        if(f==cpmgrErr) { return this->adcErrors.adcCoreErrors->coreErrors->capeMgrError;   }
+        if(f==ocpErr)   { return this->adcErrors.adcCoreErrors->coreErrors->ocpError;       }
+        if(f==helperErr){ return this->adcErrors.adcCoreErrors->helperError;                }
+        if(f==dtErr)    { return this->adcErrors.adcCoreErrors->dtError;                    }
+        if(f==readErr)  { return this->adcErrors.readError;                                 }
 
         return true;
     }
 
+    BlackIoMetrics *BlackADC::getMetrics()
+    {
+        return &(this->ioMetrics);
+    }
+
 
 
 
     BlackADC&   BlackADC::operator>>(std::string &readToThis)
     {
-        std::string readValue = FILE_COULD_NOT_OPEN_STRING;
-        std::ifstream adcValueFile;
-
-        adcValueFile.open(ainPath.c_str(),std::ios::in);
-        if(adcValueFile.fail())
-        {
-            adcValueFile.close();
-            this->adcErrors->readError = true;
-        }
-        else
-        {
-            readValue.clear();
-            adcValueFile >> readValue;
-
-            adcValueFile.close();
-            this->adcErrors->readError = false;
-        }
-
-        readToThis = readValue;
+        readToThis = this->getValue();
         return *this;
     }
 
 
     BlackADC&   BlackADC::operator>>(int &readToThis)
     {
-        int readValue = FILE_COULD_NOT_OPEN_INT;
-        std::ifstream adcValueFile;
-
-        adcValueFile.open(this->ainPath.c_str(),std::ios::in);
-        if(adcValueFile.fail())
-        {
-            adcValueFile.close();
-            this->adcErrors->readError=true;
-        }
-        else
-        {
-            adcValueFile >> readValue;
-            adcValueFile.close();
-            this->adcErrors->readError=false;
-        }
-
-        readToThis = readValue;
+        readToThis = this->getNumericValue();
         return *this;
     }
 
@@ -35,6 +35,8 @@
 #include <cmath>           // need for round() function in BlackADC::getParsedValue()
 #include <string>
 #include <fstream>
+#include <unistd.h>
+#include <fcntl.h>
 
 
 
@@ -79,7 +81,7 @@ namespace BlackLib
     class BlackCoreADC : virtual private BlackCore
     {
         private:
-            errorCoreADC    *adcCoreErrors;         /*!< @brief is used to hold the errors of BlackCoreADC class */
+            errorCoreADC     adcCoreErrors;         /*!< @brief is used to hold the errors of BlackCoreADC class */
             std::string     helperName;             /*!< @brief is used to hold the helper(analog input device driver) name */
 
             /*! @brief Loads ADC overlay to device tree.
@@ -130,8 +132,6 @@ namespace BlackLib
                             BlackCoreADC();
 
             /*! @brief Destructor of BlackCoreADC class.
-            *
-            * This function deletes errorCoreADC struct pointer.
             */
             virtual         ~BlackCoreADC();
 
@@ -254,8 +254,17 @@ namespace BlackLib
     class BlackADC : virtual private BlackCoreADC
     {
         private:
-            errorADC        *adcErrors;             /*!< @brief is used to hold the errors of BlackADC class */
+            errorADC         adcErrors;             /*!< @brief is used to hold the errors of BlackADC class */
+            BlackIoMetrics   ioMetrics;             /*!< @brief is used to hold the I/O metrics of BlackADC class */
             std::string     ainPath;                /*!< @brief is used to hold the AINx file path */
+            int             ainFD;                  /*!< @brief is used to hold the AINx file's file descriptor */
+
+            /*! @brief Opens AINx file, if it is not opened yet.
+            *
+            * The file descriptor is held until object destruction, so every read is done with one pread() call.
+            * @return True if BlackADC::ainFD holds an open file descriptor, else false.
+            */
+            bool            openAinFile();
             adcName         ainName;                /*!< @brief is used to hold the selected adc name */
 
 
@@ -293,7 +302,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackADC class.
             *
-            * This function deletes errorADC struct pointer.
+            * This function closes AINx file.
             */
             virtual         ~BlackADC();
 
@@ -339,6 +348,15 @@ namespace BlackLib
             */
             int             getNumericValue();
 
+            /*! @brief Reads analog input DC value(mV) and returns it with an error code.
+            *
+            *  This function works like getNumericValue(), but errors are returned with the value instead of
+            *  sentinel numbers. fail() flags are updated too.
+            *
+            *  @return Value in millivolts, or BlackLib::BlackError::OpenFailed, ReadFailed or ParseFailed.
+            */
+            BlackResult<int> tryGetValue();
+
             /*! @brief Reads converted analog input DC value(Volt).
             *
             * This function reads specified file from path, where defined at BlackADC::ainPath
@@ -464,6 +482,18 @@ namespace BlackLib
             */
             bool            fail(BlackADC::flags f);
 
+            /*! @brief Exports I/O metrics of the object.
+            *
+            * Operations aren't measured until the returned metrics are registered with BlackMetrics::add().
+            * @return Pointer of BlackADC::ioMetrics variable.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackMetrics::add("my_adc", myAdc.getMetrics());
+            * @endcode
+            */
+            BlackIoMetrics *getMetrics();
+
             /*! @brief Reads analog input DC value(mV) with ">>" operator.
             *
             *  This function reads specified file from path, where defined at BlackADC::ainPath
@@ -0,0 +1,99 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackAdaptiveMutex.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ########################################## BLACKADAPTIVEMUTEX DEFINITION STARTS ######################################## //
+    BlackAdaptiveMutex::BlackAdaptiveMutex(unsigned int spins)
+    {
+        this->state     = 0;
+        this->spinCount = spins;
+    }
+
+    void BlackAdaptiveMutex::lock()
+    {
+        unsigned int spins = isSpinningUseful() ? this->spinCount : 1;
+
+        for( unsigned int i = 0 ; i < spins ; i++ )
+        {
+            if( this->state == 0 and __sync_bool_compare_and_swap( &(this->state), 0, 1) )
+            {
+                return;
+            }
+
+            cpuRelax();
+        }
+
+        // mark as contended, so the owner wakes us up at unlock()
+        int previous = __sync_lock_test_and_set( &(this->state), 2);
+
+        while( previous != 0 )
+        {
+            syscall(SYS_futex, &(this->state), FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+            previous = __sync_lock_test_and_set( &(this->state), 2);
+        }
+    }
+
+    bool BlackAdaptiveMutex::tryLock()
+    {
+        return __sync_bool_compare_and_swap( &(this->state), 0, 1);
+    }
+
+    void BlackAdaptiveMutex::unlock()
+    {
+        if( __sync_fetch_and_sub( &(this->state), 1) != 1 )
+        {
+            this->state = 0;
+            __sync_synchronize();
+            syscall(SYS_futex, &(this->state), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+        }
+    }
+
+    bool BlackAdaptiveMutex::isLocked()
+    {
+        return (this->state != 0);
+    }
+
+    void BlackAdaptiveMutex::setSpinCount(unsigned int spins)
+    {
+        this->spinCount = spins;
+    }
+    // ########################################### BLACKADAPTIVEMUTEX DEFINITION ENDS ######################################### //
+
+
+} /* namespace BlackLib */
@@ -0,0 +1,117 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKADAPTIVEMUTEX_H_
+#define BLACKADAPTIVEMUTEX_H_
+
+#include "../BlackSpinLock/BlackSpinLock.h"
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+
+namespace BlackLib
+{
+
+    // ######################################### BLACKADAPTIVEMUTEX DECLARATION STARTS ######################################## //
+
+    /*! @brief Mutex which spins for a while and then sleeps on a futex.
+    *
+    *    Most of the locks are released a short time after they are taken, so this class first spins
+    *    for a limited number of tries. If the lock is still held, the thread sleeps in the kernel with
+    *    the futex system call and it is woken up by unlock(). On single cpu systems it doesn't spin. Uncontended lock() and unlock() calls are
+    *    a single atomic operation each and they don't enter the kernel.
+    *
+    *    Lock word has three states: 0 is unlocked, 1 is locked without waiters and 2 is locked with
+    *    possible waiters. unlock() makes the wake-up system call at the last state only.
+    *    It is not recursive.
+    *
+    * @par Example
+    *  @code{.cpp}
+    *   BlackLib::BlackAdaptiveMutex bufferMutex;
+    *
+    *   void push(int value)
+    *   {
+    *       BlackLib::BlackLockGuard<BlackLib::BlackAdaptiveMutex> guard(bufferMutex);
+    *       // modify the shared buffer here
+    *   }
+    * @endcode
+    */
+    class BlackAdaptiveMutex
+    {
+        public:
+            /*! @brief Constructor of BlackAdaptiveMutex class.
+            *
+            * @param [in] spins     try count before sleeping
+            */
+            BlackAdaptiveMutex(unsigned int spins = 100);
+
+            /*! @brief Locks the mutex, waits until it is available.
+            */
+            void lock();
+
+            /*! @brief Tries to lock the mutex without waiting.
+            *
+            * @return true if the mutex is locked else false.
+            */
+            bool tryLock();
+
+            /*! @brief Unlocks the mutex.
+            */
+            void unlock();
+
+            /*! @brief Checks the mutex lock state.
+            *
+            * @return true if the mutex is held by a thread else false.
+            */
+            bool isLocked();
+
+            /*! @brief Changes the try count before sleeping.
+            *
+            * @param [in] spins     new try count
+            */
+            void setSpinCount(unsigned int spins);
+
+        private:
+            volatile int            state;               /*!< @brief is used to hold the lock word */
+            unsigned int            spinCount;           /*!< @brief is used to hold the try count before sleeping */
+
+            BlackAdaptiveMutex(const BlackAdaptiveMutex&);
+            BlackAdaptiveMutex& operator=(const BlackAdaptiveMutex&);
+    };
+
+    // ########################################## BLACKADAPTIVEMUTEX DECLARATION ENDS ######################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKADAPTIVEMUTEX_H_ */
@@ -0,0 +1,292 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackBoard.h"
+
+
+
+namespace BlackLib
+{
+
+    /*!
+    * Physical base addresses of GPIO0, GPIO1, GPIO2 and GPIO3 on AM335x.
+    */
+    static const off_t      gpioBaseAddress[4]      = { 0x44E07000, 0x4804C000, 0x481AC000, 0x481AE000 };
+    static const size_t     gpioPageSize            = 0x1000;
+
+
+    // ########################################### BLACKBOARD DEFINITION STARTS ########################################### //
+    BlackBoard::BlackBoard()
+    {
+        this->slotsFD = -1;
+        this->memFD   = -1;
+
+        for( int i = 0 ; i < 4 ; i++ )
+        {
+            this->gpioRegisters[i] = NULL;
+        }
+
+        this->findCapeMgrName();
+        this->findOcpName();
+        this->slotsFilePath = "/sys/devices/" + this->capeMgrName + "/slots";
+    }
+
+    BlackBoard::~BlackBoard()
+    {
+        if( this->slotsFD >= 0 )
+        {
+            ::close(this->slotsFD);
+        }
+
+        for( int i = 0 ; i < 4 ; i++ )
+        {
+            if( this->gpioRegisters[i] != NULL )
+            {
+                munmap(const_cast<uint32_t*>(this->gpioRegisters[i]), gpioPageSize);
+            }
+        }
+
+        if( this->memFD >= 0 )
+        {
+            ::close(this->memFD);
+        }
+    }
+
+    BlackBoard &BlackBoard::getDefault()
+    {
+        static BlackBoard defaultBoard;
+        return defaultBoard;
+    }
+
+    std::string BlackBoard::searchDirectory(const std::string &searchIn, const std::string &searchThis)
+    {
+        std::string str;
+        DIR *path;
+        dirent *entry;
+
+        path = opendir(searchIn.c_str());
+        if( path != NULL  )
+        {
+            while( (entry = readdir(path)) != NULL)
+            {
+                if( entry->d_name[0] == '.')
+                {
+                    continue;
+                }
+
+                str = entry->d_name;
+                if(strstr(entry->d_name,searchThis.c_str()) != NULL )
+                {
+                    closedir(path);
+                    return str;
+                }
+            }
+            closedir(path);
+        }
+
+        return SEARCH_DIR_NOT_FOUND;
+    }
+
+    bool        BlackBoard::findCapeMgrName()
+    {
+        std::string searchResult = this->searchDirectory("/sys/devices/","bone_capemgr.");
+
+        if(searchResult == SEARCH_DIR_NOT_FOUND)
+        {
+            this->capeMgrName = "bone_capemgr." + DEFAULT_CAPE_MGR_NUMBER;
+            this->boardErrors.capeMgrError = true;
+            return false;
+        }
+        else
+        {
+            this->capeMgrName = searchResult;
+            this->boardErrors.capeMgrError = false;
+            return true;
+        }
+    }
+
+    bool        BlackBoard::findOcpName()
+    {
+        std::string searchResult = this->searchDirectory("/sys/devices/","ocp.");
+
+        if(searchResult == SEARCH_DIR_NOT_FOUND)
+        {
+            this->ocpName = "ocp." + DEFAULT_OCP_NUMBER;
+            this->boardErrors.ocpError = true;
+            return false;
+        }
+        else
+        {
+            this->ocpName = searchResult;
+            this->boardErrors.ocpError = false;
+            return true;
+        }
+    }
+
+
+
+    std::string BlackBoard::getCapeMgrName()
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+        return this->capeMgrName;
+    }
+
+    std::string BlackBoard::getOcpName()
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+        return this->ocpName;
+    }
+
+    std::string BlackBoard::getSlotsFilePath()
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+        return this->slotsFilePath;
+    }
+
+    errorCore   *BlackBoard::getErrors()
+    {
+        return &(this->boardErrors);
+    }
+
+
+
+    bool        BlackBoard::loadOverlay(const std::string &overlayName)
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+
+        if( this->loadedOverlays.count(overlayName) != 0 )
+        {
+            return true;
+        }
+
+        if( this->slotsFD < 0 )
+        {
+            this->slotsFD = ::open(this->slotsFilePath.c_str(), O_WRONLY | O_CLOEXEC);
+            if( this->slotsFD < 0 )
+            {
+                return false;
+            }
+        }
+
+        // capemgr parses every write as one command, so the offset doesn't matter
+        ssize_t written = ::pwrite(this->slotsFD, overlayName.c_str(), overlayName.size(), 0);
+        if( written == static_cast<ssize_t>(overlayName.size()) or (written < 0 and errno == EEXIST) )
+        {
+            this->loadedOverlays.insert(overlayName);
+        }
+
+        return true;
+    }
+
+    bool        BlackBoard::isOverlayLoaded(const std::string &overlayName)
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+        return (this->loadedOverlays.count(overlayName) != 0);
+    }
+
+    std::string BlackBoard::searchOcp(const std::string &subDirectory, const std::string &searchThis)
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+
+        std::string searchPath = "/sys/devices/" + this->ocpName + "/" + subDirectory;
+        std::string cacheKey   = searchPath + '\n' + searchThis;
+
+        std::map<std::string, std::string>::iterator cached = this->ocpSearchCache.find(cacheKey);
+        if( cached != this->ocpSearchCache.end() )
+        {
+            return cached->second;
+        }
+
+        std::string searchResult = this->searchDirectory(searchPath, searchThis);
+        if( searchResult != SEARCH_DIR_NOT_FOUND )
+        {
+            this->ocpSearchCache[cacheKey] = searchResult;
+        }
+
+        return searchResult;
+    }
+
+    volatile uint32_t *BlackBoard::getGpioRegisters(unsigned bank)
+    {
+        if( bank >= 4 )
+        {
+            return NULL;
+        }
+
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+
+        if( this->gpioRegisters[bank] != NULL )
+        {
+            return this->gpioRegisters[bank];
+        }
+
+        if( this->memFD < 0 )
+        {
+            this->memFD = ::open("/dev/mem", O_RDWR | O_SYNC | O_CLOEXEC);
+            if( this->memFD < 0 )
+            {
+                return NULL;
+            }
+        }
+
+        void *page = mmap(NULL, gpioPageSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->memFD, gpioBaseAddress[bank]);
+        if( page == MAP_FAILED )
+        {
+            return NULL;
+        }
+
+        this->gpioRegisters[bank] = static_cast<volatile uint32_t*>(page);
+        return this->gpioRegisters[bank];
+    }
+
+    bool        BlackBoard::rescan()
+    {
+        BlackLockGuard<BlackMutex> guard(this->boardMutex);
+
+        if( this->slotsFD >= 0 )
+        {
+            ::close(this->slotsFD);
+            this->slotsFD = -1;
+        }
+
+        this->loadedOverlays.clear();
+        this->ocpSearchCache.clear();
+
+        bool isCapeMgrFound = this->findCapeMgrName();
+        bool isOcpFound     = this->findOcpName();
+        this->slotsFilePath = "/sys/devices/" + this->capeMgrName + "/slots";
+
+        return (isCapeMgrFound and isOcpFound);
+    }
+
+    // ############################################ BLACKBOARD DEFINITION ENDS ############################################ //
+
+} /* namespace BlackLib */
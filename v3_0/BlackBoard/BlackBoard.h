@@ -0,0 +1,228 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKBOARD_H_
+#define BLACKBOARD_H_
+
+#include "../BlackErr.h"
+#include "../BlackDef.h"
+#include "../BlackMutex/BlackMutex.h"
+
+#include <string>
+#include <set>
+#include <map>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstdint>
+#include <sys/mman.h>
+#include <dirent.h>         // need for dirent struct in BlackBoard::searchDirectory()
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKBOARD DECLARATION STARTS ########################################## //
+
+    /*! @brief Shared board context of the peripheral objects.
+    *
+    *    This class holds the board wide state which used to be rebuilt by every peripheral object:
+    *    capemgr and ocp directory names, their error flags, the loaded device tree overlays, the
+    *    capemgr @b slots file descriptor and the results of ocp directory searches. It is created
+    *    once per process, when it is used first time, and every BlackCore object borrows it by
+    *    reference. So constructing a peripheral object doesn't scan the @b "/sys/devices/" directory
+    *    and an overlay is written to the slots file only once, even if hundreds of objects need it.
+    *
+    *    Overlays which are loaded or unloaded outside of the library and renamed ocp directories
+    *    can't be seen by the cached state; rescan() can be used in this case.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   BlackLib::BlackBoard &board = BlackLib::BlackBoard::getDefault();
+    *
+    *   std::cout << "capemgr: " << board.getCapeMgrName() << std::endl;
+    *   std::cout << "ocp    : " << board.getOcpName() << std::endl;
+    *
+    *   BlackLib::BlackADC  analog(BlackLib::AIN0);     // loads cape-bone-iio
+    *   BlackLib::BlackADC  analog2(BlackLib::AIN1);    // doesn't write to the slots file again
+    *
+    *   std::cout << board.isOverlayLoaded("cape-bone-iio") << std::endl;
+    * @endcode
+    */
+    class BlackBoard
+    {
+        private:
+            errorCore                           boardErrors;        /*!< @brief is used to hold the errors of capemgr and ocp finding */
+            std::string                         capeMgrName;        /*!< @brief is used to hold the capemgr name */
+            std::string                         ocpName;            /*!< @brief is used to hold the ocp name */
+            std::string                         slotsFilePath;      /*!< @brief is used to hold the slots file path */
+            int                                 slotsFD;            /*!< @brief is used to hold the slots file descriptor */
+            std::set<std::string>               loadedOverlays;     /*!< @brief is used to hold the overlays which are loaded by library */
+            std::map<std::string, std::string>  ocpSearchCache;     /*!< @brief is used to hold the found ocp directory entries */
+            int                                 memFD;              /*!< @brief is used to hold the /dev/mem file descriptor */
+            volatile uint32_t                  *gpioRegisters[4];   /*!< @brief is used to hold the mapped GPIO bank registers */
+            BlackMutex                          boardMutex;         /*!< @brief is used to protect the board state */
+
+            /*! @brief Constructor of BlackBoard class.
+            *
+            * This function runs findCapeMgrName() and findOcpName() functions. It is called
+            * only from getDefault() function.
+            */
+                                                BlackBoard();
+
+            /*! @brief Copy constructor of BlackBoard class, it is not defined.
+            */
+                                                BlackBoard(const BlackBoard &);
+
+            /*! @brief Assignment operator of BlackBoard class, it is not defined.
+            */
+            BlackBoard                          &operator=(const BlackBoard &);
+
+            /*! @brief Finds full name of capemgr directory.
+            *
+            *  This function searches @b "/sys/devices/" directory,
+            *  to find directory which starts with @b "bone_capemgr."
+            *  @return True if successful, else false.
+            *  @sa BlackBoard::searchDirectory()
+            */
+            bool                                findCapeMgrName();
+
+            /*! @brief Finds full name of ocp directory.
+            *
+            *  This function searches @b "/sys/devices/" directory,
+            *  to find directory which starts with @b "ocp."
+            *  @return True if successful, else false.
+            *  @sa BlackBoard::searchDirectory()
+            */
+            bool                                findOcpName();
+
+            /*! @brief Searches specified directory to find specified file/directory.
+            *
+            *  @param[in] searchIn searching directory
+            *  @param[in] searchThis search file/directory
+            *  @return Full name of searching file/directory.
+            */
+            std::string                         searchDirectory(const std::string &searchIn, const std::string &searchThis);
+
+
+
+        public:
+
+            /*! @brief Destructor of BlackBoard class.
+            *
+            * This function closes the slots file and unmaps GPIO registers.
+            */
+                                                ~BlackBoard();
+
+            /*! @brief Exports the board context of the process.
+            *
+            * The context is created and the directories are searched at the first call.
+            *  @return Reference of the process wide BlackBoard object.
+            */
+            static BlackBoard                   &getDefault();
+
+            /*! @brief Exports capemgr name.
+            *
+            *  @return BlackBoard::capeMgrName variable.
+            */
+            std::string                         getCapeMgrName();
+
+            /*! @brief Exports ocp name.
+            *
+            *  @return BlackBoard::ocpName variable.
+            */
+            std::string                         getOcpName();
+
+            /*! @brief Exports slots file path.
+            *
+            *  @return BlackBoard::slotsFilePath variable.
+            */
+            std::string                         getSlotsFilePath();
+
+            /*! @brief Exports errorCore struct which is shared by all peripheral objects.
+            *
+            *  @return errorCore struct pointer.
+            */
+            errorCore                           *getErrors();
+
+            /*! @brief Loads device tree overlay.
+            *
+            * If the overlay was loaded before by the library, this function doesn't do anything.
+            * Otherwise it writes the overlay name to the slots file. The slots file is opened at
+            * the first call and it stays open. The loading errors of capemgr aren't reported like
+            * before, but the overlay is remembered only if capemgr accepted it or it had already
+            * been loaded, so a failed overlay is written again at the next call.
+            *  @param[in] overlayName name of device tree overlay
+            *  @return False if the slots file can't be opened, else true.
+            */
+            bool                                loadOverlay(const std::string &overlayName);
+
+            /*! @brief Checks the overlay is loaded by library or not.
+            *
+            *  @param[in] overlayName name of device tree overlay
+            *  @return True if the overlay is loaded, else false.
+            */
+            bool                                isOverlayLoaded(const std::string &overlayName);
+
+            /*! @brief Searches ocp directory to find specified file/directory.
+            *
+            * Found entries are cached, so same search doesn't read the directory again. Not found
+            * entries aren't cached, because they can appear after loading an overlay.
+            *  @param[in] subDirectory directory under the ocp directory, it can be empty
+            *  @param[in] searchThis search file/directory
+            *  @return Full name of searching file/directory or SEARCH_DIR_NOT_FOUND.
+            */
+            std::string                         searchOcp(const std::string &subDirectory, const std::string &searchThis);
+
+            /*! @brief Exports registers of GPIO bank.
+            *
+            * The register page of the bank is mapped from /dev/mem at the first call and it is shared
+            * by all callers until the process ends. Direction and clock of the pins aren't changed, so
+            * the pins should be exported and configured before (like BlackGPIO constructor does).
+            *  @param[in] bank GPIO bank number, 0 to 3
+            *  @return Pointer of the first register of the bank or NULL if mapping fails.
+            */
+            volatile uint32_t                   *getGpioRegisters(unsigned bank);
+
+            /*! @brief Searches capemgr and ocp directories again and clears cached states.
+            *
+            * Objects which are constructed before calling this function keep their paths.
+            *  @return True if both of the directories are found, else false.
+            */
+            bool                                rescan();
+    };
+    // ############################################ BLACKBOARD DECLARATION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKBOARD_H_ */
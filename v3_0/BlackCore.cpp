@@ -39,123 +39,42 @@ namespace BlackLib
 {
 
     // ########################################### BLACKCORE DEFINITION STARTS ########################################### //
-    BlackCore::BlackCore()
+    BlackCore::BlackCore() : board(BlackBoard::getDefault())
     {
-        this->coreErrors = new errorCore();
-
-        this->findCapeMgrName();
-        this->findOcpName();
-        this->slotsFilePath = "/sys/devices/" + this->capeMgrName + "/slots";
     }
 
     BlackCore::~BlackCore()
     {
-        delete this->coreErrors;
     }
 
     std::string BlackCore::executeCommand(std::string command)
     {
-        FILE* pipe = popen(command.c_str(), "r");
-        if ( pipe==NULL )
-        {
-            return "ERROR";
-        }
-
-        char buffer[128];
-        std::string result = "";
-
-        while( !feof(pipe) )
-        {
-            if( fgets(buffer, 128, pipe) != NULL )
-            {
-                result += buffer;
-            }
-        }
-
-        pclose(pipe);
-        return result;
-    }
-
-    std::string BlackCore::searchDirectory(std::string seachIn, std::string searchThis)
-    {
-        std::string str;
-        DIR *path;
-        dirent *entry;
+        std::vector<std::string> arguments;
+        arguments.push_back("/bin/sh");
+        arguments.push_back("-c");
+        arguments.push_back(command);
 
-        path = opendir(seachIn.c_str());
-        if( path != NULL  )
+        BlackProcessResult result = BlackProcess::run(arguments);
+        if( not result.isStarted )
         {
-            while( (entry = readdir(path)) != NULL)
-            {
-                if( entry->d_name[0] == '.')
-                {
-                    continue;
-                }
-
-                str = entry->d_name;
-                if(strstr(entry->d_name,searchThis.c_str()) != NULL )
-                {
-                    closedir(path);
-                    return str;
-                }
-            }
-        }
-        closedir(path);
-
-        return SEARCH_DIR_NOT_FOUND;
-    }
-
-    bool        BlackCore::findCapeMgrName()
-    {
-        std::string searchResult = this->searchDirectory("/sys/devices/","bone_capemgr.");
-
-        if(searchResult == SEARCH_DIR_NOT_FOUND)
-        {
-            this->capeMgrName = "bone_capemgr." + DEFAULT_CAPE_MGR_NUMBER;
-            this->coreErrors->capeMgrError = true;
-            return false;
-        }
-        else
-        {
-            this->capeMgrName = searchResult;
-            this->coreErrors->capeMgrError = false;
-            return true;
+            return "ERROR";
         }
-    }
 
-    bool        BlackCore::findOcpName()
-    {
-        std::string searchResult = this->searchDirectory("/sys/devices/","ocp.");
-
-        if(searchResult == SEARCH_DIR_NOT_FOUND)
-        {
-            this->ocpName = "ocp." + DEFAULT_OCP_NUMBER;
-            this->coreErrors->ocpError = true;
-            return false;
-        }
-        else
-        {
-            this->ocpName = searchResult;
-            this->coreErrors->ocpError = false;
-            return true;
-        }
+        return result.output;
     }
 
-
-
-
     std::string BlackCore::searchDirectoryOcp(BlackCore::ocpSearch searchThis)
     {
         std::string searchResult;
-        std::string searchPath = "/sys/devices/" + this->getOcpName() + "/";
+        std::string searchPath;
 
         if( searchThis == this->SPI0 )
         {
-            searchPath += DEFAULT_SPI0_PINMUX + ".spi/spi_master/";
+            searchPath = DEFAULT_SPI0_PINMUX + ".spi/spi_master/";
         }
         else if( searchThis == this->SPI1 )
         {
-            searchPath += DEFAULT_SPI1_PINMUX + ".spi/spi_master/";
+            searchPath = DEFAULT_SPI1_PINMUX + ".spi/spi_master/";
         }
 
 
@@ -163,61 +82,61 @@ namespace BlackLib
         {
             case ADC_helper:
             {
-                searchResult = this->searchDirectory(searchPath,"helper.");
+                searchResult = this->board.searchOcp(searchPath,"helper.");
                 break;
             }
 
             case PWM_P8_13:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P8_13.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P8_13.");
                 break;
             }
 
             case PWM_P8_19:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P8_19.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P8_19.");
                 break;
             }
 
             case PWM_P9_14:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P9_14.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P9_14.");
                 break;
             }
 
             case PWM_P9_16:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P9_16.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P9_16.");
                 break;
             }
 
             case PWM_P9_21:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P9_21.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P9_21.");
                 break;
             }
 
             case PWM_P9_22:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P9_22.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P9_22.");
                 break;
             }
 
             case PWM_P9_42:
             {
-                searchResult = this->searchDirectory(searchPath,"pwm_test_P9_42.");
+                searchResult = this->board.searchOcp(searchPath,"pwm_test_P9_42.");
                 break;
             }
 
             case SPI0:
             {
-                searchResult = this->searchDirectory(searchPath,"spi");
+                searchResult = this->board.searchOcp(searchPath,"spi");
                 break;
             }
 
             case SPI1:
             {
-                searchResult = this->searchDirectory(searchPath,"spi");
+                searchResult = this->board.searchOcp(searchPath,"spi");
                 break;
             }
         }
@@ -228,24 +147,29 @@ namespace BlackLib
 
     errorCore   *BlackCore::getErrorsFromCore()
     {
-        return (this->coreErrors);
+        return this->board.getErrors();
     }
 
 
 
     std::string BlackCore::getCapeMgrName()
     {
-        return this->capeMgrName;
+        return this->board.getCapeMgrName();
     }
 
     std::string BlackCore::getOcpName()
     {
-        return this->ocpName;
+        return this->board.getOcpName();
     }
 
     std::string BlackCore::getSlotsFilePath()
     {
-        return this->slotsFilePath;
+        return this->board.getSlotsFilePath();
+    }
+
+    bool        BlackCore::loadOverlay(const std::string &overlayName)
+    {
+        return this->board.loadOverlay(overlayName);
     }
 
     // ############################################ BLACKCORE DEFINITION ENDS ############################################ //
@@ -34,13 +34,17 @@
 
 #include "BlackErr.h"       // Black Errors header file
 #include "BlackDef.h"       // Black Definitions header file
+#include "BlackProcess/BlackProcess.h"
+#include "BlackTrace/BlackTrace.h"
+#include "BlackMetrics/BlackMetrics.h"
+#include "BlackBoard/BlackBoard.h"
 
 
 #include <cstring>
+#include <cstdint>
 #include <string>
 #include <sstream>          // need for tostr() function
-#include <cstdio>           // need for popen() function in BlackCore::executeShellCmd()
-#include <dirent.h>         // need for dirent struct in BlackCore::searchDirectory()
+#include <cstdio>
 
 
 
@@ -65,6 +69,96 @@ namespace BlackLib
         return os.str();
     }
 
+    /*! @brief Writes decimal representation of an integer to a character buffer.
+    *
+    * This function doesn't allocate memory and doesn't use stream library. It doesn't add
+    * terminating null character. Buffer must have at least 20 bytes space.
+    *
+    * @param [in] value         integer which will convert.
+    * @param [out] buffer       destination buffer.
+    * @return Written character count.
+    */
+    inline size_t intToChars(int64_t value, char *buffer)
+    {
+        char reversed[20];
+        size_t length = 0;
+        uint64_t magnitude = (value < 0) ? (0 - static_cast<uint64_t>(value)) : static_cast<uint64_t>(value);
+
+        do
+        {
+            reversed[length++] = static_cast<char>('0' + (magnitude % 10));
+            magnitude /= 10;
+        }
+        while( magnitude != 0 );
+
+        size_t written = 0;
+        if( value < 0 )
+        {
+            buffer[written++] = '-';
+        }
+
+        while( length > 0 )
+        {
+            buffer[written++] = reversed[--length];
+        }
+
+        return written;
+    }
+
+    /*! @brief Converts an integer to string without stream library.
+    *
+    * This function uses intToChars() with a stack buffer, so only the returned string allocates memory.
+    *
+    * @param [in] value         integer which will convert.
+    * @return Decimal representation of the integer.
+    */
+    inline std::string intToString(int64_t value)
+    {
+        char buffer[24];
+        return std::string(buffer, intToChars(value, buffer));
+    }
+
+    /*! @brief Parses decimal representation of an integer from a character buffer.
+    *
+    * This function is the reverse of intToChars(). It doesn't allocate memory and doesn't use stream
+    * library. Leading white spaces and an optional minus sign are accepted, parsing stops at the first
+    * non-digit character, so trailing new line of sysfs files doesn't matter.
+    *
+    * @param [in] buffer        source buffer, it doesn't have to be null terminated.
+    * @param [in] size          used size of the buffer.
+    * @param [out] value        parsed integer.
+    * @return True if at least one digit is parsed, else false.
+    */
+    inline bool charsToInt(const char *buffer, size_t size, int64_t &value)
+    {
+        size_t index = 0;
+
+        while( index < size and (buffer[index] == ' ' or buffer[index] == '\t' or buffer[index] == '\n') )
+        {
+            index++;
+        }
+
+        bool negative = (index < size and buffer[index] == '-');
+        if( negative )
+        {
+            index++;
+        }
+
+        if( index >= size or buffer[index] < '0' or buffer[index] > '9' )
+        {
+            return false;
+        }
+
+        int64_t parsed = 0;
+        for( ; index < size and buffer[index] >= '0' and buffer[index] <= '9' ; index++ )
+        {
+            parsed = parsed * 10 + (buffer[index] - '0');
+        }
+
+        value = negative ? -parsed : parsed;
+        return true;
+    }
+
 
 
 
@@ -80,46 +174,19 @@ namespace BlackLib
     class BlackCore
     {
         private:
-            errorCore       *coreErrors;            /*!< @brief is used to hold the errors of BlackCore class */
-            std::string     capeMgrName;            /*!< @brief is used to hold the capemgr name */
-            std::string     ocpName;                /*!< @brief is used to hold the ocp name */
-            std::string     slotsFilePath;          /*!< @brief is used to hold the slots file path */
-
-            /*! @brief Finds full name of capemgr directory.
-            *
-            *  This function searches @b "/sys/devices/" directory,
-            *  to find directory which starts with @b "bone_capemgr."
-            *  @return True if successful, else false.
-            *  @sa BlackCore::searchDirectory()
-            */
-            bool            findCapeMgrName();
-
-            /*! @brief Finds full name of ocp directory.
-            *
-            *  This function searches @b "/sys/devices/" directory,
-            *  to find directory which starts with @b "ocp."
-            *  @return True if successful, else false.
-            *  @sa BlackCore::searchDirectory()
-            */
-            bool            findOcpName();
+            BlackBoard      &board;                 /*!< @brief is used to hold the shared board context */
 
             /*! @brief Executes system call.
             *
-            *  This function executes system commands with using popen() function.
+            *  This function runs the command with @b "/bin/sh -c" through BlackProcess, so shell features
+            *  like pipes and redirections work like before, but the process isn't forked.
             *  This example executes "ls" command with argument "la" and saves
             *  output to returnValue variable. @n @n
             *  <b> string returnValue = executeCommand("ls -la"); </b>
+            *  @return Output of the program, "ERROR" if it couldn't be started.
             */
             std::string     executeCommand(std::string command);
 
-            /*! @brief Searches specified directory to find specified file/directory.
-            *
-            *  @param[in] searchIn searching directory
-            *  @param[in] searchThis search file/directory
-            *  @return Full name of searching file/directory.
-            */
-            std::string     searchDirectory(std::string searchIn, std::string searchThis);
-
             /*! @brief First declaration of this function.
             */
             virtual bool    loadDeviceTree() = 0;
@@ -151,7 +218,7 @@ namespace BlackLib
             */
             std::string     searchDirectoryOcp(BlackCore::ocpSearch searchThis);
 
-            /*! @brief Exports errorCore struct to derived class.
+            /*! @brief Exports errorCore struct of the board context to derived class.
             *
             *  @return errorCore struct pointer.
             */
@@ -159,36 +226,42 @@ namespace BlackLib
 
             /*! @brief Exports capemgr name to derived class.
             *
-            *  @return BlackCore::capeMgrName variable.
+            *  @return BlackBoard::capeMgrName variable.
             */
             std::string     getCapeMgrName();
 
             /*! @brief Exports ocp name to derived class.
             *
-            *  @return BlackCore::ocpName variable.
+            *  @return BlackBoard::ocpName variable.
             */
             std::string     getOcpName();
 
             /*! @brief Exports slots file path to derived class.
             *
-            *  @return BlackCore::slotsFilePath variable.
+            *  @return BlackBoard::slotsFilePath variable.
             */
             std::string     getSlotsFilePath();
 
+            /*! @brief Loads device tree overlay by using the shared board context.
+            *
+            *  @param[in] overlayName name of device tree overlay
+            *  @return False if the slots file can't be opened, else true.
+            *  @sa BlackBoard::loadOverlay()
+            */
+            bool            loadOverlay(const std::string &overlayName);
+
 
 
         public:
             /*! @brief Constructor of BlackCore class.
             *
-            * This function initializes errorCore struct and runs these functions:
-            * @li findCapeMgrName()
-            * @li findOcpName()
+            * This function borrows the process wide board context. The capemgr and ocp
+            * directories are searched only once, when the first object is constructed.
+            * @sa BlackBoard::getDefault()
             */
             BlackCore();
 
             /*! @brief Destructor of BlackCore class.
-            *
-            * This function deletes errorCore struct pointer.
             */
             virtual ~BlackCore();
 
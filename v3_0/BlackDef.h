@@ -34,6 +34,7 @@
 
 
 #include <string>
+#include <cstdint>
 
 namespace BlackLib
 {
@@ -66,6 +67,63 @@ namespace BlackLib
                             };
 
 
+    /*! @brief Holds compile time conversion ratio of time types to nanosecond.
+    *
+    * Nanosecond equivalent of a value is (value / divisor) * multiplier.
+    * @tparam T time type (enum)
+    */
+    template <timeType T> struct timeTypeRatio;
+
+    template <> struct timeTypeRatio<picosecond>    { static const uint64_t multiplier = 1;            static const uint64_t divisor = 1000;  };
+    template <> struct timeTypeRatio<nanosecond>    { static const uint64_t multiplier = 1;            static const uint64_t divisor = 1;     };
+    template <> struct timeTypeRatio<microsecond>   { static const uint64_t multiplier = 1000;         static const uint64_t divisor = 1;     };
+    template <> struct timeTypeRatio<milisecond>    { static const uint64_t multiplier = 1000000;      static const uint64_t divisor = 1;     };
+    template <> struct timeTypeRatio<second>        { static const uint64_t multiplier = 1000000000;   static const uint64_t divisor = 1;     };
+
+
+    /*! @brief Converts time value to nanoseconds at compile time specified unit.
+    *
+    * This function uses only integer operations. If result doesn't fit to uint64_t, it returns UINT64_MAX.
+    * @tparam T time type of value (enum)
+    * @param [in] value time value
+    * @return Nanosecond equivalent of value.
+    */
+    template <timeType T>
+    inline uint64_t toNanoseconds(uint64_t value)
+    {
+        value /= timeTypeRatio<T>::divisor;
+
+        if( value > UINT64_MAX / timeTypeRatio<T>::multiplier )
+        {
+            return UINT64_MAX;
+        }
+
+        return value * timeTypeRatio<T>::multiplier;
+    }
+
+
+    /*! @brief Converts time value to nanoseconds at run time specified unit.
+    *
+    * This function dispatches to the compile time specialized versions.
+    * @param [in] value time value
+    * @param [in] tType time type of value (enum)
+    * @return Nanosecond equivalent of value. If result doesn't fit to uint64_t, it returns UINT64_MAX.
+    */
+    inline uint64_t toNanoseconds(uint64_t value, timeType tType)
+    {
+        switch( tType )
+        {
+            case picosecond:    { return toNanoseconds<picosecond>(value);  }
+            case nanosecond:    { return toNanoseconds<nanosecond>(value);  }
+            case microsecond:   { return toNanoseconds<microsecond>(value); }
+            case milisecond:    { return toNanoseconds<milisecond>(value);  }
+            case second:        { return toNanoseconds<second>(value);      }
+        }
+
+        return UINT64_MAX;
+    }
+
+
     /*!
      * This enum is used for selecting file open mode.
      */
@@ -138,47 +138,93 @@ namespace BlackLib
 
 
 
-    std::vector<std::string> BlackDirectory::getEntryList(std::string directoryPath, BlackDirectory::hiddenFormat hf, BlackDirectory::componentFormat cf, bool sortAlphabetically)
+    int BlackDirectory::getEntryType(int directoryFd, const dirent *entry)
     {
-        std::vector<std::string> directoryList;
-        directoryList.clear();
+        unsigned char type = entry->d_type;
 
-        if ( BlackDirectory::exists(directoryPath) )
+        if( type == DT_UNKNOWN )
         {
-            DIR     *dp;
-            dirent  *dirp;
-
-            if( (dp = opendir(directoryPath.c_str())) != NULL)
+            struct stat sb;
+            if( fstatat(directoryFd, entry->d_name, &sb, AT_SYMLINK_NOFOLLOW) != 0 )
             {
-                while( (dirp = readdir(dp)) != NULL )
-                {
-                    std::string fname(dirp->d_name);
+                return 0;
+            }
+
+            if( S_ISDIR(sb.st_mode) )       { type = DT_DIR; }
+            else if( S_ISREG(sb.st_mode) )  { type = DT_REG; }
+            else if( S_ISLNK(sb.st_mode) )  { type = DT_LNK; }
+        }
+
+        switch( type )
+        {
+            case DT_DIR: { return BlackDirectory::Directory;    }
+            case DT_REG: { return BlackDirectory::File;         }
+            case DT_LNK: { return BlackDirectory::SymbolicLink; }
+            default:     { return 0;                            }
+        }
+    }
 
-                    if( fname == "." ) continue;
-                    if( fname == ".." ) continue;
-                    if( hf == BlackDirectory::ExcludeHiddens and fname[0] == '.' ) continue;
+    unsigned int BlackDirectory::forEachEntry(const std::string &directoryPath, const BlackDirectory::entryCallback &callback, BlackDirectory::hiddenFormat hf, BlackDirectory::componentFormat cf)
+    {
+        DIR *dp = opendir(directoryPath.c_str());
+        if( dp == NULL )
+        {
+            return 0;
+        }
 
+        int          directoryFd = dirfd(dp);
+        unsigned int count       = 0;
+        dirent       *dirp;
 
-                    struct stat sb;
-                    if( stat(&fname[0],&sb) == 0 )
-                    {
-                        if( (cf & BlackDirectory::Directory)    == BlackDirectory::Directory    and S_ISDIR(sb.st_mode)) { directoryList.push_back(fname); }
-                        if( (cf & BlackDirectory::File)         == BlackDirectory::File         and S_ISREG(sb.st_mode)) { directoryList.push_back(fname); }
-                        if( (cf & BlackDirectory::SymbolicLink) == BlackDirectory::SymbolicLink and S_ISLNK(sb.st_mode)) { directoryList.push_back(fname); }
-                    }
+        while( (dirp = readdir(dp)) != NULL )
+        {
+            const char *fname = dirp->d_name;
 
-                }
-                closedir(dp);
+            if( fname[0] == '.' )
+            {
+                if( fname[1] == '\0' or (fname[1] == '.' and fname[2] == '\0') ) continue;
+                if( hf == BlackDirectory::ExcludeHiddens ) continue;
             }
+
+            int type = BlackDirectory::getEntryType(directoryFd, dirp);
+            if( (type & cf) == 0 ) continue;
+
+            count++;
+            if( not callback(fname, static_cast<BlackDirectory::componentFormat>(type)) ) break;
         }
 
-        if ( sortAlphabetically ) { std::sort(directoryList.begin(), directoryList.end()); }
+        closedir(dp);
+        return count;
+    }
+
+    unsigned int BlackDirectory::getEntryList(const std::string &directoryPath, std::vector<std::string> &output, BlackDirectory::hiddenFormat hf, BlackDirectory::componentFormat cf, bool sortAlphabetically)
+    {
+        size_t firstIndex = output.size();
+
+        unsigned int count = BlackDirectory::forEachEntry(directoryPath,
+                                                          [&output](const char *name, BlackDirectory::componentFormat)
+                                                          {
+                                                              output.push_back(name);
+                                                              return true;
+                                                          },
+                                                          hf, cf);
+
+        if ( sortAlphabetically ) { std::sort(output.begin() + firstIndex, output.end()); }
+        return count;
+    }
+
+    std::vector<std::string> BlackDirectory::getEntryList(std::string directoryPath, BlackDirectory::hiddenFormat hf, BlackDirectory::componentFormat cf, bool sortAlphabetically)
+    {
+        std::vector<std::string> directoryList;
+        directoryList.reserve(64);
+
+        BlackDirectory::getEntryList(directoryPath, directoryList, hf, cf, sortAlphabetically);
         return directoryList;
     }
 
     unsigned int BlackDirectory::getEntryCount(std::string directoryPath, BlackDirectory::hiddenFormat hf, BlackDirectory::componentFormat cf)
     {
-        return BlackDirectory::getEntryList(directoryPath,hf,cf,false).size();
+        return BlackDirectory::forEachEntry(directoryPath, [](const char *, BlackDirectory::componentFormat) { return true; }, hf, cf);
     }
 
 
@@ -189,7 +235,7 @@ namespace BlackLib
 
     unsigned int BlackDirectory::getEntryCount(BlackDirectory::hiddenFormat hf, BlackDirectory::componentFormat cf)
     {
-        return BlackDirectory::getEntryList(BlackDirectory::getCurrentDirectoryPath(),hf,cf,false).size();
+        return BlackDirectory::getEntryCount(BlackDirectory::getCurrentDirectoryPath(),hf,cf);
     }
 
 
@@ -228,60 +274,331 @@ namespace BlackLib
         return true;
     }
 
-    bool        BlackDirectory::removeDirectory(std::string directoryPath, bool rmRecursively)
+    bool        BlackDirectory::removeDirectory(std::string directoryPath, bool rmRecursively, BlackThreadPool *pool)
     {
         struct stat sb;
 
-        if( stat(&directoryPath[0],&sb) == 0 )
+        if( lstat(directoryPath.c_str(),&sb) == 0 )
         {
             if( !rmRecursively ){ return (rmdir(directoryPath.c_str()) == 0); }
 
-
             if( S_ISDIR(sb.st_mode) )
             {
-                std::vector<std::string> directoryList;
-                directoryList.clear();
-                DIR     *dp;
-                dirent  *dirp;
+                walkFilter  everything;
+                walkContext context;
+                BlackDirectory::initContext(context, everything, NULL, pool);
 
-                if( (dp = opendir(directoryPath.c_str())) != NULL)
-                {
-                    while( (dirp = readdir(dp)) != NULL )
-                    {
-                        std::string fname(dirp->d_name);
-
-                        if( fname == "." ) continue;
-                        if( fname == ".." ) continue;
-                        directoryList.push_back(fname);
-                    }
-                    closedir(dp);
-                }
+                return BlackDirectory::removeTree(context, AT_FDCWD, directoryPath);
+            }
+            else
+            {
+                return (unlink(directoryPath.c_str()) == 0);
+            }
+        }
 
-                if( directoryList.empty() )
-                {
-                    return (std::remove(directoryPath.c_str()) == 0);
-                }
+        return true;
+    }
+
+    bool        BlackDirectory::renameDirectory(std::string oldDirectoryPath, std::string newDirectoryPath )
+    {
+        return (rename(oldDirectoryPath.c_str(),newDirectoryPath.c_str()) == 0);
+    }
+
+
+
+    unsigned int BlackDirectory::walk(const std::string &rootPath, const BlackDirectory::walkCallback &callback, const BlackDirectory::walkFilter &filter, BlackThreadPool *pool)
+    {
+        int rootFd = open(rootPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if( rootFd < 0 )
+        {
+            return 0;
+        }
+
+        walkContext context;
+        BlackDirectory::initContext(context, filter, &callback, pool);
+        BlackDirectory::walkDirectory(context, rootFd, rootPath, 1);
+
+        return context.matchCount;
+    }
+
+    std::vector<std::string> BlackDirectory::find(const std::string &rootPath, const BlackDirectory::walkFilter &filter, BlackThreadPool *pool, bool sortAlphabetically)
+    {
+        std::vector<std::string> pathList;
+        BlackMutex               listMutex;
+
+        BlackDirectory::walk(rootPath,
+                             [&](const std::string &path, BlackDirectory::componentFormat)
+                             {
+                                 BlackLockGuard<BlackMutex> guard(listMutex);
+                                 pathList.push_back(path);
+                                 return true;
+                             },
+                             filter, pool);
+
+        if ( sortAlphabetically ) { std::sort(pathList.begin(), pathList.end()); }
+        return pathList;
+    }
+
+    unsigned int BlackDirectory::removeEntries(const std::string &rootPath, const BlackDirectory::walkFilter &filter, BlackThreadPool *pool)
+    {
+        int rootFd = open(rootPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if( rootFd < 0 )
+        {
+            return 0;
+        }
+
+        walkContext context;
+        BlackDirectory::initContext(context, filter, NULL, pool);
+        BlackDirectory::removeMatched(context, rootFd, 1);
+
+        return context.matchCount;
+    }
+
+    void BlackDirectory::initContext(walkContext &context, const walkFilter &filter, const walkCallback *callback, BlackThreadPool *pool)
+    {
+        context.filter          = &filter;
+        context.callback        = callback;
+        context.pool            = pool;
+        context.maxInFlight     = (pool != NULL) ? static_cast<int>(pool->getWorkerCount() * 2) : 0;
+        context.inFlight        = 0;
+        context.isStopped       = 0;
+        context.matchCount      = 0;
+        context.failureCount    = 0;
+    }
+
+    bool BlackDirectory::isMatched(const walkFilter &filter, int directoryFd, const dirent *entry)
+    {
+        if( not filter.namePattern.empty() and fnmatch(filter.namePattern.c_str(), entry->d_name, 0) != 0 )
+        {
+            return false;
+        }
+
+        if( filter.modifiedBefore != 0 or filter.modifiedAfter != 0 )
+        {
+            struct stat sb;
+            if( fstatat(directoryFd, entry->d_name, &sb, AT_SYMLINK_NOFOLLOW) != 0 )
+            {
+                return false;
+            }
+
+            if( filter.modifiedBefore != 0 and sb.st_mtime >= filter.modifiedBefore ) { return false; }
+            if( filter.modifiedAfter  != 0 and sb.st_mtime <  filter.modifiedAfter  ) { return false; }
+        }
+
+        return true;
+    }
+
+    void BlackDirectory::runBranch(walkContext &context, const std::function<void()> &branch, std::vector< BlackFuture<void> > &pending)
+    {
+        if( context.pool != NULL and __sync_add_and_fetch(&(context.inFlight), 1) <= context.maxInFlight )
+        {
+            walkContext *sharedContext = &context;
+            BlackFuture<void> future   = context.pool->submit( [sharedContext, branch]()
+                                                               {
+                                                                   branch();
+                                                                   __sync_sub_and_fetch(&(sharedContext->inFlight), 1);
+                                                               } );
+            if( future.isValid() )
+            {
+                pending.push_back(future);
+                return;
+            }
+        }
+
+        if( context.pool != NULL )
+        {
+            __sync_sub_and_fetch(&(context.inFlight), 1);
+        }
+
+        branch();
+    }
+
+    void BlackDirectory::waitBranches(walkContext &context, std::vector< BlackFuture<void> > &pending)
+    {
+        for( size_t i = 0 ; i < pending.size() ; i++ )
+        {
+            context.pool->waitFor(pending[i]);
+        }
+        pending.clear();
+    }
 
-                for( unsigned int i = 0 ; i<directoryList.size() ; i++ )
+    void BlackDirectory::walkDirectory(walkContext &context, int directoryFd, const std::string &path, unsigned int depth)
+    {
+        DIR *dp = fdopendir(directoryFd);
+        if( dp == NULL )
+        {
+            close(directoryFd);
+            return;
+        }
+
+        const walkFilter                &filter     = *(context.filter);
+        bool                            hasSlash    = ( not path.empty() and path[path.size()-1] == '/' );
+        std::vector< BlackFuture<void> > pending;
+        dirent                          *dirp;
+
+        while( not context.isStopped and (dirp = readdir(dp)) != NULL )
+        {
+            const char *fname = dirp->d_name;
+
+            if( fname[0] == '.' )
+            {
+                if( fname[1] == '\0' or (fname[1] == '.' and fname[2] == '\0') ) continue;
+                if( filter.hidden == BlackDirectory::ExcludeHiddens ) continue;
+            }
+
+            int  type           = BlackDirectory::getEntryType(directoryFd, dirp);
+            bool isMatch        = ( (type & filter.components) != 0 and BlackDirectory::isMatched(filter, directoryFd, dirp) );
+            bool isDescended    = ( type == BlackDirectory::Directory and depth < filter.maxDepth );
+
+            if( not isMatch and not isDescended ) continue;
+
+            std::string childPath = hasSlash ? path + fname : path + "/" + fname;
+
+            if( isMatch )
+            {
+                __sync_add_and_fetch(&(context.matchCount), 1);
+
+                if( not (*context.callback)(childPath, static_cast<BlackDirectory::componentFormat>(type)) )
                 {
-                    std::string fullPath = directoryPath + ((directoryPath[directoryPath.size()-1] == '/') ? directoryList[i] : "/" + directoryList[i]);
-                    BlackDirectory::removeDirectory(fullPath,true);
+                    context.isStopped = 1;
+                    break;
                 }
+            }
+
+            if( isDescended )
+            {
+                int childFd = openat(directoryFd, fname, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if( childFd < 0 ) continue;
+
+                walkContext *sharedContext = &context;
+                BlackDirectory::runBranch(context,
+                                          [sharedContext, childFd, childPath, depth]()
+                                          {
+                                              BlackDirectory::walkDirectory(*sharedContext, childFd, childPath, depth + 1);
+                                          },
+                                          pending);
+            }
+        }
+
+        BlackDirectory::waitBranches(context, pending);
+        closedir(dp);
+    }
+
+    void BlackDirectory::removeMatched(walkContext &context, int directoryFd, unsigned int depth)
+    {
+        DIR *dp = fdopendir(directoryFd);
+        if( dp == NULL )
+        {
+            close(directoryFd);
+            return;
+        }
+
+        const walkFilter                &filter     = *(context.filter);
+        std::vector< BlackFuture<void> > pending;
+        dirent                          *dirp;
+
+        while( (dirp = readdir(dp)) != NULL )
+        {
+            const char *fname = dirp->d_name;
+
+            if( fname[0] == '.' )
+            {
+                if( fname[1] == '\0' or (fname[1] == '.' and fname[2] == '\0') ) continue;
+                if( filter.hidden == BlackDirectory::ExcludeHiddens ) continue;
+            }
+
+            int  type           = BlackDirectory::getEntryType(directoryFd, dirp);
+            bool isMatch        = ( (type & filter.components) != 0 and BlackDirectory::isMatched(filter, directoryFd, dirp) );
+            walkContext *sharedContext = &context;
 
-                return (std::remove(directoryPath.c_str()) == 0);
+            if( isMatch and type == BlackDirectory::Directory )
+            {
+                std::string childName(fname);
+                BlackDirectory::runBranch(context,
+                                          [sharedContext, directoryFd, childName]()
+                                          {
+                                              if( BlackDirectory::removeTree(*sharedContext, directoryFd, childName) )
+                                              {
+                                                  __sync_add_and_fetch(&(sharedContext->matchCount), 1);
+                                              }
+                                          },
+                                          pending);
+            }
+            else
+            if( isMatch )
+            {
+                if( unlinkat(directoryFd, fname, 0) == 0 )  { __sync_add_and_fetch(&(context.matchCount), 1); }
+                else                                        { __sync_add_and_fetch(&(context.failureCount), 1); }
             }
             else
+            if( type == BlackDirectory::Directory and depth < filter.maxDepth )
             {
-                return (std::remove(directoryPath.c_str()) == 0);
+                int childFd = openat(directoryFd, fname, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if( childFd < 0 ) continue;
+
+                BlackDirectory::runBranch(context,
+                                          [sharedContext, childFd, depth]()
+                                          {
+                                              BlackDirectory::removeMatched(*sharedContext, childFd, depth + 1);
+                                          },
+                                          pending);
             }
         }
 
-        return true;
+        BlackDirectory::waitBranches(context, pending);
+        closedir(dp);
     }
 
-    bool        BlackDirectory::renameDirectory(std::string oldDirectoryPath, std::string newDirectoryPath )
+    bool BlackDirectory::removeTree(walkContext &context, int parentFd, const std::string &name)
     {
-        return (rename(oldDirectoryPath.c_str(),newDirectoryPath.c_str()) == 0);
+        int directoryFd = openat(parentFd, name.c_str(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        DIR *dp         = (directoryFd < 0) ? NULL : fdopendir(directoryFd);
+
+        if( dp == NULL )
+        {
+            if( directoryFd >= 0 ) { close(directoryFd); }
+            __sync_add_and_fetch(&(context.failureCount), 1);
+            return false;
+        }
+
+        std::vector< BlackFuture<void> > pending;
+        dirent                          *dirp;
+
+        while( (dirp = readdir(dp)) != NULL )
+        {
+            const char *fname = dirp->d_name;
+
+            if( fname[0] == '.' and ( fname[1] == '\0' or (fname[1] == '.' and fname[2] == '\0') ) ) continue;
+
+            if( BlackDirectory::getEntryType(directoryFd, dirp) == BlackDirectory::Directory )
+            {
+                walkContext *sharedContext = &context;
+                std::string childName(fname);
+
+                BlackDirectory::runBranch(context,
+                                          [sharedContext, directoryFd, childName]()
+                                          {
+                                              BlackDirectory::removeTree(*sharedContext, directoryFd, childName);
+                                          },
+                                          pending);
+            }
+            else
+            if( unlinkat(directoryFd, fname, 0) != 0 )
+            {
+                __sync_add_and_fetch(&(context.failureCount), 1);
+            }
+        }
+
+        BlackDirectory::waitBranches(context, pending);
+        closedir(dp);
+
+        if( unlinkat(parentFd, name.c_str(), AT_REMOVEDIR) != 0 )
+        {
+            __sync_add_and_fetch(&(context.failureCount), 1);
+            return false;
+        }
+
+        return true;
     }
 
 
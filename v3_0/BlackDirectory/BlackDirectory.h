@@ -32,6 +32,8 @@
 #ifndef BLACKDIRECTORY_H_
 #define BLACKDIRECTORY_H_
 
+#include "../BlackThreadPool/BlackThreadPool.h"
+
 #include <string>
 #include <unistd.h>
 #include <pwd.h>
@@ -41,6 +43,10 @@
 #include <vector>
 #include <cstdio>
 #include <algorithm>
+#include <functional>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <climits>
 
 
 
@@ -155,6 +161,12 @@ namespace BlackLib
         private:
             std::string  applicationDirectory;                  /*!< @brief is used to hold the application directory */
 
+            /*! @brief Finds the component type of a directory entry.
+            *
+            * @return Component type, 0 if the entry isn't a directory, regular file or symbolic link.
+            */
+            static int          getEntryType(int directoryFd, const dirent *entry);
+
 
         public:
 
@@ -178,6 +190,45 @@ namespace BlackLib
                 All          = Directory|File|SymbolicLink      /*!< enumeration for showing @a all type components at the output */
             };
 
+            /*! @brief Function type which is called for every entry by forEachEntry().
+            *
+            * It takes the entry name (valid only in the call) and the entry type. Returning false stops the scan.
+            */
+            typedef std::function<bool(const char *name, BlackDirectory::componentFormat type)> entryCallback;
+
+            /*! @brief Function type which is called for every matched entry by walk().
+            *
+            * It takes the entry path (root path joined with the relative path) and the entry type.
+            * Returning false stops the walk.
+            */
+            typedef std::function<bool(const std::string &path, BlackDirectory::componentFormat type)> walkCallback;
+
+            /*! @brief Holds the selection rules of walk(), find() and removeEntries() functions.
+            *
+            * Default values select every entry at every depth.
+            */
+            struct walkFilter
+            {
+                /*! @brief Default constructor of walkFilter struct.
+                */
+                walkFilter()
+                {
+                    components      = BlackDirectory::All;
+                    hidden          = BlackDirectory::IncludeHiddens;
+                    namePattern     = "";
+                    modifiedBefore  = 0;
+                    modifiedAfter   = 0;
+                    maxDepth        = UINT_MAX;
+                }
+
+                unsigned int                    components;         /*!< @brief is used to hold the selected types, combination of componentFormat */
+                BlackDirectory::hiddenFormat    hidden;             /*!< @brief is used to hold the hidden entries rule, excluded hiddens aren't descended too */
+                std::string                     namePattern;        /*!< @brief is used to hold the glob pattern of entry name, empty matches all */
+                time_t                          modifiedBefore;     /*!< @brief is used to hold the latest modification time, 0 means no limit */
+                time_t                          modifiedAfter;      /*!< @brief is used to hold the earliest modification time, 0 means no limit */
+                unsigned int                    maxDepth;           /*!< @brief is used to hold the deepest level, 1 means only direct entries of root */
+            };
+
 
             /*! @brief Constructor of BlackDirectory class.
             *
@@ -390,8 +441,13 @@ namespace BlackLib
             *  sub-directories as possible.
             *
             *
+            *  Recursive removal works on directory descriptors with openat() and unlinkat(), so paths aren't
+            *  built and entries aren't stat'ed. If a thread pool is given, subdirectories are removed on it in
+            *  parallel, but the count of queued subdirectories is limited to twice of the worker count.
+            *
             *  @param [in] directoryPath    destination directory path
             *  @param [in] rmRecursively    remove recursively
+            *  @param [in] pool             optional thread pool for recursive removal
             *
             *  @return False if directory couldn't remove else true.
             *
@@ -408,7 +464,7 @@ namespace BlackLib
             *   // Removed?: True
             * @endcode
             */
-            static bool         removeDirectory(std::string directoryPath, bool rmRecursively = false);
+            static bool         removeDirectory(std::string directoryPath, bool rmRecursively = false, BlackThreadPool *pool = NULL);
 
             /*! @brief Renames directory.
             *
@@ -557,6 +613,151 @@ namespace BlackLib
                                                          bool sortAlphabetically = true);
 
 
+            /*! @brief Appends the directories, files and sybollic links list in directory to a vector.
+            *
+            * This function works like the other getEntryList() function, but it appends to @a output.
+            * So the caller can reserve the vector and reuse its capacity on every scan.
+            *
+            *  @param [in] directoryPath        destination path
+            *  @param [out] output              vector which the names are appended to
+            *  @param [in] hf                   hidden files shown format
+            *  @param [in] cf                   selection file formats to show
+            *  @param [in] sortAlphabetically   sort alphabetically the appended names
+            *
+            *  @return Count of appended names.
+            *
+            *  @par Example
+            *  @code{.cpp}
+            *   std::vector<std::string> captures;
+            *   captures.reserve(20000);
+            *
+            *   BlackLib::BlackDirectory::getEntryList("/var/log/captures", captures,
+            *                                          BlackLib::BlackDirectory::ExcludeHiddens,
+            *                                          BlackLib::BlackDirectory::File,
+            *                                          false);
+            * @endcode
+            */
+            static unsigned int getEntryList(const std::string &directoryPath,
+                                             std::vector<std::string> &output,
+                                             BlackDirectory::hiddenFormat    hf = BlackDirectory::ExcludeHiddens,
+                                             BlackDirectory::componentFormat cf = BlackDirectory::All,
+                                             bool sortAlphabetically = true);
+
+            /*! @brief Calls a function for every matched component in directory.
+            *
+            * Names aren't copied and the list isn't built, so this is the cheapest way to scan a large
+            * directory. Types are taken from directory entries and fstatat() is called only when the
+            * file system doesn't report the type. Symbolic links aren't followed. Order of the entries
+            * is the order of file system. The callback can stop the scan with returning false.
+            *
+            *  @param [in] directoryPath        destination path
+            *  @param [in] callback             function which takes entry name and type
+            *  @param [in] hf                   hidden files shown format
+            *  @param [in] cf                   selection file formats to show
+            *
+            *  @return Count of entries which are passed to the callback.
+            *
+            *  @par Example
+            *  @code{.cpp}
+            *   unsigned long long int totalNameLength = 0;
+            *
+            *   BlackLib::BlackDirectory::forEachEntry("/var/log/captures",
+            *       [&](const char *name, BlackLib::BlackDirectory::componentFormat type)
+            *       {
+            *           totalNameLength += strlen(name);
+            *           return true;
+            *       },
+            *       BlackLib::BlackDirectory::ExcludeHiddens,
+            *       BlackLib::BlackDirectory::File);
+            * @endcode
+            */
+            static unsigned int forEachEntry(const std::string &directoryPath,
+                                             const BlackDirectory::entryCallback &callback,
+                                             BlackDirectory::hiddenFormat    hf = BlackDirectory::ExcludeHiddens,
+                                             BlackDirectory::componentFormat cf = BlackDirectory::All);
+
+            /*! @brief Walks a directory tree and calls a function for every matched entry.
+            *
+            * Tree is walked on directory descriptors, and path strings are built only for matched entries and
+            * directories. fstatat() is called only if the type is unknown or a modification time rule is set.
+            * Symbolic links aren't followed. Directories are descended even if they don't match the filter.
+            *
+            * If a thread pool is given, subdirectories are walked on it in parallel and the callback can be
+            * called from several threads at the same time. The count of queued subdirectories is limited to
+            * twice of the worker count, deeper levels are walked at the current thread.
+            *
+            *  @param [in] rootPath     root directory path
+            *  @param [in] callback     function which takes entry path and type
+            *  @param [in] filter       selection rules
+            *  @param [in] pool         optional thread pool for parallel walking
+            *
+            *  @return Count of matched entries.
+            *
+            *  @par Example
+            *  @code{.cpp}
+            *   BlackLib::BlackDirectory::walkFilter logs;
+            *   logs.components  = BlackLib::BlackDirectory::File;
+            *   logs.namePattern = "*.log";
+            *
+            *   BlackLib::BlackDirectory::walk("/var/log",
+            *       [](const std::string &path, BlackLib::BlackDirectory::componentFormat type)
+            *       {
+            *           std::cout << path << std::endl;
+            *           return true;
+            *       },
+            *       logs);
+            * @endcode
+            */
+            static unsigned int walk(const std::string &rootPath,
+                                     const BlackDirectory::walkCallback &callback,
+                                     const BlackDirectory::walkFilter &filter = BlackDirectory::walkFilter(),
+                                     BlackThreadPool *pool = NULL);
+
+            /*! @brief Exports the paths of matched entries in a directory tree.
+            *
+            *  @param [in] rootPath             root directory path
+            *  @param [in] filter               selection rules
+            *  @param [in] pool                 optional thread pool for parallel walking
+            *  @param [in] sortAlphabetically   sort alphabetically the output
+            *
+            *  @return The list of matched entry paths.
+            *
+            *  @sa BlackDirectory::walk()
+            */
+            static std::vector<std::string> find(const std::string &rootPath,
+                                                 const BlackDirectory::walkFilter &filter,
+                                                 BlackThreadPool *pool = NULL,
+                                                 bool sortAlphabetically = true);
+
+            /*! @brief Removes the matched entries in a directory tree.
+            *
+            * Matched files and links are unlinked, matched directories are removed with their contents.
+            * Unmatched directories are descended up to the filter's depth. Removal keeps going on errors.
+            *
+            *  @param [in] rootPath     root directory path, it isn't removed
+            *  @param [in] filter       selection rules
+            *  @param [in] pool         optional thread pool for parallel removal
+            *
+            *  @return Count of removed matched entries.
+            *
+            *  @par Example
+            *  @code{.cpp}
+            *   // rotates out the capture directories which are older than one week
+            *   BlackLib::BlackDirectory::walkFilter oldCaptures;
+            *   oldCaptures.components      = BlackLib::BlackDirectory::Directory;
+            *   oldCaptures.namePattern     = "capture_*";
+            *   oldCaptures.modifiedBefore  = time(NULL) - 7*24*60*60;
+            *   oldCaptures.maxDepth        = 1;
+            *
+            *   BlackLib::BlackThreadPool pool(2);
+            *   std::cout << BlackLib::BlackDirectory::removeEntries("/data", oldCaptures, &pool) << " removed" << std::endl;
+            * @endcode
+            */
+            static unsigned int removeEntries(const std::string &rootPath,
+                                              const BlackDirectory::walkFilter &filter,
+                                              BlackThreadPool *pool = NULL);
+
+
             /*! @brief Exports the directories, files and sybollic links count in directory.
             *
             * Users can hide or get hidden files with second paramter of function or select
@@ -708,6 +909,50 @@ namespace BlackLib
             * @endcode
             */
             std::string  getApplicationDirectoryName();
+
+
+        private:
+            /*! @brief Holds the shared state of a walk or a removal.
+            */
+            struct walkContext
+            {
+                const walkFilter               *filter;         /*!< @brief is used to hold the selection rules */
+                const walkCallback             *callback;       /*!< @brief is used to hold the walk callback, NULL at removal */
+                BlackThreadPool                *pool;           /*!< @brief is used to hold the optional thread pool */
+                int                             maxInFlight;    /*!< @brief is used to hold the limit of queued branches */
+                volatile int                    inFlight;       /*!< @brief is used to hold the count of queued branches */
+                volatile int                    isStopped;      /*!< @brief is used to hold the stop request of callback */
+                volatile unsigned int           matchCount;     /*!< @brief is used to hold the count of matched entries */
+                volatile unsigned int           failureCount;   /*!< @brief is used to hold the count of failed removals */
+            };
+
+            /*! @brief Prepares a walk context.
+            */
+            static void         initContext(walkContext &context, const walkFilter &filter, const walkCallback *callback, BlackThreadPool *pool);
+
+            /*! @brief Checks the name and time rules of filter for an entry.
+            */
+            static bool         isMatched(const walkFilter &filter, int directoryFd, const dirent *entry);
+
+            /*! @brief Runs a branch on the pool if the limit allows, else at the current thread.
+            */
+            static void         runBranch(walkContext &context, const std::function<void()> &branch, std::vector< BlackFuture<void> > &pending);
+
+            /*! @brief Waits the branches which are queued to the pool.
+            */
+            static void         waitBranches(walkContext &context, std::vector< BlackFuture<void> > &pending);
+
+            /*! @brief Walks an opened directory. The descriptor is closed by this function.
+            */
+            static void         walkDirectory(walkContext &context, int directoryFd, const std::string &path, unsigned int depth);
+
+            /*! @brief Removes the matched entries of an opened directory. The descriptor is closed by this function.
+            */
+            static void         removeMatched(walkContext &context, int directoryFd, unsigned int depth);
+
+            /*! @brief Removes a directory and its contents, relative to a parent directory descriptor.
+            */
+            static bool         removeTree(walkContext &context, int parentFd, const std::string &name);
     };
 
 
@@ -0,0 +1,341 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackDirectoryWatcher.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ######################################## BLACKDIRECTORYWATCHER DEFINITION STARTS ######################################## //
+    BlackDirectoryWatcher::dispatcher::dispatcher(BlackDirectoryWatcher *ownerWatcher)
+    {
+        this->watcher = ownerWatcher;
+    }
+
+    void BlackDirectoryWatcher::dispatcher::onStartHandler()
+    {
+        while( this->checkPoint() )
+        {
+            this->watcher->dispatch(100);
+        }
+    }
+
+
+
+    BlackDirectoryWatcher::BlackDirectoryWatcher(unsigned int coalesceWindowMs)
+    {
+        this->inotifyFd         = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        this->coalesceMs        = coalesceWindowMs;
+        this->dispatchThread    = NULL;
+
+        // enough for a few hundred records in one read
+        this->readBuffer.resize(16 * 1024);
+        this->pending.reserve(64);
+    }
+
+    BlackDirectoryWatcher::~BlackDirectoryWatcher()
+    {
+        this->stop();
+
+        if( this->inotifyFd >= 0 )
+        {
+            ::close(this->inotifyFd);
+        }
+    }
+
+    int BlackDirectoryWatcher::addWatch(const std::string &path, unsigned int eventMask)
+    {
+        if( this->inotifyFd < 0 )
+        {
+            return -1;
+        }
+
+        BlackLockGuard<BlackMutex> guard(this->watchMutex);
+
+        int watchId = inotify_add_watch(this->inotifyFd, path.c_str(), BlackDirectoryWatcher::toNativeMask(eventMask));
+        if( watchId >= 0 )
+        {
+            this->watches[watchId] = path;
+        }
+
+        return watchId;
+    }
+
+    bool BlackDirectoryWatcher::removeWatch(int watchId)
+    {
+        BlackLockGuard<BlackMutex> guard(this->watchMutex);
+
+        std::map<int, std::string>::iterator it = this->watches.find(watchId);
+        if( it == this->watches.end() )
+        {
+            return false;
+        }
+
+        // kernel's IN_IGNORED record of this id is dropped because the id isn't in the list anymore
+        this->watches.erase(it);
+        return ( inotify_rm_watch(this->inotifyFd, watchId) == 0 );
+    }
+
+    bool BlackDirectoryWatcher::removeWatch(const std::string &path)
+    {
+        int watchId = -1;
+
+        this->watchMutex.lock();
+        for( std::map<int, std::string>::iterator it = this->watches.begin() ; it != this->watches.end() ; ++it )
+        {
+            if( it->second == path )
+            {
+                watchId = it->first;
+                break;
+            }
+        }
+        this->watchMutex.unlock();
+
+        return ( watchId >= 0 and this->removeWatch(watchId) );
+    }
+
+    size_t BlackDirectoryWatcher::getWatchCount()
+    {
+        BlackLockGuard<BlackMutex> guard(this->watchMutex);
+        return this->watches.size();
+    }
+
+    void BlackDirectoryWatcher::setCallback(const std::function<void(const BlackDirectoryEvent&)> &eventCallback)
+    {
+        BlackLockGuard<BlackMutex> guard(this->watchMutex);
+        this->callback = eventCallback;
+    }
+
+    int BlackDirectoryWatcher::getFileDescriptor()
+    {
+        return this->inotifyFd;
+    }
+
+    unsigned int BlackDirectoryWatcher::readEvents(std::vector<BlackDirectoryEvent> &output, int timeoutMs)
+    {
+        if( this->inotifyFd < 0 )
+        {
+            return 0;
+        }
+
+        pollfd descriptor;
+        descriptor.fd       = this->inotifyFd;
+        descriptor.events   = POLLIN;
+        descriptor.revents  = 0;
+
+        if( ::poll(&descriptor, 1, timeoutMs) <= 0 )
+        {
+            return 0;
+        }
+
+        size_t firstIndex = output.size();
+        this->readAvailable(output, firstIndex);
+
+        if( this->coalesceMs > 0 )
+        {
+            timespec deadline;
+            ::clock_gettime(CLOCK_MONOTONIC, &deadline);
+            long long int deadlineMs = static_cast<long long int>(deadline.tv_sec) * 1000 + deadline.tv_nsec / 1000000 + this->coalesceMs;
+
+            while( true )
+            {
+                timespec now;
+                ::clock_gettime(CLOCK_MONOTONIC, &now);
+                long long int remaining = deadlineMs - ( static_cast<long long int>(now.tv_sec) * 1000 + now.tv_nsec / 1000000 );
+
+                if( remaining <= 0 or ::poll(&descriptor, 1, static_cast<int>(remaining)) <= 0 )
+                {
+                    break;
+                }
+
+                this->readAvailable(output, firstIndex);
+            }
+        }
+
+        return static_cast<unsigned int>(output.size() - firstIndex);
+    }
+
+    unsigned int BlackDirectoryWatcher::dispatch(int timeoutMs)
+    {
+        this->pending.clear();
+
+        unsigned int eventCount = this->readEvents(this->pending, timeoutMs);
+        if( eventCount == 0 )
+        {
+            return 0;
+        }
+
+        this->watchMutex.lock();
+        std::function<void(const BlackDirectoryEvent&)> eventCallback = this->callback;
+        this->watchMutex.unlock();
+
+        if( eventCallback )
+        {
+            for( size_t i = 0 ; i < this->pending.size() ; i++ )
+            {
+                eventCallback(this->pending[i]);
+            }
+        }
+
+        return eventCount;
+    }
+
+    bool BlackDirectoryWatcher::start(BlackThread::priority tp)
+    {
+        if( this->dispatchThread != NULL and this->dispatchThread->isRunning() )
+        {
+            return true;
+        }
+
+        this->stop();
+
+        this->dispatchThread = new dispatcher(this);
+        this->dispatchThread->setPriority(tp);
+        this->dispatchThread->setName("BlackDirWatcher");
+        this->dispatchThread->run();
+
+        return this->dispatchThread->isRunning();
+    }
+
+    void BlackDirectoryWatcher::stop()
+    {
+        if( this->dispatchThread != NULL )
+        {
+            this->dispatchThread->requestStop();
+            WAIT_THREAD_FINISH(this->dispatchThread)
+
+            delete this->dispatchThread;
+            this->dispatchThread = NULL;
+        }
+    }
+
+    bool BlackDirectoryWatcher::readAvailable(std::vector<BlackDirectoryEvent> &output, size_t firstIndex)
+    {
+        bool isRead = false;
+
+        while( true )
+        {
+            ssize_t readSize = ::read(this->inotifyFd, &(this->readBuffer[0]), this->readBuffer.size());
+            if( readSize <= 0 )
+            {
+                if( readSize < 0 and errno == EINTR ) { continue; }
+                break;
+            }
+
+            isRead = true;
+
+            BlackLockGuard<BlackMutex> guard(this->watchMutex);
+
+            for( ssize_t offset = 0 ; offset < readSize ; )
+            {
+                const inotify_event *record = reinterpret_cast<const inotify_event*>( &(this->readBuffer[offset]) );
+                offset += sizeof(inotify_event) + record->len;
+
+                unsigned int flags = BlackDirectoryWatcher::fromNativeMask(record->mask);
+                const char   *name = (record->len > 0) ? record->name : "";
+
+                std::map<int, std::string>::iterator watch = this->watches.find(record->wd);
+                if( watch == this->watches.end() and (flags & EventOverflow) == 0 )
+                {
+                    continue;
+                }
+
+                // only a repeat of the entry's newest event is merged, so created and deleted entries keep
+                // their order instead of becoming one event with both flags
+                size_t index = output.size();
+                while( index > firstIndex )
+                {
+                    const BlackDirectoryEvent &previous = output[index-1];
+                    if( previous.watchId == record->wd and previous.name == name ) { break; }
+                    index--;
+                }
+
+                if( index == firstIndex or output[index-1].events != flags )
+                {
+                    BlackDirectoryEvent event;
+                    event.watchId       = record->wd;
+                    event.name          = name;
+                    event.directory     = (watch != this->watches.end()) ? watch->second : "";
+                    event.isDirectory   = ( (record->mask & IN_ISDIR) != 0 );
+                    event.events        = flags;
+
+                    output.push_back(event);
+                }
+
+                if( flags & EventUnwatched )
+                {
+                    this->watches.erase(watch);
+                }
+            }
+        }
+
+        return isRead;
+    }
+
+    uint32_t BlackDirectoryWatcher::toNativeMask(unsigned int eventMask)
+    {
+        uint32_t nativeMask = 0;
+
+        if( eventMask & EventCreated )      { nativeMask |= IN_CREATE;                      }
+        if( eventMask & EventDeleted )      { nativeMask |= IN_DELETE | IN_DELETE_SELF;     }
+        if( eventMask & EventModified )     { nativeMask |= IN_MODIFY;                      }
+        if( eventMask & EventClosedWrite )  { nativeMask |= IN_CLOSE_WRITE;                 }
+        if( eventMask & EventMovedFrom )    { nativeMask |= IN_MOVED_FROM | IN_MOVE_SELF;   }
+        if( eventMask & EventMovedTo )      { nativeMask |= IN_MOVED_TO;                    }
+        if( eventMask & EventAttribute )    { nativeMask |= IN_ATTRIB;                      }
+
+        return nativeMask;
+    }
+
+    unsigned int BlackDirectoryWatcher::fromNativeMask(uint32_t nativeMask)
+    {
+        unsigned int eventMask = 0;
+
+        if( nativeMask & IN_CREATE )                        { eventMask |= EventCreated;        }
+        if( nativeMask & (IN_DELETE | IN_DELETE_SELF) )     { eventMask |= EventDeleted;        }
+        if( nativeMask & IN_MODIFY )                        { eventMask |= EventModified;       }
+        if( nativeMask & IN_CLOSE_WRITE )                   { eventMask |= EventClosedWrite;    }
+        if( nativeMask & (IN_MOVED_FROM | IN_MOVE_SELF) )   { eventMask |= EventMovedFrom;      }
+        if( nativeMask & IN_MOVED_TO )                      { eventMask |= EventMovedTo;        }
+        if( nativeMask & IN_ATTRIB )                        { eventMask |= EventAttribute;      }
+        if( nativeMask & IN_IGNORED )                       { eventMask |= EventUnwatched;      }
+        if( nativeMask & IN_Q_OVERFLOW )                    { eventMask |= EventOverflow;       }
+
+        return eventMask;
+    }
+    // ######################################### BLACKDIRECTORYWATCHER DEFINITION ENDS ######################################### //
+
+
+} /* namespace BlackLib */
@@ -0,0 +1,281 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKDIRECTORYWATCHER_H_
+#define BLACKDIRECTORYWATCHER_H_
+
+#include "../BlackThread/BlackThread.h"
+#include "../BlackMutex/BlackMutex.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <functional>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/inotify.h>
+
+
+
+namespace BlackLib
+{
+
+    // ######################################### BLACKDIRECTORYEVENT DECLARATION STARTS ######################################## //
+
+    /*! @brief Holds a file system change which is reported by BlackDirectoryWatcher.
+    *
+    *    Repeats of the same change of an entry in a burst are merged to one event. Different changes
+    *    stay separate events in their order, so @a events usually holds one
+    *    BlackDirectoryWatcher::watchEvent flag.
+    */
+    struct BlackDirectoryEvent
+    {
+        /*! @brief Default constructor of BlackDirectoryEvent struct.
+         *
+         *  This function sets default value to variables.
+         */
+        BlackDirectoryEvent()
+        {
+            watchId     = -1;
+            events      = 0;
+            isDirectory = false;
+        }
+
+        int             watchId;            /*!< @brief is used to hold the watch id which is returned by addWatch() */
+        std::string     directory;          /*!< @brief is used to hold the watched path */
+        std::string     name;               /*!< @brief is used to hold the entry name, empty if the event belongs to the watched path */
+        unsigned int    events;             /*!< @brief is used to hold the BlackDirectoryWatcher::watchEvent flags */
+        bool            isDirectory;        /*!< @brief is used to hold the entry is a directory or not */
+    };
+
+    // ########################################## BLACKDIRECTORYEVENT DECLARATION ENDS ######################################### //
+
+
+
+
+
+    // ######################################## BLACKDIRECTORYWATCHER DECLARATION STARTS ####################################### //
+
+    /*! @brief Reports the changes at directories with inotify.
+    *
+    *    This class watches many directories with one inotify descriptor, so hot-plugged device nodes or
+    *    newly dropped files can be handled without polling BlackDirectory. Events can be read with
+    *    readEvents(), or dispatched to a callback with dispatch() at the caller thread or with the
+    *    internal thread which is started by start(). The descriptor can be added to users' own
+    *    poll/epoll loop with getFileDescriptor().
+    *
+    *    Bursts are coalesced: after the first event, the watcher keeps reading for the coalescing
+    *    window, and an event which repeats the newest event of the same entry is dropped. Different
+    *    changes aren't merged, so a created and deleted entry is reported as two events in that order.
+    *
+    *    Watch functions are thread safe. dispatch() and readEvents() should be called from one thread.
+    *
+    * @par Example
+    * @code{.cpp}
+    *  // Filename: myWatcherProject.cpp
+    *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+    *
+    *  #include <iostream>
+    *  #include "BlackLib/BlackDirectoryWatcher/BlackDirectoryWatcher.h"
+    *
+    *  void onChange(const BlackLib::BlackDirectoryEvent &event)
+    *  {
+    *      if( event.events & BlackLib::BlackDirectoryWatcher::EventCreated )
+    *      {
+    *          std::cout << "New node: " << event.directory << "/" << event.name << std::endl;
+    *      }
+    *  }
+    *
+    *  int main()
+    *  {
+    *      BlackLib::BlackDirectoryWatcher watcher(50);
+    *
+    *      watcher.addWatch("/dev", BlackLib::BlackDirectoryWatcher::EventCreated | BlackLib::BlackDirectoryWatcher::EventDeleted);
+    *      watcher.addWatch("/etc/myapp", BlackLib::BlackDirectoryWatcher::EventClosedWrite | BlackLib::BlackDirectoryWatcher::EventMovedTo);
+    *      watcher.setCallback(&onChange);
+    *
+    *      while( true )
+    *      {
+    *          watcher.dispatch();
+    *      }
+    *  }
+    * @endcode
+    */
+    class BlackDirectoryWatcher
+    {
+        private:
+
+            /*! @brief Internal dispatcher thread.
+            */
+            class dispatcher : public BlackThread
+            {
+                public:
+                                        dispatcher(BlackDirectoryWatcher *ownerWatcher);
+
+                private:
+                    BlackDirectoryWatcher *watcher;         /*!< @brief is used to hold the owner watcher */
+
+                    void                onStartHandler();
+            };
+
+
+            int                         inotifyFd;          /*!< @brief is used to hold the inotify descriptor */
+            unsigned int                coalesceMs;         /*!< @brief is used to hold the coalescing window in milliseconds */
+            std::map<int, std::string>  watches;            /*!< @brief is used to hold the watched paths by watch id */
+            BlackMutex                  watchMutex;         /*!< @brief is used to protect the watch list and the callback */
+            std::function<void(const BlackDirectoryEvent&)> callback;   /*!< @brief is used to hold the event function */
+            std::vector<char>           readBuffer;         /*!< @brief is used to hold the raw inotify records */
+            std::vector<BlackDirectoryEvent> pending;       /*!< @brief is used to hold the events of current dispatch */
+            dispatcher                  *dispatchThread;    /*!< @brief is used to hold the internal dispatcher thread */
+
+            /*! @brief Converts watchEvent flags to inotify mask.
+            */
+            static uint32_t             toNativeMask(unsigned int eventMask);
+
+            /*! @brief Converts inotify mask to watchEvent flags.
+            */
+            static unsigned int         fromNativeMask(uint32_t nativeMask);
+
+            /*! @brief Reads the available records and appends them to the output, repeats are merged.
+            *
+            *  @return false if nothing could be read else true.
+            */
+            bool                        readAvailable(std::vector<BlackDirectoryEvent> &output, size_t firstIndex);
+
+            BlackDirectoryWatcher(const BlackDirectoryWatcher&);
+            BlackDirectoryWatcher& operator=(const BlackDirectoryWatcher&);
+
+
+        public:
+
+            /*!
+            * This enum is used to select and report the change types. Values can be combined.
+            */
+            enum watchEvent
+            {
+                EventCreated        = 1,        /*!< enumeration for @a created entries */
+                EventDeleted        = 2,        /*!< enumeration for @a deleted entries or deleted watched path */
+                EventModified       = 4,        /*!< enumeration for @a written entries */
+                EventClosedWrite    = 8,        /*!< enumeration for @a entries which are closed after writing */
+                EventMovedFrom      = 16,       /*!< enumeration for @a entries which are moved out, or moved watched path */
+                EventMovedTo        = 32,       /*!< enumeration for @a entries which are moved in */
+                EventAttribute      = 64,       /*!< enumeration for @a permission, owner or time changes */
+                EventAll            = 127,      /*!< enumeration for @a all change types */
+                EventUnwatched      = 128,      /*!< enumeration for @a removed watch, it is reported even if it isn't selected */
+                EventOverflow       = 256       /*!< enumeration for @a lost events, it is reported even if it isn't selected */
+            };
+
+            /*! @brief Constructor of BlackDirectoryWatcher class.
+            *
+            *  @param [in] coalesceWindowMs  time to wait for more events after the first one, 0 disables coalescing
+            */
+                                        BlackDirectoryWatcher(unsigned int coalesceWindowMs = 0);
+
+            /*! @brief Destructor of BlackDirectoryWatcher class.
+            *
+            *  This function stops the internal dispatcher thread and closes the inotify descriptor.
+            */
+            virtual                     ~BlackDirectoryWatcher();
+
+            /*! @brief Starts watching a directory or a file.
+            *
+            *  Adding the same path again replaces its event selection.
+            *  @param [in] path         watched path
+            *  @param [in] eventMask    combination of watchEvent flags
+            *  @return Watch id, -1 if the path couldn't be watched.
+            */
+            int                         addWatch(const std::string &path, unsigned int eventMask = BlackDirectoryWatcher::EventAll);
+
+            /*! @brief Stops watching a path.
+            *
+            *  @param [in] watchId      watch id which is returned by addWatch()
+            *  @return true if the watch is removed else false.
+            */
+            bool                        removeWatch(int watchId);
+
+            /*! @brief Stops watching a path.
+            *
+            *  @param [in] path         watched path which is given to addWatch()
+            *  @return true if the watch is removed else false.
+            */
+            bool                        removeWatch(const std::string &path);
+
+            /*! @brief Exports the watched path count.
+            */
+            size_t                      getWatchCount();
+
+            /*! @brief Sets the function which is called by dispatch() for every event.
+            */
+            void                        setCallback(const std::function<void(const BlackDirectoryEvent&)> &eventCallback);
+
+            /*! @brief Exports the inotify descriptor for users' own poll/epoll loop.
+            *
+            *  When the descriptor is readable, dispatch(0) or readEvents() should be called.
+            */
+            int                         getFileDescriptor();
+
+            /*! @brief Waits for events and appends the coalesced events to a vector.
+            *
+            *  @param [out] output      vector which the events are appended to
+            *  @param [in]  timeoutMs   wait time in milliseconds, negative means wait until an event
+            *  @return Appended event count.
+            */
+            unsigned int                readEvents(std::vector<BlackDirectoryEvent> &output, int timeoutMs = -1);
+
+            /*! @brief Waits for events and calls the callback for every coalesced event at the caller thread.
+            *
+            *  @param [in] timeoutMs    wait time in milliseconds, negative means wait until an event
+            *  @return Dispatched event count.
+            */
+            unsigned int                dispatch(int timeoutMs = -1);
+
+            /*! @brief Runs an internal thread which calls dispatch().
+            *
+            *  @param [in] tp           priority of the dispatcher thread
+            *  @return true if the thread is running else false.
+            */
+            bool                        start(BlackThread::priority tp = BlackThread::PriorityDEFAULT);
+
+            /*! @brief Stops the internal dispatcher thread and waits until it finishes.
+            */
+            void                        stop();
+    };
+
+    // ######################################### BLACKDIRECTORYWATCHER DECLARATION ENDS ######################################## //
+
+
+
+} /* namespace BlackLib */
+
+#endif /* BLACKDIRECTORYWATCHER_H_ */
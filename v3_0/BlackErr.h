@@ -32,6 +32,8 @@
 #ifndef BLACKERR_H_
 #define BLACKERR_H_
 
+#include <cerrno>
+
 
 
 
@@ -42,7 +44,8 @@ namespace BlackLib
     /*! @brief Holds BlackCore errors.
      *
      *    This struct is base of the ERROR DATA STRUCT.
-     *    The rest of error data structs include this.
+     *    The rest of error data structs include this. It is held by the BlackBoard object and
+     *    shared by all peripheral objects.
      */
     struct errorCore
     {
@@ -51,8 +54,8 @@ namespace BlackLib
          *  Its value can change, when finding @a capemgr.X name, at @n
          *  @li findCapeMgrName()
          *
-         *  function in BlackCore class.
-         *  @sa BlackCore::findCapeMgrName()
+         *  function in BlackBoard class.
+         *  @sa BlackBoard::findCapeMgrName()
          */
         bool capeMgrError;
 
@@ -62,8 +65,8 @@ namespace BlackLib
          *  Its value can change, when finding @a ocp.X name, at @n
          *  @li findOcpName()
          *
-         *  function in BlackCore class.
-         *  @sa BlackCore::findOcpName()
+         *  function in BlackBoard class.
+         *  @sa BlackBoard::findOcpName()
          */
         bool ocpError;
 
@@ -451,6 +454,81 @@ namespace BlackLib
 
 
 
+    /*! @brief Holds BlackPWMGroup errors.
+     *
+     *    This struct holds PWM group errors.
+     */
+    struct errorPWMGroup
+    {
+        /*! @brief Out of range value error.
+        *
+        *  Its value can change, when staging or committing new values, at@n
+        *  @li stageDutyPercent()
+        *  @li stagePeriodTime()
+        *  @li stageSpaceRatioTime()
+        *  @li commit()
+        *
+        *  functions in BlackPWMGroup class.
+        *  @sa BlackPWMGroup::stageDutyPercent()
+        *  @sa BlackPWMGroup::stagePeriodTime()
+        *  @sa BlackPWMGroup::stageSpaceRatioTime()
+        *  @sa BlackPWMGroup::commit()
+        */
+        bool outOfRange;
+
+
+        /*! @brief Channel @b finding error.
+        *
+        *  Its value can change, when staging values to a pwm which isn't added to group, at@n
+        *  @li stageDutyPercent()
+        *  @li stagePeriodTime()
+        *  @li stageSpaceRatioTime()
+        *
+        *  functions in BlackPWMGroup class.
+        */
+        bool channelError;
+
+
+        /*! @brief Staged values @b writing error.
+        *
+        *  Its value can change, when writing staged values to pwm_test files or registers, at@n
+        *  @li commit()
+        *
+        *  function in BlackPWMGroup class.
+        *  @sa BlackPWMGroup::commit()
+        */
+        bool writeError;
+
+
+        /*! @brief EHRPWM register @b mapping error.
+        *
+        *  Its value can change, when mapping EHRPWM registers from /dev/mem, at@n
+        *  @li BlackPWMGroup()
+        *  @li addChannel()
+        *
+        *  functions in BlackPWMGroup class.
+        *  @sa BlackPWMGroup::addChannel()
+        */
+        bool mapError;
+
+
+        /*! @brief errorPWMGroup struct's constructor.
+         *
+         *  This function clears all flags.
+         */
+        errorPWMGroup()
+        {
+            outOfRange      = false;
+            channelError    = false;
+            writeError      = false;
+            mapError        = false;
+        }
+    };
+
+
+
+
+
     /*! @brief Holds BlackCoreGPIO errors.
      *
      *    This struct holds GPIO core errors and includes pointer of errorCore struct.
@@ -849,6 +927,17 @@ namespace BlackLib
         bool charSizeError;
 
 
+        /*! @brief UART's @b interrupt @b counters reading error.
+        *
+        *  Its value can change, when reading kernel's uart line counters with TIOCGICOUNT, at@n
+        *  @li getStatistics()
+        *
+        *  function in BlackUART class.
+        *  @sa BlackUART::getStatistics()
+        */
+        bool statisticsError;
+
+
         /*! @brief errorUART struct's constructor.
          *
          *  This function clears all flags and initializes errorCore struct.
@@ -866,6 +955,7 @@ namespace BlackLib
             parityError     = false;
             stopBitsError   = false;
             charSizeError   = false;
+            statisticsError = false;
             coreErrors      = new errorCore();
         }
 
@@ -889,6 +979,7 @@ namespace BlackLib
             parityError     = false;
             stopBitsError   = false;
             charSizeError   = false;
+            statisticsError = false;
             coreErrors      = base;
         }
     };
@@ -1202,6 +1293,158 @@ namespace BlackLib
 
 
 
+    /*! @brief Error codes of the result returning functions.
+     *
+     *    These codes are returned by value with BlackResult objects, so checking an error doesn't
+     *    need heap allocation or string comparison. Related operating system error is kept with them
+     *    as errno value.
+     */
+    enum class BlackError : int
+    {
+        None            = 0,        /*!< enumeration for @a successful operation */
+        NotReady        = 1,        /*!< enumeration for @a not exported, not loaded or closed device */
+        OpenFailed      = 2,        /*!< enumeration for @a file or device opening error */
+        ReadFailed      = 3,        /*!< enumeration for @a reading error */
+        WriteFailed     = 4,        /*!< enumeration for @a writing error */
+        ParseFailed     = 5,        /*!< enumeration for @a unexpected file content */
+        OutOfRange      = 6,        /*!< enumeration for @a out of range parameter */
+        IoctlFailed     = 7,        /*!< enumeration for @a ioctl error */
+        Timeout         = 8         /*!< enumeration for @a expired wait */
+    };
+
+    /*! @brief Exports the name of an error code.
+     *
+     *  @param [in] error    error code
+     *  @return Constant name string, it isn't allocated.
+     */
+    inline const char *errorToString(BlackError error)
+    {
+        switch( error )
+        {
+            case BlackError::None:          { return "None";        }
+            case BlackError::NotReady:      { return "NotReady";    }
+            case BlackError::OpenFailed:    { return "OpenFailed";  }
+            case BlackError::ReadFailed:    { return "ReadFailed";  }
+            case BlackError::WriteFailed:   { return "WriteFailed"; }
+            case BlackError::ParseFailed:   { return "ParseFailed"; }
+            case BlackError::OutOfRange:    { return "OutOfRange";  }
+            case BlackError::IoctlFailed:   { return "IoctlFailed"; }
+            case BlackError::Timeout:       { return "Timeout";     }
+        }
+
+        return "Unknown";
+    }
+
+
+
+    /*! @brief Holds a value or an error code.
+     *
+     *    This class is returned by value from the @b try functions of device classes. They report the
+     *    result of the current call only; fail() functions keep working as before and are updated by
+     *    these functions too.
+     *
+     * @par Example
+     * @code{.cpp}
+     *   BlackLib::BlackResult<int> value = myGpio.tryGetValue();
+     *
+     *   if( value )
+     *   {
+     *       std::cout << "Value: " << value.getValue() << std::endl;
+     *   }
+     *   else
+     *   {
+     *       std::cout << "Error: " << BlackLib::errorToString(value.getError())
+     *                 << " errno: " << value.getErrno() << std::endl;
+     *   }
+     * @endcode
+     *
+     * @tparam T value type
+     */
+    template <typename T>
+    class BlackResult
+    {
+        private:
+            T               value;              /*!< @brief is used to hold the value */
+            BlackError      error;              /*!< @brief is used to hold the error code */
+            int             errorNumber;        /*!< @brief is used to hold the errno value of the error */
+
+        public:
+            /*! @brief Constructor of successful result.
+            */
+            BlackResult(const T &resultValue) : value(resultValue), error(BlackError::None), errorNumber(0) {}
+
+            /*! @brief Constructor of failed result.
+            *
+            *  @param [in] resultError      error code
+            *  @param [in] resultErrno      related errno value
+            */
+            BlackResult(BlackError resultError, int resultErrno) : value(), error(resultError), errorNumber(resultErrno) {}
+
+            /*! @brief Checks the result is successful or not.
+            */
+            bool            isOk() const                        { return (this->error == BlackError::None); }
+
+            /*! @brief Checks the result is successful or not.
+            */
+            explicit        operator bool() const               { return this->isOk(); }
+
+            /*! @brief Exports the value, it is value-initialized if the result is failed.
+            */
+            const T        &getValue() const                    { return this->value; }
+
+            /*! @brief Exports the value if the result is successful, else the fallback value.
+            */
+            T               getValueOr(const T &fallback) const { return this->isOk() ? this->value : fallback; }
+
+            /*! @brief Exports the error code.
+            */
+            BlackError      getError() const                    { return this->error; }
+
+            /*! @brief Exports the errno value of the error, 0 if it isn't related to a system call.
+            */
+            int             getErrno() const                    { return this->errorNumber; }
+    };
+
+    /*! @brief Holds an error code of an operation which doesn't return a value.
+     */
+    template <>
+    class BlackResult<void>
+    {
+        private:
+            BlackError      error;              /*!< @brief is used to hold the error code */
+            int             errorNumber;        /*!< @brief is used to hold the errno value of the error */
+
+        public:
+            /*! @brief Constructor of successful result.
+            */
+            BlackResult() : error(BlackError::None), errorNumber(0) {}
+
+            /*! @brief Constructor of failed result.
+            *
+            *  @param [in] resultError      error code
+            *  @param [in] resultErrno      related errno value
+            */
+            BlackResult(BlackError resultError, int resultErrno) : error(resultError), errorNumber(resultErrno) {}
+
+            /*! @brief Checks the result is successful or not.
+            */
+            bool            isOk() const                        { return (this->error == BlackError::None); }
+
+            /*! @brief Checks the result is successful or not.
+            */
+            explicit        operator bool() const               { return this->isOk(); }
+
+            /*! @brief Exports the error code.
+            */
+            BlackError      getError() const                    { return this->error; }
+
+            /*! @brief Exports the errno value of the error, 0 if it isn't related to a system call.
+            */
+            int             getErrno() const                    { return this->errorNumber; }
+    };
+
+
+
 } /* namespace BlackLib */
 
 #endif /* BLACKERR_H_ */
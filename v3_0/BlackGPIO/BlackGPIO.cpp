@@ -38,12 +38,19 @@
 namespace BlackLib
 {
 
+    // names of the BlackGPIO::flags values, they are used as error labels of metrics
+    static const char *const gpioFlagNames[BlackIoMetrics::flagCount] =
+    {
+        "exportFileErr", "exportErr", "directionFileErr", "directionErr",
+        "readErr", "writeErr", "forcingErr"
+    };
+
+
     // ######################################### BLACKCOREGPIO DEFINITION STARTS ######################################### //
-                BlackCoreGPIO::BlackCoreGPIO(gpioName pin, direction dir)
+                BlackCoreGPIO::BlackCoreGPIO(gpioName pin, direction dir) : gpioCoreError(this->getErrorsFromCore())
     {
         this->pinNumericName    = static_cast<int>(pin);
         this->pinNumericType    = static_cast<int>(dir);
-        this->gpioCoreError     = new errorCoreGPIO( this->getErrorsFromCore() );
 
 
         this->expPath           = "/sys/class/gpio/export";
@@ -58,7 +65,6 @@ namespace BlackLib
     BlackCoreGPIO::~BlackCoreGPIO()
     {
         this->doUnexport();
-        delete this->gpioCoreError;
     }
 
     bool        BlackCoreGPIO::loadDeviceTree()
@@ -76,7 +82,7 @@ namespace BlackLib
         if(expFile.fail())
         {
             expFile.close();
-            this->gpioCoreError->exportFileError = true;
+            this->gpioCoreError.exportFileError = true;
             return false;
         }
         else
@@ -84,7 +90,7 @@ namespace BlackLib
             expFile << this->pinNumericName;
 
             expFile.close();
-            this->gpioCoreError->exportFileError = false;
+            this->gpioCoreError.exportFileError = false;
             return true;
         }
     }
@@ -97,7 +103,7 @@ namespace BlackLib
         if(directionFile.fail())
         {
             directionFile.close();
-            this->gpioCoreError->directionFileError = true;
+            this->gpioCoreError.directionFileError = true;
             return false;
         }
         else
@@ -112,7 +118,7 @@ namespace BlackLib
             }
 
             directionFile.close();
-            this->gpioCoreError->directionFileError = false;
+            this->gpioCoreError.directionFileError = false;
             return true;
         }
     }
@@ -151,7 +157,7 @@ namespace BlackLib
 
     errorCoreGPIO *BlackCoreGPIO::getErrorsFromCoreGPIO()
     {
-        return (this->gpioCoreError);
+        return &(this->gpioCoreError);
     }
 
     // ########################################## BLACKCOREGPIO DEFINITION ENDS ########################################## //
@@ -166,18 +172,33 @@ namespace BlackLib
 
 
     // ########################################### BLACKGPIO DEFINITION STARTS ########################################### //
-    BlackGPIO::BlackGPIO(gpioName pin, direction dir, workingMode wm) : BlackCoreGPIO(pin, dir)
+    BlackGPIO::BlackGPIO(gpioName pin, direction dir, workingMode wm) : BlackCoreGPIO(pin, dir), gpioErrors(this->getErrorsFromCoreGPIO()), ioMetrics("gpio", gpioFlagNames)
     {
         this->pinName       = pin;
         this->pinDirection  = dir;
         this->workMode      = wm;
-        this->gpioErrors    = new errorGPIO( this->getErrorsFromCoreGPIO() );
         this->valuePath     = this->getValueFilePath();
+        this->valueFD       = -1;
     }
 
     BlackGPIO::~BlackGPIO()
     {
-        delete this->gpioErrors;
+        if( this->valueFD >= 0 )
+        {
+            ::close(this->valueFD);
+        }
+    }
+
+
+    bool        BlackGPIO::openValueFile()
+    {
+        if( this->valueFD < 0 )
+        {
+            int flags       = (this->pinDirection == output) ? O_RDWR : O_RDONLY;
+            this->valueFD   = ::open(this->valuePath.c_str(), flags | O_CLOEXEC);
+        }
+
+        return (this->valueFD >= 0);
     }
 
 
@@ -193,12 +214,12 @@ namespace BlackLib
         exportCheck.open(valuePath.c_str(),std::ios::in|std::ios::binary);
         if(exportCheck.fail())
         {
-            this->gpioErrors->exportError = true;
+            this->gpioErrors.exportError = true;
             return false;
         }
         else
         {
-            this->gpioErrors->exportError = false;
+            this->gpioErrors.exportError = false;
             exportCheck.close();
             return true;
         }
@@ -212,7 +233,7 @@ namespace BlackLib
         if(directionCheck.fail())
         {
             directionCheck.close();
-            this->gpioErrors->directionError = true;
+            this->gpioErrors.directionError = true;
             return false;
         }
         else
@@ -223,13 +244,13 @@ namespace BlackLib
             if( (this->pinDirection == input and readValue=="in") or (this->pinDirection == output and readValue=="out") )
             {
                 directionCheck.close();
-                this->gpioErrors->directionError = false;
+                this->gpioErrors.directionError = false;
                 return true;
             }
             else
             {
                 directionCheck.close();
-                this->gpioErrors->directionError = true;
+                this->gpioErrors.directionError = true;
                 return false;
             }
         }
@@ -238,64 +259,66 @@ namespace BlackLib
 
     std::string BlackGPIO::getValue()
     {
-        if( this->workMode == SecureMode )
+        BlackResult<int> result = this->tryGetValue();
+
+        if( result.isOk() )
         {
-            if( ! this->isReady())
-            {
-                return GPIO_PIN_NOT_READY_STRING;
-            }
+            return (result.getValue() == 1) ? "1" : "0";
         }
 
+        return (result.getError() == BlackError::NotReady) ? GPIO_PIN_NOT_READY_STRING : FILE_COULD_NOT_OPEN_STRING;
+    }
 
-        std::ifstream valueFile;
+    int         BlackGPIO::getNumericValue()
+    {
+        BlackResult<int> result = this->tryGetValue();
 
-        valueFile.open(valuePath.c_str(),std::ios::in);
-        if(valueFile.fail())
+        if( result.isOk() )
         {
-            valueFile.close();
-            this->gpioErrors->readError = true;
-            return FILE_COULD_NOT_OPEN_STRING;
+            return result.getValue();
         }
-        else
-        {
-            std::string readValue;
-            valueFile >> readValue;
 
-            valueFile.close();
-            this->gpioErrors->readError = false;
-            return readValue;
-        }
+        return (result.getError() == BlackError::NotReady) ? GPIO_PIN_NOT_READY_INT : FILE_COULD_NOT_OPEN_INT;
     }
 
-    int         BlackGPIO::getNumericValue()
+    BlackResult<int> BlackGPIO::tryGetValue()
     {
+        BLACKLIB_TRACE_SCOPE(TraceGpioRead, static_cast<uint32_t>(this->pinName), 1, this->gpioErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 1, readErr, this->gpioErrors.readError);
+
         if( this->workMode == SecureMode )
         {
             if( ! this->isReady())
             {
-                return GPIO_PIN_NOT_READY_INT;
+                this->gpioErrors.readError = true;
+                return BlackResult<int>(BlackError::NotReady, 0);
             }
         }
 
 
-        std::ifstream valueFile;
-
-        valueFile.open(valuePath.c_str(),std::ios::in);
-        if(valueFile.fail())
+        if( ! this->openValueFile() )
         {
-            valueFile.close();
-            this->gpioErrors->readError = true;
-            return FILE_COULD_NOT_OPEN_INT;
+            this->gpioErrors.readError = true;
+            return BlackResult<int>(BlackError::OpenFailed, errno);
         }
-        else
+
+        char readBuffer[8];
+        ssize_t readSize = ::pread(this->valueFD, readBuffer, sizeof(readBuffer), 0);
+        if( readSize < 0 )
         {
-            int readValue;
-            valueFile >> readValue;
+            this->gpioErrors.readError = true;
+            return BlackResult<int>(BlackError::ReadFailed, errno);
+        }
 
-            valueFile.close();
-            this->gpioErrors->readError = false;
-            return readValue;
+        int64_t readValue = 0;
+        if( ! charsToInt(readBuffer, static_cast<size_t>(readSize), readValue) )
+        {
+            this->gpioErrors.readError = true;
+            return BlackResult<int>(BlackError::ParseFailed, 0);
         }
+
+        this->gpioErrors.readError = false;
+        return BlackResult<int>(static_cast<int>(readValue));
     }
 
     gpioName    BlackGPIO::getName()
@@ -310,51 +333,52 @@ namespace BlackLib
 
     bool        BlackGPIO::setValue(digitalValue status)
     {
+        return this->trySetValue(status).isOk();
+    }
+
+    BlackResult<void> BlackGPIO::trySetValue(digitalValue status)
+    {
+        BLACKLIB_TRACE_SCOPE(TraceGpioWrite, static_cast<uint32_t>(this->pinName), 1, this->gpioErrors.writeError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 1, writeErr, this->gpioErrors.writeError);
+
         if( !(this->pinDirection == output) )
         {
-            this->gpioErrors->writeError = true;
-            this->gpioErrors->forcingError = true;
-            return false;
+            this->gpioErrors.writeError = true;
+            this->gpioErrors.forcingError = true;
+            return BlackResult<void>(BlackError::OutOfRange, 0);
         }
 
 
 
-        this->gpioErrors->forcingError = false;
+        this->gpioErrors.forcingError = false;
 
         if( this->workMode == SecureMode )
         {
             if( ! this->isReady())
             {
-                this->gpioErrors->writeError = true;
-                return false;
+                this->gpioErrors.writeError = true;
+                return BlackResult<void>(BlackError::NotReady, 0);
             }
         }
 
 
 
-        std::ofstream valueFile;
-        valueFile.open(this->valuePath.c_str(), std::ios::out);
-        if(valueFile.fail())
+        if( ! this->openValueFile() )
         {
-            valueFile.close();
-            this->gpioErrors->writeError = true;
-            return false;
+            this->gpioErrors.writeError = true;
+            return BlackResult<void>(BlackError::OpenFailed, errno);
         }
-        else
-        {
-            if( status == high )
-            {
-                valueFile << "1";
-            }
-            else
-            {
-                valueFile << "0";
-            }
 
-            valueFile.close();
-            this->gpioErrors->writeError = false;
-            return true;
+        const char writeValue = (status == high) ? '1' : '0';
+
+        if( ::pwrite(this->valueFD, &writeValue, 1, 0) != 1 )
+        {
+            this->gpioErrors.writeError = true;
+            return BlackResult<void>(BlackError::WriteFailed, errno);
         }
+
+        this->gpioErrors.writeError = false;
+        return BlackResult<void>();
     }
 
 
@@ -368,11 +392,11 @@ namespace BlackLib
     {
         if( !(this->pinDirection == output) )
         {
-            this->gpioErrors->forcingError = true;
+            this->gpioErrors.forcingError = true;
         }
         else
         {
-            this->gpioErrors->forcingError = false;
+            this->gpioErrors.forcingError = false;
             if( (this->getNumericValue() == 1) )
             {
                 this->setValue(low);
@@ -399,147 +423,53 @@ namespace BlackLib
 
     bool        BlackGPIO::fail()
     {
-        return (this->gpioErrors->readError or
-                this->gpioErrors->writeError or
-                this->gpioErrors->exportError or
-                this->gpioErrors->forcingError or
-                this->gpioErrors->directionError
+        return (this->gpioErrors.readError or
+                this->gpioErrors.writeError or
+                this->gpioErrors.exportError or
+                this->gpioErrors.forcingError or
+                this->gpioErrors.directionError
                 );
     }
 
     bool        BlackGPIO::fail(BlackGPIO::flags f)
     {
-        if(f==readErr)          { return this->gpioErrors->readError;                           }
-        if(f==writeErr)         { return this->gpioErrors->writeError;                          }
-        if(f==exportErr)        { return this->gpioErrors->exportError;                         }
-        if(f==forcingErr)       { return this->gpioErrors->forcingError;                        }
-        if(f==directionErr)     { return this->gpioErrors->directionError;                      }
-        if(f==exportFileErr)    { return this->gpioErrors->gpioCoreErrors->exportFileError;     }
-        if(f==directionFileErr) { return this->gpioErrors->gpioCoreErrors->directionFileError;  }
+        if(f==readErr)          { return this->gpioErrors.readError;                            }
+        if(f==writeErr)         { return this->gpioErrors.writeError;                           }
+        if(f==exportErr)        { return this->gpioErrors.exportError;                          }
+        if(f==forcingErr)       { return this->gpioErrors.forcingError;                         }
+        if(f==directionErr)     { return this->gpioErrors.directionError;                       }
+        if(f==exportFileErr)    { return this->gpioErrors.gpioCoreErrors->exportFileError;      }
+        if(f==directionFileErr) { return this->gpioErrors.gpioCoreErrors->directionFileError;   }
 
         return true;
     }
 
-
-
-
-    BlackGPIO&  BlackGPIO::operator>>(std::string &readToThis)
+    BlackIoMetrics *BlackGPIO::getMetrics()
     {
-        if( this->workMode == SecureMode )
-        {
-            if( ! this->isReady())
-            {
-                readToThis = GPIO_PIN_NOT_READY_STRING;
-                return *this;
-            }
-        }
-
+        return &(this->ioMetrics);
+    }
 
-        std::string readValue;
-        std::ifstream valueFile;
 
-        valueFile.open(valuePath.c_str(),std::ios::in);
-        if(valueFile.fail())
-        {
-            valueFile.close();
-            this->gpioErrors->readError = true;
-            readValue = FILE_COULD_NOT_OPEN_STRING;
-        }
-        else
-        {
-            valueFile >> readValue;
 
-            valueFile.close();
-            this->gpioErrors->readError = false;
-        }
 
-        readToThis = readValue;
+    BlackGPIO&  BlackGPIO::operator>>(std::string &readToThis)
+    {
+        readToThis = this->getValue();
         return *this;
     }
 
 
     BlackGPIO&  BlackGPIO::operator>>(int &readToThis)
     {
-        if( this->workMode == SecureMode )
-        {
-            if( ! this->isReady())
-            {
-                readToThis = GPIO_PIN_NOT_READY_INT;
-                return *this;
-            }
-        }
-
-
-        int readValue;
-        std::ifstream valueFile;
-
-        valueFile.open(valuePath.c_str(),std::ios::in);
-        if(valueFile.fail())
-        {
-            valueFile.close();
-            this->gpioErrors->readError = true;
-            readValue = FILE_COULD_NOT_OPEN_INT;
-        }
-        else
-        {
-            valueFile >> readValue;
-
-            valueFile.close();
-            this->gpioErrors->readError = false;
-        }
-
-        readToThis = readValue;
+        readToThis = this->getNumericValue();
         return *this;
     }
 
 
     BlackGPIO&  BlackGPIO::operator<<(digitalValue value)
     {
-        if( !(this->pinDirection == output) )
-        {
-            this->gpioErrors->writeError = true;
-            this->gpioErrors->forcingError = true;
-            return *this;
-        }
-
-
-
-        this->gpioErrors->forcingError = false;
-
-        if( this->workMode == SecureMode )
-        {
-            if( ! this->isReady())
-            {
-                this->gpioErrors->writeError = true;
-                return *this;
-            }
-        }
-
-
-
-        std::ofstream valueFile;
-        valueFile.open(this->valuePath.c_str(), std::ios::out);
-        if(valueFile.fail())
-        {
-            valueFile.close();
-            this->gpioErrors->writeError = true;
-            return *this;
-        }
-        else
-        {
-            if( value == high )
-            {
-                valueFile << "1";
-            }
-            else
-            {
-                valueFile << "0";
-            }
-
-            valueFile.close();
-            this->gpioErrors->writeError = false;
-            return *this;
-        }
+        this->trySetValue(value);
+        return *this;
     }
 
 
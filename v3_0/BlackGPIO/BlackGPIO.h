@@ -34,6 +34,8 @@
 
 #include <fstream>
 #include <string>
+#include <unistd.h>
+#include <fcntl.h>
 
 
 
@@ -111,7 +113,7 @@ namespace BlackLib
     class BlackCoreGPIO : virtual private BlackCore
     {
         private:
-            errorCoreGPIO   *gpioCoreError;         /*!< @brief is used to hold the errors of BlackCoreGPIO class */
+            errorCoreGPIO    gpioCoreError;         /*!< @brief is used to hold the errors of BlackCoreGPIO class */
             int             pinNumericName;         /*!< @brief is used to hold the selected pin number */
             int             pinNumericType;         /*!< @brief is used to hold the selected pin direction */
             std::string     expPath;                /*!< @brief is used to hold the @a export file path */
@@ -185,7 +187,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackCoreGPIO class.
             *
-            * This function unexports pin and deletes errorCoreGPIO struct pointer.
+            * This function unexports pin.
             */
             virtual         ~BlackCoreGPIO();
 
@@ -305,11 +307,22 @@ namespace BlackLib
     class BlackGPIO : virtual private BlackCoreGPIO
     {
         private:
-            errorGPIO       *gpioErrors;                    /*!< @brief is used to hold the errors of BlackGPIO class */
+            errorGPIO        gpioErrors;                    /*!< @brief is used to hold the errors of BlackGPIO class */
+            BlackIoMetrics   ioMetrics;                     /*!< @brief is used to hold the I/O metrics of BlackGPIO class */
             gpioName        pinName;                        /*!< @brief is used to hold the selected GPIO pin name */
             direction       pinDirection;                   /*!< @brief is used to hold the selected GPIO pin direction */
             workingMode     workMode;                       /*!< @brief is used to hold the selected working mode */
             std::string     valuePath;                      /*!< @brief is used to hold the value file path */
+            int             valueFD;                        /*!< @brief is used to hold the value file's file descriptor */
+
+            /*! @brief Opens value file of GPIO pin, if it is not opened yet.
+            *
+            * The file is opened with read only mode for input pins and read/write mode for output pins.
+            * The file descriptor is held until object destruction, so reads and writes are done with
+            * one pread() or pwrite() call.
+            * @return True if BlackGPIO::valueFD holds an open file descriptor, else false.
+            */
+            bool            openValueFile();
 
             /*! @brief Checks the export state of GPIO pin.
             *
@@ -385,7 +398,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackGPIO class.
             *
-            * This function deletes errorGPIO struct pointer.
+            * This function closes value file of the pin.
             */
             virtual         ~BlackGPIO();
 
@@ -394,7 +407,8 @@ namespace BlackLib
             * If working mode is selected SecureMode, this function checks pin ready state by calling isReady() function.
             * If pin is not ready, function returns with BlackLib::GPIO_PIN_NOT_READY_STRING value. If working mode is
             * selected FastMode, ready state checking will skip. Then it reads specified file from path, where defined at
-            * BlackGPIO::valuePath variable. This file holds gpio pin value.
+            * BlackGPIO::valuePath variable. This file holds gpio pin value. This function is implemented on top of
+            * tryGetValue(), so value is read with one pread() call and converted to string after parsing.
             * @return @a string type GPIO pin value. If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_STRING
             * or if pin isn't ready, it returns BlackLib::GPIO_PIN_NOT_READY_STRING.
             *
@@ -417,7 +431,8 @@ namespace BlackLib
             * If working mode is selected SecureMode, this function checks pin ready state by calling isReady() function.
             * If pin is not ready, function returns with BlackLib::GPIO_PIN_NOT_READY_INT value. If working mode is
             * selected FastMode, ready state checking will skip. Then it reads specified file from path, where defined at
-            * BlackGPIO::valuePath variable. This file holds gpio pin value.
+            * BlackGPIO::valuePath variable. This file holds gpio pin value. File is opened once and read with one
+            * pread() call, value is parsed from stack buffer without stream library.
             * @return @a int type GPIO pin value. If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_INT
             * or if pin isn't ready, it returns BlackLib::GPIO_PIN_NOT_READY_INT.
             *
@@ -527,6 +542,34 @@ namespace BlackLib
             */
             bool            setValue(digitalValue v);
 
+            /*! @brief Reads value of gpio pin and returns it with an error code.
+            *
+            *  This function works like getNumericValue(), but errors are returned with the value instead of
+            *  sentinel numbers. fail() flags are updated too.
+            *
+            *  @return Value of the pin, or BlackLib::BlackError::NotReady, OpenFailed, ReadFailed or ParseFailed.
+            *
+            *  @par Example
+            *  @code{.cpp}
+            *   BlackLib::BlackGPIO myGpio(BlackLib::GPIO_30, BlackLib::input);
+            *
+            *   BlackLib::BlackResult<int> value = myGpio.tryGetValue();
+            *   if( value )
+            *   {
+            *       std::cout << "GPIO value: " << value.getValue() << std::endl;
+            *   }
+            * @endcode
+            */
+            BlackResult<int>  tryGetValue();
+
+            /*! @brief Sets value of GPIO pin and returns an error code.
+            *
+            *  @param [in] v        new pin value(enum)
+            *  @return BlackLib::BlackError::None if successful, else OutOfRange (input pin), NotReady,
+            *  OpenFailed or WriteFailed.
+            */
+            BlackResult<void> trySetValue(digitalValue v);
+
             /*! @brief Checks value of GPIO pin.
             *
             * This function calls getNumericValue() function and evaluates return value.
@@ -728,6 +771,18 @@ namespace BlackLib
             */
             bool            fail(BlackGPIO::flags f);
 
+            /*! @brief Exports I/O metrics of the object.
+            *
+            * Operations aren't measured until the returned metrics are registered with BlackMetrics::add().
+            * @return Pointer of BlackGPIO::ioMetrics variable.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackMetrics::add("my_gpio", myGpio.getMetrics());
+            * @endcode
+            */
+            BlackIoMetrics *getMetrics();
+
             /*! @brief Reads value of gpio pin as string type with ">>" operator.
             *
             * If working mode is selected SecureMode, this function checks pin ready state by calling isReady() function.
@@ -35,21 +35,27 @@
 namespace BlackLib
 {
 
-    BlackI2C::BlackI2C(i2cName i2c, unsigned int i2cDeviceAddress)
+    // names of the BlackI2C::flags values, they are used as error labels of metrics
+    static const char *const i2cFlagNames[BlackIoMetrics::flagCount] =
+    {
+        "openErr", "closeErr", "setSlaveErr", "readErr",
+        "writeErr"
+    };
+
+
+    BlackI2C::BlackI2C(i2cName i2c, unsigned int i2cDeviceAddress) : i2cErrors(this->getErrorsFromCore()), ioMetrics("i2c", i2cFlagNames)
     {
         this->i2cPortPath   = "/dev/i2c-" + tostr(static_cast<int>(i2c));
         this->i2cDevAddress = i2cDeviceAddress;
         this->i2cFD         = -1;
         this->isOpenFlag    = false;
 
-        this->i2cErrors     = new errorI2C( this->getErrorsFromCore() );
     }
 
 
     BlackI2C::~BlackI2C()
     {
         this->close();
-        delete this->i2cErrors;
     }
 
 
@@ -79,12 +85,12 @@ namespace BlackLib
     {
         if( ::ioctl(this->i2cFD, I2C_SLAVE, this->i2cDevAddress) < 0)
         {
-            this->i2cErrors->setSlaveError = true;
+            this->i2cErrors.setSlaveError = true;
             return false;
         }
         else
         {
-            this->i2cErrors->setSlaveError = false;
+            this->i2cErrors.setSlaveError = false;
             return true;
         }
     }
@@ -116,13 +122,13 @@ namespace BlackLib
         if( this->i2cFD < 0 )
         {
             this->isOpenFlag = false;
-            this->i2cErrors->openError = true;
+            this->i2cErrors.openError = true;
             return false;
         }
         else
         {
             this->isOpenFlag = true;
-            this->i2cErrors->openError = false;
+            this->i2cErrors.openError = false;
             this->setSlave();
             return true;
         }
@@ -132,12 +138,12 @@ namespace BlackLib
     {
         if( ::close(this->i2cFD) < 0 )
         {
-            this->i2cErrors->closeError = true;
+            this->i2cErrors.closeError = true;
             return false;
         }
         else
         {
-            this->i2cErrors->closeError = false;
+            this->i2cErrors.closeError = false;
             this->isOpenFlag = false;
             return true;
         }
@@ -150,84 +156,137 @@ namespace BlackLib
 
     bool    BlackI2C::writeByte(uint8_t registerAddr, uint8_t value)
     {
-        this->setSlave();
+        return this->tryWriteByte(registerAddr, value).isOk();
+    }
+
+    uint8_t BlackI2C::readByte(uint8_t registerAddr)
+    {
+        return this->tryReadByte(registerAddr).getValueOr(0x00);
+    }
+
+
+
+    bool    BlackI2C::writeWord(uint8_t registerAddr, uint16_t value)
+    {
+        return this->tryWriteWord(registerAddr, value).isOk();
+    }
+
+    uint16_t BlackI2C::readWord(uint8_t registerAddr)
+    {
+        return this->tryReadWord(registerAddr).getValueOr(0x0000);
+    }
+
+
+
+    BlackResult<void>     BlackI2C::tryWriteByte(uint8_t registerAddr, uint8_t value)
+    {
+        BLACKLIB_TRACE_SCOPE(TraceI2cWrite, this->i2cDevAddress, 1, this->i2cErrors.writeError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 1, writeErr, this->i2cErrors.writeError);
+
+        if( ! this->setSlave() )
+        {
+            this->i2cErrors.writeError = true;
+            return BlackResult<void>(BlackError::IoctlFailed, errno);
+        }
 
         i2c_smbus_data writeFromThis;
         writeFromThis.byte = value;
 
         if( this->useSmbusIOCTL(output, registerAddr, SMBUS_BYTE_DATA, writeFromThis) )
         {
-            this->i2cErrors->writeError = false;
-            return true;
+            this->i2cErrors.writeError = false;
+            return BlackResult<void>();
         }
         else
         {
-            this->i2cErrors->writeError = true;
-            return false;
+            this->i2cErrors.writeError = true;
+            return BlackResult<void>(BlackError::IoctlFailed, errno);
         }
     }
 
-    uint8_t BlackI2C::readByte(uint8_t registerAddr)
+    BlackResult<uint8_t>  BlackI2C::tryReadByte(uint8_t registerAddr)
     {
-        this->setSlave();
+        BLACKLIB_TRACE_SCOPE(TraceI2cRead, this->i2cDevAddress, 1, this->i2cErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 1, readErr, this->i2cErrors.readError);
+
+        if( ! this->setSlave() )
+        {
+            this->i2cErrors.readError = true;
+            return BlackResult<uint8_t>(BlackError::IoctlFailed, errno);
+        }
 
         i2c_smbus_data readToThis;
+
         if( this->useSmbusIOCTL(input, registerAddr, SMBUS_BYTE_DATA, readToThis) )
         {
-            this->i2cErrors->readError = false;
-            return readToThis.byte;
+            this->i2cErrors.readError = false;
+            return BlackResult<uint8_t>(readToThis.byte);
         }
         else
         {
-            this->i2cErrors->readError = true;
-            return 0x00;
+            this->i2cErrors.readError = true;
+            return BlackResult<uint8_t>(BlackError::IoctlFailed, errno);
         }
     }
 
-
-
-    bool    BlackI2C::writeWord(uint8_t registerAddr, uint16_t value)
+    BlackResult<void>     BlackI2C::tryWriteWord(uint8_t registerAddr, uint16_t value)
     {
-        this->setSlave();
+        BLACKLIB_TRACE_SCOPE(TraceI2cWrite, this->i2cDevAddress, 2, this->i2cErrors.writeError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 2, writeErr, this->i2cErrors.writeError);
+
+        if( ! this->setSlave() )
+        {
+            this->i2cErrors.writeError = true;
+            return BlackResult<void>(BlackError::IoctlFailed, errno);
+        }
 
         i2c_smbus_data writeFromThis;
         writeFromThis.word = value;
 
         if( this->useSmbusIOCTL(output, registerAddr, SMBUS_WORD_DATA, writeFromThis) )
         {
-            this->i2cErrors->writeError = false;
-            return true;
+            this->i2cErrors.writeError = false;
+            return BlackResult<void>();
         }
         else
         {
-            this->i2cErrors->writeError = true;
-            return false;
+            this->i2cErrors.writeError = true;
+            return BlackResult<void>(BlackError::IoctlFailed, errno);
         }
     }
 
-    uint16_t BlackI2C::readWord(uint8_t registerAddr)
+    BlackResult<uint16_t> BlackI2C::tryReadWord(uint8_t registerAddr)
     {
-        this->setSlave();
+        BLACKLIB_TRACE_SCOPE(TraceI2cRead, this->i2cDevAddress, 2, this->i2cErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 2, readErr, this->i2cErrors.readError);
+
+        if( ! this->setSlave() )
+        {
+            this->i2cErrors.readError = true;
+            return BlackResult<uint16_t>(BlackError::IoctlFailed, errno);
+        }
 
         i2c_smbus_data readToThis;
 
         if( this->useSmbusIOCTL(input, registerAddr, SMBUS_WORD_DATA, readToThis) )
         {
-            this->i2cErrors->readError = false;
-            return readToThis.word;
+            this->i2cErrors.readError = false;
+            return BlackResult<uint16_t>(readToThis.word);
         }
         else
         {
-            this->i2cErrors->readError = true;
-            return 0x0000;
+            this->i2cErrors.readError = true;
+            return BlackResult<uint16_t>(BlackError::IoctlFailed, errno);
         }
-
     }
 
 
 
     bool    BlackI2C::writeBlock(uint8_t registerAddr, uint8_t *writeBuffer, size_t bufferSize)
     {
+        BLACKLIB_TRACE_SCOPE(TraceI2cWrite, this->i2cDevAddress, bufferSize, this->i2cErrors.writeError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, bufferSize, writeErr, this->i2cErrors.writeError);
+
         this->setSlave();
 
         if( bufferSize > 32 )
@@ -244,18 +303,21 @@ namespace BlackLib
 
         if( this->useSmbusIOCTL(output, registerAddr, SMBUS_I2C_BLOCK_DATA, writeFromThis) )
         {
-            this->i2cErrors->writeError = false;
+            this->i2cErrors.writeError = false;
             return true;
         }
         else
         {
-            this->i2cErrors->writeError = true;
+            this->i2cErrors.writeError = true;
             return false;
         }
     }
 
     uint8_t BlackI2C::readBlock(uint8_t registerAddr, uint8_t *readBuffer, size_t bufferSize)
     {
+        BLACKLIB_TRACE_SCOPE(TraceI2cRead, this->i2cDevAddress, bufferSize, this->i2cErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, bufferSize, readErr, this->i2cErrors.readError);
+
         this->setSlave();
         if( bufferSize > 32 )
         {
@@ -267,13 +329,13 @@ namespace BlackLib
 
         if( this->useSmbusIOCTL(input, registerAddr, SMBUS_I2C_BLOCK_DATA, readToThis) )
         {
-            this->i2cErrors->readError = false;
+            this->i2cErrors.readError = false;
             memcpy(readBuffer, &(readToThis.block[1]), bufferSize);
             return readToThis.block[0];
         }
         else
         {
-            this->i2cErrors->readError = true;
+            this->i2cErrors.readError = true;
             return 0x00;
         }
 
@@ -283,30 +345,36 @@ namespace BlackLib
 
     bool    BlackI2C::writeLine(uint8_t *writeBuffer, size_t bufferSize)
     {
+        BLACKLIB_TRACE_SCOPE(TraceI2cWrite, this->i2cDevAddress, bufferSize, this->i2cErrors.writeError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, bufferSize, writeErr, this->i2cErrors.writeError);
+
         this->setSlave();
         if( ::write(this->i2cFD, writeBuffer, bufferSize) < 0 )
         {
-            this->i2cErrors->writeError = true;
+            this->i2cErrors.writeError = true;
             return false;
         }
         else
         {
-            this->i2cErrors->writeError = false;
+            this->i2cErrors.writeError = false;
             return true;
         }
     }
 
     bool    BlackI2C::readLine(uint8_t *readBuffer, size_t bufferSize)
     {
+        BLACKLIB_TRACE_SCOPE(TraceI2cRead, this->i2cDevAddress, bufferSize, this->i2cErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, bufferSize, readErr, this->i2cErrors.readError);
+
         this->setSlave();
         if( ::read(this->i2cFD, readBuffer, bufferSize) < 0 )
         {
-            this->i2cErrors->readError = true;
+            this->i2cErrors.readError = true;
             return false;
         }
         else
         {
-            this->i2cErrors->readError = false;
+            this->i2cErrors.readError = false;
             return true;
         }
     }
@@ -346,25 +414,30 @@ namespace BlackLib
 
     bool        BlackI2C::fail()
     {
-        return (this->i2cErrors->openError or
-                this->i2cErrors->closeError or
-                this->i2cErrors->setSlaveError or
-                this->i2cErrors->readError or
-                this->i2cErrors->writeError
+        return (this->i2cErrors.openError or
+                this->i2cErrors.closeError or
+                this->i2cErrors.setSlaveError or
+                this->i2cErrors.readError or
+                this->i2cErrors.writeError
                 );
     }
 
     bool        BlackI2C::fail(BlackI2C::flags f)
     {
-        if(f==openErr)          { return this->i2cErrors->openError;        }
-        if(f==closeErr)         { return this->i2cErrors->closeError;       }
-        if(f==setSlaveErr)      { return this->i2cErrors->setSlaveError;    }
-        if(f==readErr)          { return this->i2cErrors->readError;        }
-        if(f==writeErr)         { return this->i2cErrors->writeError;       }
+        if(f==openErr)          { return this->i2cErrors.openError;         }
+        if(f==closeErr)         { return this->i2cErrors.closeError;        }
+        if(f==setSlaveErr)      { return this->i2cErrors.setSlaveError;     }
+        if(f==readErr)          { return this->i2cErrors.readError;         }
+        if(f==writeErr)         { return this->i2cErrors.writeError;        }
 
         return true;
     }
 
+    BlackIoMetrics *BlackI2C::getMetrics()
+    {
+        return &(this->ioMetrics);
+    }
+
 
 
 
@@ -190,7 +190,8 @@ namespace BlackLib
     class BlackI2C : virtual private BlackCore
     {
         private:
-            errorI2C        *i2cErrors;                 /*!< @brief is used to hold the errors of BlackI2C class */
+            errorI2C         i2cErrors;                 /*!< @brief is used to hold the errors of BlackI2C class */
+            BlackIoMetrics   ioMetrics;                 /*!< @brief is used to hold the I/O metrics of BlackI2C class */
 
             unsigned int    i2cDevAddress;              /*!< @brief is used to hold the i2c's device address */
             int             i2cFD;                      /*!< @brief is used to hold the i2c's tty file's file descriptor */
@@ -267,7 +268,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackI2C class.
             *
-            * This function closes TTY file and deletes errorI2C struct pointer.
+            * This function closes TTY file.
             */
             virtual ~BlackI2C();
 
@@ -589,6 +590,30 @@ namespace BlackLib
             */
             uint16_t    readWord(uint8_t registerAddr);
 
+            /*! @brief Reads a byte from a register and returns it with an error code.
+            *
+            *  @return Read byte, or BlackLib::BlackError::IoctlFailed with errno.
+            */
+            BlackResult<uint8_t>  tryReadByte(uint8_t registerAddr);
+
+            /*! @brief Reads a word from a register and returns it with an error code.
+            *
+            *  @return Read word, or BlackLib::BlackError::IoctlFailed with errno.
+            */
+            BlackResult<uint16_t> tryReadWord(uint8_t registerAddr);
+
+            /*! @brief Writes a byte to a register and returns an error code.
+            *
+            *  @return BlackLib::BlackError::None if successful, else IoctlFailed with errno.
+            */
+            BlackResult<void>     tryWriteByte(uint8_t registerAddr, uint8_t value);
+
+            /*! @brief Writes a word to a register and returns an error code.
+            *
+            *  @return BlackLib::BlackError::None if successful, else IoctlFailed with errno.
+            */
+            BlackResult<void>     tryWriteWord(uint8_t registerAddr, uint16_t value);
+
             /*! @brief Read data block from i2c smbus.
             *
             * This function reads data block from i2c smbus. Register address of device sent
@@ -835,6 +860,18 @@ namespace BlackLib
             * @sa errorI2C
             */
             bool        fail(BlackI2C::flags f);
+
+            /*! @brief Exports I/O metrics of the object.
+            *
+            * Operations aren't measured until the returned metrics are registered with BlackMetrics::add().
+            * @return Pointer of BlackI2C::ioMetrics variable.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackMetrics::add("my_i2c", myI2c.getMetrics());
+            * @endcode
+            */
+            BlackIoMetrics *getMetrics();
     };
 
     // ########################################### BLACKI2C DECLARATION ENDS ############################################## //
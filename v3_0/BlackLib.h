@@ -32,16 +32,32 @@
 #define BLACKLIB_H_
 
 #include "BlackCore.h"
+#include "BlackBoard/BlackBoard.h"
 #include "BlackADC/BlackADC.h"
 #include "BlackPWM/BlackPWM.h"
+#include "BlackPWMGroup/BlackPWMGroup.h"
+#include "BlackPWMSequencer/BlackPWMSequencer.h"
 #include "BlackGPIO/BlackGPIO.h"
+#include "BlackPins/BlackPins.h"
 #include "BlackUART/BlackUART.h"
 #include "BlackSPI/BlackSPI.h"
 #include "BlackI2C/BlackI2C.h"
 #include "BlackThread/BlackThread.h"
+#include "BlackPeriodicThread/BlackPeriodicThread.h"
+#include "BlackThreadPool/BlackThreadPool.h"
 #include "BlackMutex/BlackMutex.h"
+#include "BlackSpinLock/BlackSpinLock.h"
+#include "BlackAdaptiveMutex/BlackAdaptiveMutex.h"
+#include "BlackRWLock/BlackRWLock.h"
+#include "BlackQueue/BlackQueue.h"
 #include "BlackDirectory/BlackDirectory.h"
+#include "BlackDirectoryWatcher/BlackDirectoryWatcher.h"
+#include "BlackProcess/BlackProcess.h"
+#include "BlackTrace/BlackTrace.h"
+#include "BlackMetrics/BlackMetrics.h"
 #include "BlackTime/BlackTime.h"
+#include "BlackStopwatch/BlackStopwatch.h"
+#include "BlackTimerWheel/BlackTimerWheel.h"
 
 
 #endif /* BLACKLIB_H_ */
@@ -0,0 +1,581 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackMetrics.h"
+
+
+
+namespace BlackLib
+{
+
+    // upper bounds of the latency buckets in nanoseconds, the last bucket is +Inf
+    static const uint64_t latencyBounds[BlackIoMetrics::latencyBucketCount - 1] =
+    {
+        10000, 25000, 50000, 100000, 250000, 500000,
+        1000000, 2500000, 5000000, 10000000, 25000000, 50000000, 100000000
+    };
+
+    static uint64_t getMonotonicTime()
+    {
+        timespec now;
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+    }
+
+    // names have no length limit, so only the value is formatted to a fixed buffer
+    static void appendSample(std::string &text, const char *metric, const std::string &labels, const char *value)
+    {
+        text += metric;
+        text += '{';
+        text += labels;
+        text += "} ";
+        text += value;
+        text += '\n';
+    }
+
+
+
+    // ########################################### BLACKIOMETRICS DEFINITION STARTS ########################################## //
+
+    BlackIoMetrics::BlackIoMetrics(const char *type, const char *const *names) : counterLock(BlackMutex::NonRecursive, BlackMutex::PriorityInheritance)
+    {
+        this->deviceType    = type;
+        this->flagNames     = names;
+        this->isRegistered  = false;
+        this->reset();
+    }
+
+    BlackIoMetrics::BlackIoMetrics(const BlackIoMetrics &other) : counterLock(BlackMutex::NonRecursive, BlackMutex::PriorityInheritance)
+    {
+        this->deviceType    = other.deviceType;
+        this->flagNames     = other.flagNames;
+        this->isRegistered  = false;
+        this->reset();
+    }
+
+    BlackIoMetrics& BlackIoMetrics::operator=(const BlackIoMetrics&)
+    {
+        return *this;
+    }
+
+    BlackIoMetrics::~BlackIoMetrics()
+    {
+        if( this->isRegistered )
+        {
+            BlackMetrics::remove(this);
+        }
+    }
+
+    void        BlackIoMetrics::record(metricsDirection direction, uint32_t byteCount, int flag, bool isFailed, uint64_t duration)
+    {
+        unsigned bucket = 0;
+        while( bucket < latencyBucketCount - 1 and duration > latencyBounds[bucket] )
+        {
+            bucket++;
+        }
+
+        BlackLockGuard<BlackMutex> guard(this->counterLock);
+
+        this->operations[direction]++;
+        this->latencyBuckets[bucket]++;
+        this->latencySum += duration;
+        this->latencyCount++;
+
+        if( isFailed )
+        {
+            this->consecutiveErrors++;
+            if( flag >= 0 and static_cast<unsigned>(flag) < flagCount )
+            {
+                this->errors[flag]++;
+            }
+        }
+        else
+        {
+            this->consecutiveErrors = 0;
+            this->bytes[direction] += byteCount;
+        }
+    }
+
+    bool        BlackIoMetrics::isEnabled() const
+    {
+        return this->isRegistered;
+    }
+
+    void        BlackIoMetrics::getSnapshot(BlackIoMetricsSnapshot &output)
+    {
+        {
+            BlackLockGuard<BlackMutex> registryGuard(BlackMetrics::registryMutex);
+            output.name             = this->name;
+        }
+
+        this->copyCounters(output);
+    }
+
+    void        BlackIoMetrics::copyCounters(BlackIoMetricsSnapshot &output)
+    {
+        BlackLockGuard<BlackMutex> guard(this->counterLock);
+
+        output.deviceType           = this->deviceType;
+        output.flagNames            = this->flagNames;
+        output.latencySum           = this->latencySum;
+        output.latencyCount         = this->latencyCount;
+        output.consecutiveErrors    = this->consecutiveErrors;
+
+        for( unsigned i = 0 ; i < 2 ; i++ )
+        {
+            output.operations[i]    = this->operations[i];
+            output.bytes[i]         = this->bytes[i];
+        }
+
+        for( unsigned i = 0 ; i < flagCount ; i++ )
+        {
+            output.errors[i]        = this->errors[i];
+        }
+
+        for( unsigned i = 0 ; i < latencyBucketCount ; i++ )
+        {
+            output.latencyBuckets[i] = this->latencyBuckets[i];
+        }
+    }
+
+    void        BlackIoMetrics::reset()
+    {
+        BlackLockGuard<BlackMutex> guard(this->counterLock);
+
+        memset(this->operations, 0, sizeof(this->operations));
+        memset(this->bytes, 0, sizeof(this->bytes));
+        memset(this->errors, 0, sizeof(this->errors));
+        memset(this->latencyBuckets, 0, sizeof(this->latencyBuckets));
+
+        this->latencySum        = 0;
+        this->latencyCount      = 0;
+        this->consecutiveErrors = 0;
+    }
+
+    uint64_t    BlackIoMetrics::getLatencyBound(unsigned bucket)
+    {
+        return (bucket < latencyBucketCount - 1) ? latencyBounds[bucket] : 0;
+    }
+
+    // ############################################ BLACKIOMETRICS DEFINITION ENDS ########################################### //
+
+
+
+
+
+
+
+
+
+
+    // ######################################### BLACKIOMETRICSSCOPE DEFINITION STARTS ####################################### //
+
+    BlackIoMetricsScope::BlackIoMetricsScope(BlackIoMetrics &ioMetrics, metricsDirection ioDirection, uint32_t bytes,
+                                             int errorFlag, const bool *errorFlagValue) : metrics(ioMetrics)
+    {
+        this->isActive      = ioMetrics.isEnabled();
+
+        if( this->isActive )
+        {
+            this->failFlag  = errorFlagValue;
+            this->byteCount = bytes;
+            this->flag      = errorFlag;
+            this->direction = ioDirection;
+            this->startTime = getMonotonicTime();
+        }
+    }
+
+    BlackIoMetricsScope::~BlackIoMetricsScope()
+    {
+        if( this->isActive )
+        {
+            this->metrics.record(this->direction, this->byteCount, this->flag, *this->failFlag,
+                                 getMonotonicTime() - this->startTime);
+        }
+    }
+
+    void        BlackIoMetricsScope::setBytes(uint32_t bytes)
+    {
+        this->byteCount = bytes;
+    }
+
+    // ########################################## BLACKIOMETRICSSCOPE DEFINITION ENDS ######################################## //
+
+
+
+
+
+
+
+
+
+
+    // ############################################ BLACKMETRICS DEFINITION STARTS ########################################### //
+
+    std::vector<BlackIoMetrics*>    BlackMetrics::devices;
+    std::map<std::string, double>   BlackMetrics::gauges;
+    BlackMutex                      BlackMetrics::registryMutex;
+    BlackMetrics::server           *BlackMetrics::serverThread  = NULL;
+    int                             BlackMetrics::serverFd      = -1;
+    std::string                     BlackMetrics::serverPath;
+
+
+    BlackMetrics::server::server(int socketFd)
+    {
+        this->listenFd = socketFd;
+    }
+
+    void BlackMetrics::server::onStartHandler()
+    {
+        pollfd listenPoll;
+        listenPoll.fd       = this->listenFd;
+        listenPoll.events   = POLLIN;
+
+        while( this->checkPoint() )
+        {
+            listenPoll.revents = 0;
+            if( ::poll(&listenPoll, 1, 100) <= 0 )
+            {
+                continue;
+            }
+
+            int clientFd = ::accept(this->listenFd, NULL, NULL);
+            if( clientFd < 0 )
+            {
+                continue;
+            }
+
+            std::string text = BlackMetrics::toText();
+            size_t written   = 0;
+
+            while( written < text.size() )
+            {
+                ssize_t writeSize = ::send(clientFd, text.data() + written, text.size() - written, MSG_NOSIGNAL);
+                if( writeSize < 0 and errno == EINTR ) { continue; }
+                if( writeSize <= 0 ) { break; }
+                written += static_cast<size_t>(writeSize);
+            }
+
+            ::close(clientFd);
+        }
+    }
+
+
+    std::string BlackMetrics::sanitize(const std::string &text)
+    {
+        std::string clean(text);
+
+        for( size_t i = 0 ; i < clean.size() ; i++ )
+        {
+            char c = clean[i];
+            if( not ((c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or (c >= '0' and c <= '9') or c == '_') )
+            {
+                clean[i] = '_';
+            }
+        }
+
+        if( clean.empty() or (clean[0] >= '0' and clean[0] <= '9') )
+        {
+            clean.insert(clean.begin(), '_');
+        }
+
+        return clean;
+    }
+
+    bool        BlackMetrics::add(const std::string &name, BlackIoMetrics *metrics)
+    {
+        if( metrics == NULL )
+        {
+            return false;
+        }
+
+        BlackLockGuard<BlackMutex> guard(registryMutex);
+
+        if( metrics->isRegistered )
+        {
+            return false;
+        }
+
+        metrics->name = sanitize(name);
+
+        devices.push_back(metrics);
+        __sync_synchronize();
+        metrics->isRegistered = true;
+        return true;
+    }
+
+    void        BlackMetrics::remove(BlackIoMetrics *metrics)
+    {
+        BlackLockGuard<BlackMutex> guard(registryMutex);
+
+        for( size_t i = 0 ; i < devices.size() ; i++ )
+        {
+            if( devices[i] == metrics )
+            {
+                devices.erase(devices.begin() + i);
+                break;
+            }
+        }
+
+        metrics->isRegistered = false;
+    }
+
+    void        BlackMetrics::setGauge(const std::string &name, double value)
+    {
+        BlackLockGuard<BlackMutex> guard(registryMutex);
+        gauges[sanitize(name)] = value;
+    }
+
+    void        BlackMetrics::removeGauge(const std::string &name)
+    {
+        BlackLockGuard<BlackMutex> guard(registryMutex);
+        gauges.erase(sanitize(name));
+    }
+
+    size_t      BlackMetrics::snapshot(std::vector<BlackIoMetricsSnapshot> &output)
+    {
+        BlackLockGuard<BlackMutex> guard(registryMutex);
+
+        size_t firstSize = output.size();
+        output.resize(firstSize + devices.size());
+
+        for( size_t i = 0 ; i < devices.size() ; i++ )
+        {
+            output[firstSize + i].name = devices[i]->name;
+            devices[i]->copyCounters(output[firstSize + i]);
+        }
+
+        return devices.size();
+    }
+
+    std::string BlackMetrics::toText()
+    {
+        std::vector<BlackIoMetricsSnapshot> snapshots;
+        std::map<std::string, double>       gaugeCopy;
+
+        snapshot(snapshots);
+        {
+            BlackLockGuard<BlackMutex> guard(registryMutex);
+            gaugeCopy = gauges;
+        }
+
+        static const char *directionNames[2] = { "read", "write" };
+
+        std::string text;
+        char        value[64];
+        text.reserve(1024 + snapshots.size() * 2048);
+
+        std::vector<std::string> labels(snapshots.size());
+        for( size_t i = 0 ; i < snapshots.size() ; i++ )
+        {
+            labels[i] = "device=\"" + snapshots[i].name + "\",type=\"" + snapshots[i].deviceType + "\"";
+        }
+
+        text += "# HELP blacklib_io_operations_total Peripheral operations.\n"
+                "# TYPE blacklib_io_operations_total counter\n";
+        for( size_t i = 0 ; i < snapshots.size() ; i++ )
+        {
+            for( unsigned d = 0 ; d < 2 ; d++ )
+            {
+                ::snprintf(value, sizeof(value), "%llu", static_cast<unsigned long long>(snapshots[i].operations[d]));
+                appendSample(text, "blacklib_io_operations_total", labels[i] + ",direction=\"" + directionNames[d] + "\"", value);
+            }
+        }
+
+        text += "# HELP blacklib_io_bytes_total Bytes transferred by successful peripheral operations.\n"
+                "# TYPE blacklib_io_bytes_total counter\n";
+        for( size_t i = 0 ; i < snapshots.size() ; i++ )
+        {
+            for( unsigned d = 0 ; d < 2 ; d++ )
+            {
+                ::snprintf(value, sizeof(value), "%llu", static_cast<unsigned long long>(snapshots[i].bytes[d]));
+                appendSample(text, "blacklib_io_bytes_total", labels[i] + ",direction=\"" + directionNames[d] + "\"", value);
+            }
+        }
+
+        text += "# HELP blacklib_io_errors_total Failed peripheral operations by error flag.\n"
+                "# TYPE blacklib_io_errors_total counter\n";
+        for( size_t i = 0 ; i < snapshots.size() ; i++ )
+        {
+            for( unsigned f = 0 ; f < BlackIoMetrics::flagCount ; f++ )
+            {
+                if( snapshots[i].flagNames == NULL or snapshots[i].flagNames[f] == NULL )
+                {
+                    continue;
+                }
+
+                ::snprintf(value, sizeof(value), "%llu", static_cast<unsigned long long>(snapshots[i].errors[f]));
+                appendSample(text, "blacklib_io_errors_total", labels[i] + ",flag=\"" + snapshots[i].flagNames[f] + "\"", value);
+            }
+        }
+
+        text += "# HELP blacklib_io_consecutive_errors Failed peripheral operations since the last success.\n"
+                "# TYPE blacklib_io_consecutive_errors gauge\n";
+        for( size_t i = 0 ; i < snapshots.size() ; i++ )
+        {
+            ::snprintf(value, sizeof(value), "%u", snapshots[i].consecutiveErrors);
+            appendSample(text, "blacklib_io_consecutive_errors", labels[i], value);
+        }
+
+        text += "# HELP blacklib_io_latency_seconds Peripheral operation latency.\n"
+                "# TYPE blacklib_io_latency_seconds histogram\n";
+        for( size_t i = 0 ; i < snapshots.size() ; i++ )
+        {
+            uint64_t cumulative = 0;
+
+            for( unsigned b = 0 ; b < BlackIoMetrics::latencyBucketCount ; b++ )
+            {
+                cumulative += snapshots[i].latencyBuckets[b];
+
+                char bound[32] = "+Inf";
+                if( b < BlackIoMetrics::latencyBucketCount - 1 )
+                {
+                    ::snprintf(bound, sizeof(bound), "%g", static_cast<double>(BlackIoMetrics::getLatencyBound(b)) / 1e9);
+                }
+
+                ::snprintf(value, sizeof(value), "%llu", static_cast<unsigned long long>(cumulative));
+                appendSample(text, "blacklib_io_latency_seconds_bucket", labels[i] + ",le=\"" + bound + "\"", value);
+            }
+
+            ::snprintf(value, sizeof(value), "%.9f", static_cast<double>(snapshots[i].latencySum) / 1e9);
+            appendSample(text, "blacklib_io_latency_seconds_sum", labels[i], value);
+
+            ::snprintf(value, sizeof(value), "%llu", static_cast<unsigned long long>(snapshots[i].latencyCount));
+            appendSample(text, "blacklib_io_latency_seconds_count", labels[i], value);
+        }
+
+        std::map<std::string, double>::const_iterator gauge = gaugeCopy.begin();
+        for( ; gauge != gaugeCopy.end() ; ++gauge )
+        {
+            ::snprintf(value, sizeof(value), "%.17g", gauge->second);
+
+            text += "# TYPE " + gauge->first + " gauge\n";
+            text += gauge->first + " " + value + "\n";
+        }
+
+        return text;
+    }
+
+    bool        BlackMetrics::writeToFile(const std::string &path)
+    {
+        std::string text        = toText();
+        std::string tempPath    = path + ".tmp";
+
+        int fileFd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if( fileFd < 0 )
+        {
+            return false;
+        }
+
+        size_t written = 0;
+        while( written < text.size() )
+        {
+            ssize_t writeSize = ::write(fileFd, text.data() + written, text.size() - written);
+            if( writeSize < 0 and errno == EINTR ) { continue; }
+            if( writeSize <= 0 ) { break; }
+            written += static_cast<size_t>(writeSize);
+        }
+
+        if( ::close(fileFd) != 0 or written != text.size() )
+        {
+            ::unlink(tempPath.c_str());
+            return false;
+        }
+
+        return (::rename(tempPath.c_str(), path.c_str()) == 0);
+    }
+
+    bool        BlackMetrics::startServer(const std::string &socketPath, BlackThread::priority tp)
+    {
+        stopServer();
+
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if( socketPath.size() >= sizeof(address.sun_path) )
+        {
+            return false;
+        }
+        memcpy(address.sun_path, socketPath.c_str(), socketPath.size());
+
+        int socketFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if( socketFd < 0 )
+        {
+            return false;
+        }
+
+        ::unlink(socketPath.c_str());
+
+        if( ::bind(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 or ::listen(socketFd, 4) < 0 )
+        {
+            ::close(socketFd);
+            return false;
+        }
+
+        serverFd        = socketFd;
+        serverPath      = socketPath;
+        serverThread    = new server(socketFd);
+        serverThread->setPriority(tp);
+        serverThread->setName("BlackMetrics");
+        serverThread->run();
+
+        if( not serverThread->isRunning() )
+        {
+            stopServer();
+            return false;
+        }
+
+        return true;
+    }
+
+    void        BlackMetrics::stopServer()
+    {
+        if( serverThread != NULL )
+        {
+            serverThread->requestStop();
+            WAIT_THREAD_FINISH(serverThread)
+
+            delete serverThread;
+            serverThread = NULL;
+        }
+
+        if( serverFd >= 0 )
+        {
+            ::close(serverFd);
+            ::unlink(serverPath.c_str());
+            serverFd = -1;
+        }
+    }
+
+    // ############################################# BLACKMETRICS DEFINITION ENDS ############################################ //
+
+} /* namespace BlackLib */
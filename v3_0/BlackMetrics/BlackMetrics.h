@@ -0,0 +1,366 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKMETRICS_H_
+#define BLACKMETRICS_H_
+
+#include "../BlackMutex/BlackMutex.h"
+#include "../BlackThread/BlackThread.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+
+/*! @brief Peripheral metrics can be compiled out with this macro.
+*
+*    Metrics are compiled in by default and they cost one flag check per call until the object is
+*    registered to BlackMetrics. Add @b -DBLACKLIB_NO_METRICS to the compiler flags to remove even that.
+*/
+#ifndef BLACKLIB_NO_METRICS
+    #define BLACKLIB_METRICS_SCOPE(metrics, direction, bytes, flag, failFlag)   BlackLib::BlackIoMetricsScope blackMetricsScope((metrics), (direction), (bytes), (flag), &(failFlag))
+    #define BLACKLIB_METRICS_BYTES(bytes)                                       blackMetricsScope.setBytes(bytes)
+#else
+    #define BLACKLIB_METRICS_SCOPE(metrics, direction, bytes, flag, failFlag)   do {} while(0)
+    #define BLACKLIB_METRICS_BYTES(bytes)                                       do {} while(0)
+#endif
+
+
+
+namespace BlackLib
+{
+
+    /*!
+     * This enum is used to separate the read and write operations in metrics.
+     */
+    enum metricsDirection   {   MetricsRead         = 0,    /*!< enumeration for @a read operations */
+                                MetricsWrite        = 1     /*!< enumeration for @a write operations */
+                            };
+
+
+
+    // ####################################### BLACKIOMETRICSSNAPSHOT DECLARATION STARTS ##################################### //
+
+    /*! @brief Holds a copy of the metrics of one peripheral object.
+    */
+    struct BlackIoMetricsSnapshot
+    {
+        std::string         name;                   /*!< @brief is used to hold the registered name of the object */
+        const char         *deviceType;             /*!< @brief is used to hold the peripheral type (gpio, adc, ...) */
+        const char *const  *flagNames;              /*!< @brief is used to hold the names of the error flags, NULL for unused ones */
+        uint64_t            operations[2];          /*!< @brief is used to hold the operation counts by metricsDirection */
+        uint64_t            bytes[2];               /*!< @brief is used to hold the transferred byte counts by metricsDirection */
+        uint64_t            errors[16];             /*!< @brief is used to hold the failed operation counts by the flags enum of the class */
+        uint64_t            latencyBuckets[14];     /*!< @brief is used to hold the operation counts by latency bucket, not cumulative */
+        uint64_t            latencySum;             /*!< @brief is used to hold the total latency in nanoseconds */
+        uint64_t            latencyCount;           /*!< @brief is used to hold the measured operation count */
+        uint32_t            consecutiveErrors;      /*!< @brief is used to hold the failed operation count since the last success */
+    };
+
+    // ######################################## BLACKIOMETRICSSNAPSHOT DECLARATION ENDS ###################################### //
+
+
+
+
+
+    // ########################################### BLACKIOMETRICS DECLARATION STARTS ######################################### //
+
+    /*! @brief Holds the I/O metrics of one peripheral object.
+    *
+    *    BlackGPIO, BlackADC, BlackPWM, BlackSPI, BlackI2C and BlackUART have one of this class and
+    *    export it with their getMetrics() function. Metrics aren't collected until the object is
+    *    registered with BlackMetrics::add(). Copies of a peripheral object start with empty and
+    *    unregistered metrics.
+    */
+    class BlackIoMetrics
+    {
+        friend class BlackMetrics;
+        friend class BlackIoMetricsScope;
+
+        public:
+            static const unsigned   flagCount           = 16;   /*!< @brief is used to hold the error counter count */
+            static const unsigned   latencyBucketCount  = 14;   /*!< @brief is used to hold the latency bucket count, last one is +Inf */
+
+        private:
+            BlackMutex          counterLock;            /*!< @brief is used to protect the counters, it is a priority inheritance mutex */
+            volatile bool       isRegistered;           /*!< @brief is used to hold the object is registered to BlackMetrics or not */
+            const char         *deviceType;             /*!< @brief is used to hold the peripheral type */
+            const char *const  *flagNames;              /*!< @brief is used to hold the names of the error flags */
+            std::string         name;                   /*!< @brief is used to hold the registered name, it is protected by the registry mutex of BlackMetrics */
+            uint64_t            operations[2];          /*!< @brief is used to hold the operation counts */
+            uint64_t            bytes[2];               /*!< @brief is used to hold the transferred byte counts */
+            uint64_t            errors[flagCount];      /*!< @brief is used to hold the failed operation counts */
+            uint64_t            latencyBuckets[latencyBucketCount]; /*!< @brief is used to hold the latency histogram */
+            uint64_t            latencySum;             /*!< @brief is used to hold the total latency in nanoseconds */
+            uint64_t            latencyCount;           /*!< @brief is used to hold the measured operation count */
+            uint32_t            consecutiveErrors;      /*!< @brief is used to hold the failed operation count since the last success */
+
+            /*! @brief Adds one finished operation to the counters.
+            */
+            void                record(metricsDirection direction, uint32_t byteCount, int flag, bool isFailed, uint64_t duration);
+
+            /*! @brief Copies the counters, except the name, to the snapshot.
+            *
+            *  The name is protected by the registry mutex of BlackMetrics, so it is copied by the caller. Nothing
+            *  is allocated while the counter lock is held.
+            */
+            void                copyCounters(BlackIoMetricsSnapshot &output);
+
+        public:
+
+            /*! @brief Constructor of BlackIoMetrics class.
+            *
+            *  @param [in] type         peripheral type, it must be a string literal
+            *  @param [in] names        error flag names indexed by the flags enum of the class, it must be a
+            *                           static array with BlackIoMetrics::flagCount elements
+            */
+                                BlackIoMetrics(const char *type, const char *const *names);
+
+            /*! @brief Copy constructor of BlackIoMetrics class, it copies the type only.
+            */
+                                BlackIoMetrics(const BlackIoMetrics &other);
+
+            /*! @brief Assignment operator of BlackIoMetrics class, it doesn't change anything.
+            *
+            *  Metrics belong to the object, so they aren't taken from the assigned object.
+            */
+            BlackIoMetrics&     operator=(const BlackIoMetrics&);
+
+            /*! @brief Destructor of BlackIoMetrics class.
+            *
+            *  This function removes the object from BlackMetrics, if it is registered.
+            */
+                                ~BlackIoMetrics();
+
+            /*! @brief Checks the object is registered, so operations are measured.
+            */
+            bool                isEnabled() const;
+
+            /*! @brief Copies the current counters.
+            */
+            void                getSnapshot(BlackIoMetricsSnapshot &output);
+
+            /*! @brief Sets all counters to zero.
+            */
+            void                reset();
+
+            /*! @brief Returns the upper bound of a latency bucket in nanoseconds, 0 for the last (+Inf) bucket.
+            */
+            static uint64_t     getLatencyBound(unsigned bucket);
+    };
+
+    // ############################################ BLACKIOMETRICS DECLARATION ENDS ########################################## //
+
+
+
+
+
+    // ######################################### BLACKIOMETRICSSCOPE DECLARATION STARTS ###################################### //
+
+    /*! @brief Measures the enclosing call when it goes out of scope.
+    *
+    *    This class isn't used directly, BLACKLIB_METRICS_SCOPE macro creates it at the beginning of the
+    *    measured function. The result of the call is taken from the fail flag of the peripheral when the
+    *    scope ends.
+    */
+    class BlackIoMetricsScope
+    {
+        private:
+            BlackIoMetrics     &metrics;                /*!< @brief is used to hold the metrics of the peripheral */
+            const bool         *failFlag;               /*!< @brief is used to hold the error flag of the measured call */
+            uint64_t            startTime;              /*!< @brief is used to hold the monotonic start time in nanoseconds */
+            uint32_t            byteCount;              /*!< @brief is used to hold the transferred byte count */
+            int                 flag;                   /*!< @brief is used to hold the flags enum value of the error flag */
+            metricsDirection    direction;              /*!< @brief is used to hold the operation direction */
+            bool                isActive;               /*!< @brief is used to hold the metrics are enabled at scope start */
+
+            BlackIoMetricsScope(const BlackIoMetricsScope&);
+            BlackIoMetricsScope& operator=(const BlackIoMetricsScope&);
+
+        public:
+
+            /*! @brief Constructor of BlackIoMetricsScope class.
+            *
+            *  @param [in] ioMetrics        metrics of the peripheral
+            *  @param [in] ioDirection      operation direction
+            *  @param [in] bytes            requested byte count
+            *  @param [in] errorFlag        flags enum value which is counted if the call fails
+            *  @param [in] errorFlagValue   error flag which the measured call sets
+            */
+                                BlackIoMetricsScope(BlackIoMetrics &ioMetrics, metricsDirection ioDirection, uint32_t bytes,
+                                                    int errorFlag, const bool *errorFlagValue);
+
+            /*! @brief Destructor of BlackIoMetricsScope class.
+            *
+            *  This function calculates the latency and updates the counters.
+            */
+                                ~BlackIoMetricsScope();
+
+            /*! @brief Changes the byte count with the transferred byte count.
+            */
+            void                setBytes(uint32_t bytes);
+    };
+
+    // ########################################## BLACKIOMETRICSSCOPE DECLARATION ENDS ####################################### //
+
+
+
+
+
+    // ############################################ BLACKMETRICS DECLARATION STARTS ########################################## //
+
+    /*! @brief Registry of peripheral metrics with Prometheus text exposition.
+    *
+    *    Registered peripheral objects count their operations, transferred bytes and failures by
+    *    error flag, keep the count of consecutive failures and a latency histogram. Application
+    *    values can be added as gauges. The registry can be copied with snapshot(), written to a
+    *    file in Prometheus text format (for node_exporter's textfile collector) or served from a
+    *    Unix domain socket. Every connection to the socket receives the current text and is closed.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   BlackLib::BlackI2C  sensor(BlackLib::I2C_1, 0x48);
+    *   BlackLib::BlackADC  battery(BlackLib::AIN0);
+    *
+    *   BlackLib::BlackMetrics::add("temp_sensor", sensor.getMetrics());
+    *   BlackLib::BlackMetrics::add("battery", battery.getMetrics());
+    *   BlackLib::BlackMetrics::startServer("/run/blacklib-metrics.sock");
+    *
+    *   while( true )
+    *   {
+    *       BlackLib::BlackMetrics::setGauge("battery_millivolts", battery.getNumericValue());
+    *       sensor.readWord(0x00);
+    *       sleep(1);
+    *   }
+    *
+    *   // shell: socat - UNIX-CONNECT:/run/blacklib-metrics.sock
+    * @endcode
+    */
+    class BlackMetrics
+    {
+        friend class BlackIoMetrics;
+
+        private:
+
+            /*! @brief Internal socket server thread.
+            */
+            class server : public BlackThread
+            {
+                public:
+                                        server(int socketFd);
+
+                private:
+                    int                 listenFd;           /*!< @brief is used to hold the listening socket */
+
+                    void                onStartHandler();
+            };
+
+            static std::vector<BlackIoMetrics*>     devices;        /*!< @brief is used to hold the registered peripheral metrics */
+            static std::map<std::string, double>    gauges;         /*!< @brief is used to hold the application gauges */
+            static BlackMutex                       registryMutex;  /*!< @brief is used to protect the registry */
+            static server                          *serverThread;   /*!< @brief is used to hold the socket server */
+            static int                              serverFd;       /*!< @brief is used to hold the listening socket */
+            static std::string                      serverPath;     /*!< @brief is used to hold the socket path */
+
+            /*! @brief Removes characters which can't be used in metric names and label values.
+            */
+            static std::string                      sanitize(const std::string &text);
+
+
+        public:
+
+            /*! @brief Registers peripheral metrics, so its operations are measured.
+            *
+            *  @param [in] name     name which is used as @a device label
+            *  @param [in] metrics  metrics of the peripheral, taken from its getMetrics() function
+            *  @return False if metrics is NULL or it is registered already, else true.
+            */
+            static bool                             add(const std::string &name, BlackIoMetrics *metrics);
+
+            /*! @brief Removes peripheral metrics from the registry, its counters are kept.
+            */
+            static void                             remove(BlackIoMetrics *metrics);
+
+            /*! @brief Sets an application gauge, it is created at first call.
+            */
+            static void                             setGauge(const std::string &name, double value);
+
+            /*! @brief Removes an application gauge.
+            */
+            static void                             removeGauge(const std::string &name);
+
+            /*! @brief Copies the metrics of all registered peripherals.
+            *
+            *  @return Copied peripheral count.
+            */
+            static size_t                           snapshot(std::vector<BlackIoMetricsSnapshot> &output);
+
+            /*! @brief Creates Prometheus text exposition of all metrics.
+            */
+            static std::string                      toText();
+
+            /*! @brief Writes Prometheus text exposition to a file.
+            *
+            *  The text is written to a temporary file first and it is renamed, so readers never see a
+            *  partial file.
+            *  @return True if the file is written, else false.
+            */
+            static bool                             writeToFile(const std::string &path);
+
+            /*! @brief Serves Prometheus text exposition from a Unix domain socket.
+            *
+            *  An old socket file at the path is removed. The server runs in an internal thread.
+            *  @return True if the server is running, else false.
+            */
+            static bool                             startServer(const std::string &socketPath,
+                                                                BlackThread::priority tp = BlackThread::PriorityLOW);
+
+            /*! @brief Stops the socket server and removes the socket file.
+            */
+            static void                             stopServer();
+    };
+
+    // ############################################# BLACKMETRICS DECLARATION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKMETRICS_H_ */
@@ -10,10 +10,15 @@
 namespace BlackLib
 {
 
-    BlackMutex::BlackMutex(BlackMutex::mutexMode mm)
+    BlackMutex::BlackMutex(BlackMutex::mutexMode mm, BlackMutex::mutexProtocol mp)
     {
-        this->lockCount = 0;
-        this->mode      = mm;
+        this->lockCount             = 0;
+        this->mode                  = mm;
+        this->isInheritance         = false;
+        this->isProfilingEnabled    = false;
+        this->acquireTime           = 0;
+        this->statisticsSequence    = 0;
+        this->isResetRequested      = false;
 
         pthread_mutexattr_t tempMutexAttr;
         pthread_mutexattr_init(&tempMutexAttr);
@@ -29,6 +34,13 @@ namespace BlackLib
 
         pthread_mutexattr_setpshared(&tempMutexAttr, PTHREAD_PROCESS_PRIVATE);
 
+        #ifdef _POSIX_THREAD_PRIO_INHERIT
+            if( mp == BlackMutex::PriorityInheritance )
+            {
+                this->isInheritance = (pthread_mutexattr_setprotocol(&tempMutexAttr, PTHREAD_PRIO_INHERIT) == 0);
+            }
+        #endif
+
         pthread_mutex_init( &(this->mutex), &tempMutexAttr);
         pthread_mutexattr_destroy(&tempMutexAttr);
     }
@@ -36,11 +48,33 @@ namespace BlackLib
 
     BlackMutex::~BlackMutex()
     {
+        this->disableProfiling();
         pthread_mutex_destroy( &(this->mutex) );
     }
 
     bool BlackMutex::lock()
     {
+        if( this->isProfilingEnabled )
+        {
+            uint64_t waitStart   = BlackMutex::monotonicTime();
+            bool     isContended = false;
+            int      result      = pthread_mutex_trylock( &(this->mutex) );
+
+            if( result == EBUSY )
+            {
+                isContended = true;
+                result      = pthread_mutex_lock( &(this->mutex) );
+            }
+
+            if( result == 0 )
+            {
+                ++(this->lockCount);
+                this->recordAcquire(waitStart, isContended);
+            }
+
+            return (result == 0);
+        }
+
         bool isSuccess = ( pthread_mutex_lock( &(this->mutex) ) == 0);
 
         if( isSuccess ){ ++(this->lockCount); }
@@ -50,13 +84,23 @@ namespace BlackLib
 
     bool BlackMutex::timedLock(unsigned int sec)
     {
+        // pthread_mutex_timedlock() wants an absolute CLOCK_REALTIME time
         timespec until;
-        until.tv_sec  = sec;
-        until.tv_nsec = 0;
+        clock_gettime(CLOCK_REALTIME, &until);
+        until.tv_sec += sec;
 
+        uint64_t waitStart = this->isProfilingEnabled ? BlackMutex::monotonicTime() : 0;
         bool isSuccess = ( pthread_mutex_timedlock( &(this->mutex), &until) == 0);
 
-        if( isSuccess ){ ++(this->lockCount); }
+        if( isSuccess )
+        {
+            ++(this->lockCount);
+
+            if( this->isProfilingEnabled )
+            {
+                this->recordAcquire(waitStart, (BlackMutex::monotonicTime() - waitStart) > 1000);
+            }
+        }
 
         return isSuccess;
     }
@@ -65,16 +109,41 @@ namespace BlackLib
     {
         bool isSuccess = ( pthread_mutex_trylock( &(this->mutex) ) == 0);
 
-        if( isSuccess ){ ++(this->lockCount); }
+        if( isSuccess )
+        {
+            ++(this->lockCount);
+
+            if( this->isProfilingEnabled )
+            {
+                this->recordAcquire(BlackMutex::monotonicTime(), false);
+            }
+        }
 
         return isSuccess;
     }
 
     bool BlackMutex::unlock()
     {
+        // count is changed while the mutex is still held, so the owner is the only writer
+        if( this->lockCount == 0 )
+        {
+            return false;
+        }
+
+        if( this->isProfilingEnabled and this->lockCount == 1 )
+        {
+            uint64_t holdTime = BlackMutex::monotonicTime() - this->acquireTime;
+
+            this->beginStatisticsUpdate();
+            this->statistics.totalHoldTime += holdTime;
+            if( holdTime > this->statistics.maxHoldTime ) { this->statistics.maxHoldTime = holdTime; }
+            this->endStatisticsUpdate();
+        }
+
+        --(this->lockCount);
         bool isSuccess = ( pthread_mutex_unlock( &(this->mutex) ) == 0);
 
-        if( isSuccess ){ --(this->lockCount); }
+        if( ! isSuccess ){ ++(this->lockCount); }
 
         return isSuccess;
     }
@@ -90,10 +159,294 @@ namespace BlackLib
         return (this->mode == BlackMutex::Recursive );
     }
 
+    bool BlackMutex::isPriorityInheritance()
+    {
+        return this->isInheritance;
+    }
+
     unsigned int BlackMutex::getLockedCount()
     {
         return this->lockCount;
     }
 
+    void BlackMutex::enableProfiling(const std::string &name)
+    {
+        // registry reads the name under its list lock
+        pthread_mutex_lock( BlackMutexRegistry::getListMutex() );
+        this->statistics.name = name;
+        pthread_mutex_unlock( BlackMutexRegistry::getListMutex() );
+
+        if( not this->isProfilingEnabled )
+        {
+            this->isProfilingEnabled = true;
+            BlackMutexRegistry::add(this);
+        }
+    }
+
+    void BlackMutex::disableProfiling()
+    {
+        if( this->isProfilingEnabled )
+        {
+            this->isProfilingEnabled = false;
+            BlackMutexRegistry::remove(this);
+        }
+    }
+
+    bool BlackMutex::isProfiling()
+    {
+        return this->isProfilingEnabled;
+    }
+
+    BlackMutexStats BlackMutex::getStatistics()
+    {
+        BlackMutexStats copy;
+
+        pthread_mutex_lock( BlackMutexRegistry::getListMutex() );
+        copy.name = this->statistics.name;
+        pthread_mutex_unlock( BlackMutexRegistry::getListMutex() );
+
+        this->copyStatistics(copy);
+        return copy;
+    }
+
+    void BlackMutex::resetStatistics()
+    {
+        // only the owner writes the report, so the owner clears it at its next update
+        this->isResetRequested = true;
+    }
+
+    void BlackMutex::recordAcquire(uint64_t waitStart, bool isContended)
+    {
+        uint64_t now        = BlackMutex::monotonicTime();
+        uint64_t waitTime   = now - waitStart;
+
+        // nested locks of a recursive mutex don't start a new hold period
+        if( this->lockCount == 1 )
+        {
+            this->acquireTime = now;
+        }
+
+        this->beginStatisticsUpdate();
+
+        this->statistics.acquisitions  += 1;
+        this->statistics.totalWaitTime += waitTime;
+
+        if( isContended )                               { this->statistics.contentions += 1; }
+        if( waitTime > this->statistics.maxWaitTime )   { this->statistics.maxWaitTime = waitTime; }
+
+        this->endStatisticsUpdate();
+    }
+
+    void BlackMutex::beginStatisticsUpdate()
+    {
+        this->statisticsSequence = this->statisticsSequence + 1;
+        __sync_synchronize();
+
+        if( this->isResetRequested )
+        {
+            this->isResetRequested              = false;
+            this->statistics.acquisitions       = 0;
+            this->statistics.contentions        = 0;
+            this->statistics.totalWaitTime      = 0;
+            this->statistics.maxWaitTime        = 0;
+            this->statistics.totalHoldTime      = 0;
+            this->statistics.maxHoldTime        = 0;
+        }
+    }
+
+    void BlackMutex::endStatisticsUpdate()
+    {
+        __sync_synchronize();
+        this->statisticsSequence = this->statisticsSequence + 1;
+    }
+
+    void BlackMutex::copyStatistics(BlackMutexStats &output)
+    {
+        while( true )
+        {
+            unsigned int sequence = this->statisticsSequence;
+            __sync_synchronize();
+
+            output.acquisitions     = this->statistics.acquisitions;
+            output.contentions      = this->statistics.contentions;
+            output.totalWaitTime    = this->statistics.totalWaitTime;
+            output.maxWaitTime      = this->statistics.maxWaitTime;
+            output.totalHoldTime    = this->statistics.totalHoldTime;
+            output.maxHoldTime      = this->statistics.maxHoldTime;
+
+            __sync_synchronize();
+            if( (sequence & 1) == 0 and sequence == this->statisticsSequence )
+            {
+                break;
+            }
+
+            // writer can be a lower priority thread on a single core, so sleep instead of spinning
+            timespec retryDelay;
+            retryDelay.tv_sec  = 0;
+            retryDelay.tv_nsec = 10000;
+            nanosleep(&retryDelay, NULL);
+        }
+
+        if( this->isResetRequested )
+        {
+            std::string name = output.name;
+            output          = BlackMutexStats();
+            output.name     = name;
+        }
+    }
+
+    uint64_t BlackMutex::monotonicTime()
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+    }
+
+
+
+
+    std::vector<BlackMutex*>& BlackMutexRegistry::getList()
+    {
+        static std::vector<BlackMutex*> mutexList;
+        return mutexList;
+    }
+
+    pthread_mutex_t* BlackMutexRegistry::getListMutex()
+    {
+        static pthread_mutex_t listMutex = PTHREAD_MUTEX_INITIALIZER;
+        return &listMutex;
+    }
+
+    void BlackMutexRegistry::add(BlackMutex *mutex)
+    {
+        pthread_mutex_lock( BlackMutexRegistry::getListMutex() );
+        BlackMutexRegistry::getList().push_back(mutex);
+        pthread_mutex_unlock( BlackMutexRegistry::getListMutex() );
+    }
+
+    void BlackMutexRegistry::remove(BlackMutex *mutex)
+    {
+        pthread_mutex_lock( BlackMutexRegistry::getListMutex() );
+
+        std::vector<BlackMutex*> &mutexList = BlackMutexRegistry::getList();
+        for( size_t i = 0 ; i < mutexList.size() ; i++ )
+        {
+            if( mutexList[i] == mutex )
+            {
+                mutexList.erase(mutexList.begin() + i);
+                break;
+            }
+        }
+
+        pthread_mutex_unlock( BlackMutexRegistry::getListMutex() );
+    }
+
+    std::vector<BlackMutexStats> BlackMutexRegistry::getAll()
+    {
+        std::vector<BlackMutexStats> reports;
+
+        pthread_mutex_lock( BlackMutexRegistry::getListMutex() );
+
+        // counters are copied without locking the user mutexes, so a dump never waits for a held
+        // mutex. List lock is kept during the copy, because it keeps the mutexes from being destroyed.
+        std::vector<BlackMutex*> &mutexList = BlackMutexRegistry::getList();
+        reports.resize(mutexList.size());
+        for( size_t i = 0 ; i < mutexList.size() ; i++ )
+        {
+            reports[i].name = mutexList[i]->statistics.name;
+            mutexList[i]->copyStatistics(reports[i]);
+        }
+
+        pthread_mutex_unlock( BlackMutexRegistry::getListMutex() );
+
+        return reports;
+    }
+
+    void BlackMutexRegistry::resetAll()
+    {
+        pthread_mutex_lock( BlackMutexRegistry::getListMutex() );
+
+        std::vector<BlackMutex*> &mutexList = BlackMutexRegistry::getList();
+        for( size_t i = 0 ; i < mutexList.size() ; i++ )
+        {
+            mutexList[i]->isResetRequested = true;
+        }
+
+        pthread_mutex_unlock( BlackMutexRegistry::getListMutex() );
+    }
+
+    std::string BlackMutexRegistry::dumpText()
+    {
+        std::vector<BlackMutexStats> reports = BlackMutexRegistry::getAll();
+        std::ostringstream output;
+
+        output.setf(std::ios::fixed);
+        output.precision(3);
+
+        output.width(20); output << std::left  << "name";
+        output.width(11); output << std::right << "acquired";
+        output.width(12); output << "contended";
+        output.width(15); output << "wait avg(us)";
+        output.width(15); output << "wait max(us)";
+        output.width(15); output << "hold avg(us)";
+        output.width(15); output << "hold max(us)";
+        output << "\n";
+
+        for( size_t i = 0 ; i < reports.size() ; i++ )
+        {
+            const BlackMutexStats &report = reports[i];
+            double count = (report.acquisitions > 0) ? static_cast<double>(report.acquisitions) : 1.0;
+
+            output.width(20); output << std::left  << report.name;
+            output.width(11); output << std::right << report.acquisitions;
+            output.width(12); output << report.contentions;
+            output.width(15); output << (report.totalWaitTime / count) / 1000.0;
+            output.width(15); output << report.maxWaitTime / 1000.0;
+            output.width(15); output << (report.totalHoldTime / count) / 1000.0;
+            output.width(15); output << report.maxHoldTime / 1000.0;
+            output << "\n";
+        }
+
+        return output.str();
+    }
+
+    std::string BlackMutexRegistry::dumpJson()
+    {
+        std::vector<BlackMutexStats> reports = BlackMutexRegistry::getAll();
+        std::ostringstream output;
+
+        output << "[";
+
+        for( size_t i = 0 ; i < reports.size() ; i++ )
+        {
+            const BlackMutexStats &report = reports[i];
+
+            std::string escapedName;
+            for( size_t c = 0 ; c < report.name.size() ; c++ )
+            {
+                if( report.name[c] == '"' or report.name[c] == '\\' )
+                {
+                    escapedName += '\\';
+                }
+                escapedName += report.name[c];
+            }
+
+            output << ((i == 0) ? "" : ",")
+                   << "{\"name\":\""           << escapedName            << "\""
+                   << ",\"acquisitions\":"      << report.acquisitions
+                   << ",\"contentions\":"       << report.contentions
+                   << ",\"totalWaitNs\":"       << report.totalWaitTime
+                   << ",\"maxWaitNs\":"         << report.maxWaitTime
+                   << ",\"totalHoldNs\":"       << report.totalHoldTime
+                   << ",\"maxHoldNs\":"         << report.maxHoldTime
+                   << "}";
+        }
+
+        output << "]";
+
+        return output.str();
+    }
+
 
 } /* namespace BlackLib */
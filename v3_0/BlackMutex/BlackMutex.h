@@ -33,10 +33,55 @@
 #define BLACKMUTEX_H_
 
 #include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sstream>
 
 namespace BlackLib
 {
 
+    // ######################################## BLACKMUTEXSTATS DECLARATION STARTS ########################################### //
+
+    /*! @brief Holds contention report of a profiled BlackMutex.
+    *
+    *    An acquisition is contended when the mutex is held by another thread at the lock time.
+    *    Hold time is measured from the outermost lock to the matching unlock.
+    *    @sa BlackMutex::enableProfiling()
+    */
+    struct BlackMutexStats
+    {
+        std::string     name;                   /*!< @brief is used to hold the profiling name of mutex */
+        uint64_t        acquisitions;           /*!< @brief is used to hold the successful lock count */
+        uint64_t        contentions;            /*!< @brief is used to hold the contended lock count */
+        uint64_t        totalWaitTime;          /*!< @brief is used to hold the sum of wait times in nanoseconds */
+        uint64_t        maxWaitTime;            /*!< @brief is used to hold the longest wait time in nanoseconds */
+        uint64_t        totalHoldTime;          /*!< @brief is used to hold the sum of hold times in nanoseconds */
+        uint64_t        maxHoldTime;            /*!< @brief is used to hold the longest hold time in nanoseconds */
+
+        /*! @brief Default constructor of BlackMutexStats struct.
+         *
+         *  This function clears all counters.
+         */
+        BlackMutexStats()
+        {
+            acquisitions    = 0;
+            contentions     = 0;
+            totalWaitTime   = 0;
+            maxWaitTime     = 0;
+            totalHoldTime   = 0;
+            maxHoldTime     = 0;
+        }
+    };
+
+    // ######################################### BLACKMUTEXSTATS DECLARATION ENDS ############################################ //
+
+
+
+
     // ########################################### BLACKMUTEX DECLARATION STARTS ############################################ //
 
     /*! @brief Prevents accessing the same memory location at the same time from different threads.
@@ -253,6 +298,8 @@ namespace BlackLib
     */
     class BlackMutex
     {
+        friend class BlackMutexRegistry;
+
         public:
 
             /*!
@@ -264,6 +311,15 @@ namespace BlackLib
                 Recursive       = 1             /*!< enumeration for @a recursive type mutex */
             };
 
+            /*!
+            * This enum is used to define mutex priority protocol.
+            */
+            enum mutexProtocol
+            {
+                NoInheritance       = 0,        /*!< enumeration for @a default protocol mutex */
+                PriorityInheritance = 1         /*!< enumeration for @a priority inheritance (PTHREAD_PRIO_INHERIT) mutex */
+            };
+
             /*! @brief Constructor of BlackMutex class.
             *
             * This function initializes mutex.
@@ -285,6 +341,10 @@ namespace BlackLib
             *
             *       BlackLib::BlackMutex *myMutexPtr = new BlackLib::BlackMutex(BlackLib::BlackMutex::Recursive);
             *
+            *       // owner of this mutex runs at waiting thread's priority while it holds the lock
+            *       BlackLib::BlackMutex sharedMutex(BlackLib::BlackMutex::NonRecursive,
+            *                                        BlackLib::BlackMutex::PriorityInheritance);
+            *
             *       ...
             *       ...
             *       ...
@@ -298,8 +358,13 @@ namespace BlackLib
             *  }
             * @endcode
             *
+            * @param [in] mm    recursive mode
+            * @param [in] mp    priority protocol. With BlackMutex::PriorityInheritance, a low priority thread
+            *                   which holds the mutex is boosted to the priority of the highest priority thread
+            *                   waiting for it, so the waiting thread is not blocked by medium priority threads.
             */
-            BlackMutex(BlackMutex::mutexMode mm = BlackMutex::NonRecursive);
+            BlackMutex(BlackMutex::mutexMode mm = BlackMutex::NonRecursive,
+                       BlackMutex::mutexProtocol mp = BlackMutex::NoInheritance);
 
             /*! @brief Destructor of BlackMutex class.
             *
@@ -693,6 +758,12 @@ namespace BlackLib
             */
             bool isRecursive();
 
+            /*! @brief Checks the mutex uses priority inheritance or not.
+            *
+            * @return true if mutex is created with BlackMutex::PriorityInheritance and the platform supports it, else false.
+            */
+            bool isPriorityInheritance();
+
             /*! @brief Exports the mutex lock count.
             *
             * @return number of lock count of mutex.
@@ -778,15 +849,205 @@ namespace BlackLib
             */
             unsigned int getLockedCount();
 
+            /*! @brief Starts recording contention report of the mutex.
+            *
+            * After this call, every lock records its wait time and whether it is contended, and every
+            * outermost unlock records the hold time. The mutex is added to BlackMutexRegistry with
+            * given name. Profiling adds two clock reads per lock/unlock pair; unprofiled mutexes
+            * only check a flag.
+            *
+            * @param [in] name      name of the mutex at the reports
+            *
+            * @par Example
+            *  @code{.cpp}
+            *   BlackLib::BlackMutex spiMutex;
+            *   spiMutex.enableProfiling("spi0");
+            *
+            *   // ... threads use spiMutex ...
+            *
+            *   std::cout << BlackLib::BlackMutexRegistry::dumpText();
+            * @endcode
+            * @code{.cpp}
+            *   // Possible Output:
+            *   // name                 acquired   contended   wait avg(us)   wait max(us)   hold avg(us)   hold max(us)
+            *   // spi0                     1520          37          1.204        412.553          8.731         97.015
+            * @endcode
+            */
+            void enableProfiling(const std::string &name);
+
+            /*! @brief Stops recording contention report and removes the mutex from BlackMutexRegistry.
+            */
+            void disableProfiling();
+
+            /*! @brief Checks the profiling is enabled or not.
+            *
+            * @return true if profiling is enabled else false.
+            */
+            bool isProfiling();
+
+            /*! @brief Exports contention report of the mutex.
+            *
+            * The report is copied without locking the mutex, so it can be called while any thread
+            * holds it.
+            * @return Copy of the contention report.
+            */
+            BlackMutexStats getStatistics();
+
+            /*! @brief Clears contention report of the mutex.
+            *
+            * Counters are cleared by the next lock of the mutex; until then the report shows zero.
+            */
+            void resetStatistics();
+
         private:
             pthread_mutex_t mutex;               /*!< @brief is used to hold the mutex posix data structure */
             unsigned int    lockCount;           /*!< @brief is used to hold the mutex lock count */
             mutexMode       mode;                /*!< @brief is used to hold the mutex mode property */
+            bool            isInheritance;       /*!< @brief is used to hold the priority inheritance is enabled or not */
+            volatile bool   isProfilingEnabled;  /*!< @brief is used to hold the profiling is enabled or not */
+            BlackMutexStats statistics;          /*!< @brief is used to hold the contention report, it is written while mutex is held */
+            uint64_t        acquireTime;         /*!< @brief is used to hold the outermost lock time in nanoseconds */
+            volatile unsigned int statisticsSequence; /*!< @brief is used to hold the report update count, it is odd during an update */
+            volatile bool   isResetRequested;    /*!< @brief is used to hold the report is waiting to be cleared or not */
+
+            /*! @brief Updates contention report after a successful lock.
+            *
+            * @param [in] waitStart     time before locking in nanoseconds
+            * @param [in] isContended   mutex was held by another thread or not
+            */
+            void recordAcquire(uint64_t waitStart, bool isContended);
+
+            /*! @brief Marks the start of a report update and applies a pending reset.
+            *
+            * Report is only written by the owner of the mutex, so there is one writer at a time.
+            */
+            void beginStatisticsUpdate();
+
+            /*! @brief Marks the end of a report update.
+            */
+            void endStatisticsUpdate();
+
+            /*! @brief Copies the counters of the report without locking the mutex.
+            *
+            * It retries while an update is in progress, like a seqlock reader. Name isn't copied.
+            * @param [out] output       report which the counters are copied to
+            */
+            void copyStatistics(BlackMutexStats &output);
+
+            /*! @brief Exports CLOCK_MONOTONIC time in nanoseconds.
+            */
+            static uint64_t monotonicTime();
     };
 
     // ############################################ BLACKMUTEX DECLARATION ENDS ############################################# //
 
 
+
+
+    // ####################################### BLACKMUTEXREGISTRY DECLARATION STARTS ######################################### //
+
+    /*! @brief Keeps the list of profiled mutexes and exports their reports.
+    *
+    *    Mutexes are added to this registry by BlackMutex::enableProfiling() and removed by
+    *    BlackMutex::disableProfiling() or their destructor. All functions are thread safe.
+    */
+    class BlackMutexRegistry
+    {
+        public:
+            /*! @brief Exports reports of all profiled mutexes.
+            *
+            * @return Copies of the contention reports.
+            */
+            static std::vector<BlackMutexStats> getAll();
+
+            /*! @brief Clears reports of all profiled mutexes.
+            */
+            static void                         resetAll();
+
+            /*! @brief Exports reports of all profiled mutexes as a text table.
+            *
+            * Times are in microseconds.
+            * @return Report table, one line per mutex with a header line.
+            */
+            static std::string                  dumpText();
+
+            /*! @brief Exports reports of all profiled mutexes as JSON.
+            *
+            * Output is an array of objects. Times are in nanoseconds.
+            * @return JSON text.
+            */
+            static std::string                  dumpJson();
+
+        private:
+            friend class BlackMutex;
+
+            /*! @brief Adds a mutex to the registry.
+            */
+            static void                         add(BlackMutex *mutex);
+
+            /*! @brief Removes a mutex from the registry.
+            */
+            static void                         remove(BlackMutex *mutex);
+
+            /*! @brief Exports the registered mutex list and its lock.
+            */
+            static std::vector<BlackMutex*>&    getList();
+            static pthread_mutex_t*             getListMutex();
+    };
+
+    // ######################################## BLACKMUTEXREGISTRY DECLARATION ENDS ########################################## //
+
+
+
+
+    // ########################################### BLACKLOCKGUARD DECLARATION STARTS ########################################## //
+
+    /*! @brief Locks a lock object in its scope.
+    *
+    *    This class locks the given object at construction and unlocks it at destruction, so the lock
+    *    is released at every return path of the scope. It can be used with all classes which have
+    *    lock() and unlock() functions, like BlackMutex, BlackSpinLock and BlackAdaptiveMutex.
+    *
+    * @par Example
+    *  @code{.cpp}
+    *   BlackLib::BlackMutex myMutex;
+    *
+    *   void update()
+    *   {
+    *       BlackLib::BlackLockGuard<BlackLib::BlackMutex> guard(myMutex);
+    *
+    *       // protected operations here, mutex is unlocked at the end of function
+    *   }
+    * @endcode
+    */
+    template <typename Lockable>
+    class BlackLockGuard
+    {
+        public:
+            /*! @brief Locks the object.
+            */
+            explicit BlackLockGuard(Lockable &lockObject) : lockable(lockObject)
+            {
+                this->lockable.lock();
+            }
+
+            /*! @brief Unlocks the object.
+            */
+            ~BlackLockGuard()
+            {
+                this->lockable.unlock();
+            }
+
+        private:
+            Lockable        &lockable;           /*!< @brief is used to hold the guarded lock object */
+
+            BlackLockGuard(const BlackLockGuard&);
+            BlackLockGuard& operator=(const BlackLockGuard&);
+    };
+
+    // ############################################ BLACKLOCKGUARD DECLARATION ENDS ########################################### //
+
+
 } /* namespace BlackLib */
 
 #endif /* BLACKMUTEX_H_ */
@@ -38,11 +38,19 @@
 namespace BlackLib
 {
 
+    // names of the BlackPWM::flags values, they are used as error labels of metrics
+    static const char *const pwmFlagNames[BlackIoMetrics::flagCount] =
+    {
+        "periodFileErr", "dutyFileErr", "runFileErr", "polarityFileErr",
+        "outOfRangeErr", "dtErr", "dtSubSystemErr", "pwmTestErr",
+        NULL, "cpmgrErr", "ocpErr"
+    };
+
+
     // ######################################### BLACKCOREPWM DEFINITION STARTS ########################################## //
-    BlackCorePWM::BlackCorePWM(pwmName pwm)
+    BlackCorePWM::BlackCorePWM(pwmName pwm) : pwmCoreErrors(this->getErrorsFromCore())
     {
         this->pwmPinName    = pwm;
-        this->pwmCoreErrors = new errorCorePWM( this->getErrorsFromCore() );
 
         this->loadDeviceTree();
 
@@ -52,47 +60,36 @@ namespace BlackLib
 
     BlackCorePWM::~BlackCorePWM()
     {
-        delete this->pwmCoreErrors;
     }
 
 
     bool        BlackCorePWM::loadDeviceTree()
     {
-        std::string file    = this->getSlotsFilePath();
-        std::ofstream slotsFile;
-
-        slotsFile.open(file.c_str(), std::ios::out);
-        if(slotsFile.fail())
+        if( not this->loadOverlay("am33xx_pwm") )
         {
-            slotsFile.close();
-            this->pwmCoreErrors->dtSsError  = true;
-            this->pwmCoreErrors->dtError    = true;
+            this->pwmCoreErrors.dtSsError   = true;
+            this->pwmCoreErrors.dtError     = true;
             return false;
         }
         else
         {
-            slotsFile << "am33xx_pwm";
-            slotsFile.close();
-            this->pwmCoreErrors->dtSsError  = false;
+            this->pwmCoreErrors.dtSsError   = false;
         }
 
 
-        slotsFile.open(file.c_str(), std::ios::out);
-        if(slotsFile.fail())
+        if( not this->loadOverlay("bone_pwm_" + pwmNameMap[this->pwmPinName]) )
         {
-            slotsFile.close();
-            this->pwmCoreErrors->dtError    = true;
+            this->pwmCoreErrors.dtError     = true;
             return false;
         }
         else
         {
-            slotsFile << ("bone_pwm_" + pwmNameMap[this->pwmPinName]);
-            slotsFile.close();
-            this->pwmCoreErrors->dtError    = false;
+            this->pwmCoreErrors.dtError     = false;
             return true;
         }
     }
 
+
     std::string BlackCorePWM::findPwmTestName(pwmName pwm)
     {
         std::string searchResult = SEARCH_DIR_NOT_FOUND;
@@ -144,12 +141,12 @@ namespace BlackLib
 
         if( searchResult == SEARCH_DIR_NOT_FOUND )
         {
-            this->pwmCoreErrors->pwmTestError = true;
+            this->pwmCoreErrors.pwmTestError = true;
             return PWM_TEST_NAME_NOT_FOUND;
         }
         else
         {
-            this->pwmCoreErrors->pwmTestError = false;
+            this->pwmCoreErrors.pwmTestError = false;
             return searchResult;
         }
     }
@@ -176,9 +173,14 @@ namespace BlackLib
         return (this->pwmTestPath + "/polarity");
     }
 
+    pwmName     BlackCorePWM::getPwmName()
+    {
+        return this->pwmPinName;
+    }
+
     errorCorePWM *BlackCorePWM::getErrorsFromCorePWM()
     {
-        return (this->pwmCoreErrors);
+        return &(this->pwmCoreErrors);
     }
     // ########################################## BLACKCOREPWM DEFINITION ENDS ########################################### //
 
@@ -194,19 +196,104 @@ namespace BlackLib
 
 
     // ########################################### BLACKPWM DEFINITION STARTS ############################################ //
-    BlackPWM::BlackPWM(pwmName pwm) : BlackCorePWM(pwm)
+    BlackPWM::BlackPWM(pwmName pwm) : BlackCorePWM(pwm), pwmErrors(this->getErrorsFromCorePWM()), ioMetrics("pwm", pwmFlagNames)
     {
-        this->pwmErrors     = new errorPWM( this->getErrorsFromCorePWM() );
 
+        this->pwmPinNumber  = static_cast<int>(pwm);
         this->periodPath    = this->getPeriodFilePath();
         this->dutyPath      = this->getDutyFilePath();
         this->runPath       = this->getRunFilePath();
         this->polarityPath  = this->getPolarityFilePath();
+
+        this->periodFD      = -1;
+        this->dutyFD        = -1;
+        this->runFD         = -1;
+        this->polarityFD    = -1;
+
+        this->cachedPeriod  = -1;
+        this->cachedDuty    = -1;
+        this->cachedRun     = -1;
+        this->cachedPolarity= -1;
     }
 
     BlackPWM::~BlackPWM()
     {
-        delete this->pwmErrors;
+        if( this->periodFD   >= 0 ) { ::close(this->periodFD);   }
+        if( this->dutyFD     >= 0 ) { ::close(this->dutyFD);     }
+        if( this->runFD      >= 0 ) { ::close(this->runFD);      }
+        if( this->polarityFD >= 0 ) { ::close(this->polarityFD); }
+
+    }
+
+    bool        BlackPWM::openFile(int &fd, const std::string &path)
+    {
+        if( fd < 0 )
+        {
+            fd = ::open(path.c_str(), O_RDWR);
+        }
+
+        return (fd >= 0);
+    }
+
+    bool        BlackPWM::writeNumeric(int &fd, const std::string &path, int64_t value)
+    {
+        return this->tryWriteNumeric(fd, path, value).isOk();
+    }
+
+    int64_t     BlackPWM::readNumeric(int &fd, const std::string &path)
+    {
+        return this->tryReadNumeric(fd, path).getValueOr(FILE_COULD_NOT_OPEN_INT);
+    }
+
+    BlackResult<void> BlackPWM::tryWriteNumeric(int &fd, const std::string &path, int64_t value)
+    {
+        if( !this->openFile(fd, path) )
+        {
+            return BlackResult<void>(BlackError::OpenFailed, errno);
+        }
+
+        char buffer[24];
+        size_t length = intToChars(value, buffer);
+
+        if( ::pwrite(fd, buffer, length, 0) != static_cast<ssize_t>(length) )
+        {
+            return BlackResult<void>(BlackError::WriteFailed, errno);
+        }
+
+        return BlackResult<void>();
+    }
+
+    BlackResult<int64_t> BlackPWM::tryReadNumeric(int &fd, const std::string &path)
+    {
+        if( !this->openFile(fd, path) )
+        {
+            return BlackResult<int64_t>(BlackError::OpenFailed, errno);
+        }
+
+        char buffer[24];
+        ssize_t readSize = ::pread(fd, buffer, sizeof(buffer), 0);
+        if( readSize < 0 )
+        {
+            return BlackResult<int64_t>(BlackError::ReadFailed, errno);
+        }
+
+        int64_t value = 0;
+        if( ! charsToInt(buffer, static_cast<size_t>(readSize), value) )
+        {
+            return BlackResult<int64_t>(BlackError::ParseFailed, 0);
+        }
+
+        return BlackResult<int64_t>(value);
+    }
+
+    int64_t     BlackPWM::getCachedPeriodValue()
+    {
+        if( this->cachedPeriod < 0 )
+        {
+            return this->getNumericPeriodValue();
+        }
+
+        return this->cachedPeriod;
     }
 
     std::string BlackPWM::getValue()
@@ -219,90 +306,50 @@ namespace BlackLib
 
     std::string BlackPWM::getPeriodValue()
     {
-        std::ifstream periodValueFile;
+        BlackResult<int64_t> result = this->tryGetPeriodValue();
 
-        periodValueFile.open(this->periodPath.c_str(),std::ios::in);
-        if(periodValueFile.fail())
+        if( not result )
         {
-            periodValueFile.close();
-            this->pwmErrors->periodFileError = true;
             return FILE_COULD_NOT_OPEN_STRING;
         }
-        else
-        {
-            std::string readValue;
-            periodValueFile >> readValue;
 
-            periodValueFile.close();
-            this->pwmErrors->periodFileError = false;
-            return readValue;
-        }
+        return intToString(result.getValue());
     }
 
     std::string BlackPWM::getDutyValue()
     {
-        std::ifstream dutyValueFile;
+        BlackResult<int64_t> result = this->tryGetDutyValue();
 
-        dutyValueFile.open(this->dutyPath.c_str(),std::ios::in);
-        if(dutyValueFile.fail())
+        if( not result )
         {
-            dutyValueFile.close();
-            this->pwmErrors->dutyFileError = true;
             return FILE_COULD_NOT_OPEN_STRING;
         }
-        else
-        {
-            std::string readValue;
-            dutyValueFile >> readValue;
 
-            dutyValueFile.close();
-            this->pwmErrors->dutyFileError = false;
-            return readValue;
-        }
+        return intToString(result.getValue());
     }
 
     std::string BlackPWM::getRunValue()
     {
-        std::ifstream runValueFile;
+        BlackResult<int> result = this->tryGetRunValue();
 
-        runValueFile.open(this->runPath.c_str(),std::ios::in);
-        if(runValueFile.fail())
+        if( not result )
         {
-            runValueFile.close();
-            this->pwmErrors->runFileError = true;
             return FILE_COULD_NOT_OPEN_STRING;
         }
-        else
-        {
-            std::string readValue;
-            runValueFile >> readValue;
 
-            runValueFile.close();
-            this->pwmErrors->runFileError = false;
-            return readValue;
-        }
+        return intToString(result.getValue());
     }
 
     std::string BlackPWM::getPolarityValue()
     {
-        std::ifstream polarityValueFile;
+        BlackResult<int> result = this->tryGetPolarityValue();
 
-        polarityValueFile.open(this->polarityPath.c_str(),std::ios::in);
-        if(polarityValueFile.fail())
+        if( not result )
         {
-            polarityValueFile.close();
-            this->pwmErrors->polarityFileError = true;
             return FILE_COULD_NOT_OPEN_STRING;
         }
-        else
-        {
-            std::string readValue;
-            polarityValueFile >> readValue;
 
-            polarityValueFile.close();
-            this->pwmErrors->polarityFileError = false;
-            return readValue;
-        }
+        return intToString(result.getValue());
     }
 
     float       BlackPWM::getNumericValue()
@@ -313,204 +360,296 @@ namespace BlackLib
         return static_cast<float>( (1.0 - (duty / period )) * 100 );
     }
 
-    inline int64_t    BlackPWM::getNumericPeriodValue()
+    int64_t     BlackPWM::getNumericPeriodValue()
     {
-        int64_t readValue = FILE_COULD_NOT_OPEN_INT;
+        return this->tryGetPeriodValue().getValueOr(FILE_COULD_NOT_OPEN_INT);
+    }
 
-        std::ifstream periodValueFile;
+    int64_t     BlackPWM::getNumericDutyValue()
+    {
+        return this->tryGetDutyValue().getValueOr(FILE_COULD_NOT_OPEN_INT);
+    }
+
+    BlackResult<int64_t> BlackPWM::tryGetPeriodValue()
+    {
+        BLACKLIB_TRACE_SCOPE(TracePwmRead, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.periodFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 0, periodFileErr, this->pwmErrors.periodFileError);
 
-        periodValueFile.open(this->periodPath.c_str(),std::ios::in);
-        if(periodValueFile.fail())
+        BlackResult<int64_t> result = this->tryReadNumeric(this->periodFD, this->periodPath);
+
+        if( result.isOk() )
         {
-            periodValueFile.close();
-            this->pwmErrors->periodFileError = true;
+            this->pwmErrors.periodFileError = false;
+            this->cachedPeriod = result.getValue();
         }
         else
         {
-            periodValueFile >> readValue;
-
-            periodValueFile.close();
-            this->pwmErrors->periodFileError = false;
+            this->pwmErrors.periodFileError = true;
+            this->cachedPeriod = -1;
         }
-        return readValue;
+        return result;
     }
 
-    inline int64_t    BlackPWM::getNumericDutyValue()
+    BlackResult<int64_t> BlackPWM::tryGetDutyValue()
     {
-        int64_t readValue = FILE_COULD_NOT_OPEN_INT;
-        std::ifstream dutyValueFile;
+        BLACKLIB_TRACE_SCOPE(TracePwmRead, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.dutyFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 0, dutyFileErr, this->pwmErrors.dutyFileError);
+
+        BlackResult<int64_t> result = this->tryReadNumeric(this->dutyFD, this->dutyPath);
 
-        dutyValueFile.open(this->dutyPath.c_str(),std::ios::in);
-        if(dutyValueFile.fail())
+        if( result.isOk() )
         {
-            dutyValueFile.close();
-            this->pwmErrors->dutyFileError = true;
+            this->pwmErrors.dutyFileError = false;
+            this->cachedDuty = result.getValue();
         }
         else
         {
-            dutyValueFile >> readValue;
+            this->pwmErrors.dutyFileError = true;
+            this->cachedDuty = -1;
+        }
+        return result;
+    }
+
+
+    BlackResult<int> BlackPWM::tryGetRunValue()
+    {
+        BLACKLIB_TRACE_SCOPE(TracePwmRead, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.runFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 0, runFileErr, this->pwmErrors.runFileError);
+
+        BlackResult<int64_t> result = this->tryReadNumeric(this->runFD, this->runPath);
+
+        if( result.isOk() )
+        {
+            this->pwmErrors.runFileError = false;
+            this->cachedRun = static_cast<int>(result.getValue());
+            return BlackResult<int>(this->cachedRun);
+        }
+
+        this->pwmErrors.runFileError = true;
+        this->cachedRun = -1;
+        return BlackResult<int>(result.getError(), result.getErrno());
+    }
 
-            dutyValueFile.close();
-            this->pwmErrors->dutyFileError = false;
+    BlackResult<int> BlackPWM::tryGetPolarityValue()
+    {
+        BLACKLIB_TRACE_SCOPE(TracePwmRead, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.polarityFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, 0, polarityFileErr, this->pwmErrors.polarityFileError);
+
+        BlackResult<int64_t> result = this->tryReadNumeric(this->polarityFD, this->polarityPath);
+
+        if( result.isOk() )
+        {
+            this->pwmErrors.polarityFileError = false;
+            this->cachedPolarity = static_cast<int>(result.getValue());
+            return BlackResult<int>(this->cachedPolarity);
         }
-        return readValue;
+
+        this->pwmErrors.polarityFileError = true;
+        this->cachedPolarity = -1;
+        return BlackResult<int>(result.getError(), result.getErrno());
     }
 
 
     bool        BlackPWM::setDutyPercent(float percantage)
     {
+        return this->trySetDutyPercent(percantage).isOk();
+    }
+
+    BlackResult<void> BlackPWM::trySetDutyPercent(float percantage)
+    {
+        BLACKLIB_TRACE_SCOPE(TracePwmWrite, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.dutyFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 0, dutyFileErr, this->pwmErrors.dutyFileError);
+
         if( percantage > 100.0 or percantage < 0.0 )
         {
-            this->pwmErrors->outOfRange      = true;
-            this->pwmErrors->dutyFileError   = true;
-            this->pwmErrors->periodFileError = true;
-            return false;
+            this->pwmErrors.outOfRange       = true;
+            this->pwmErrors.dutyFileError    = true;
+            this->pwmErrors.periodFileError  = true;
+            return BlackResult<void>(BlackError::OutOfRange, 0);
         }
 
-        this->pwmErrors->outOfRange = false;
+        this->pwmErrors.outOfRange = false;
 
-        std::ofstream dutyFile;
-        dutyFile.open(this->dutyPath.c_str(),std::ios::out);
-        if(dutyFile.fail())
+        int64_t period = this->cachedPeriod;
+        if( period < 0 )
         {
-            dutyFile.close();
-            this->pwmErrors->dutyFileError = true;
-            return false;
+            BlackResult<int64_t> periodResult = this->tryGetPeriodValue();
+            if( not periodResult )
+            {
+                this->pwmErrors.dutyFileError = true;
+                return BlackResult<void>(periodResult.getError(), periodResult.getErrno());
+            }
+            period = periodResult.getValue();
+        }
+
+        int64_t newDuty = static_cast<int64_t>(std::round(period * (1.0 - (percantage/100))));
+
+        BlackResult<void> result = this->tryWriteNumeric(this->dutyFD, this->dutyPath, newDuty);
+        if( result.isOk() )
+        {
+            this->cachedDuty = newDuty;
+            this->pwmErrors.dutyFileError = false;
         }
         else
         {
-            dutyFile << static_cast<int64_t>(std::round((this->getNumericPeriodValue()) * (1.0 - (percantage/100))));
-            dutyFile.close();
-            this->pwmErrors->dutyFileError = false;
-            return true;
+            this->cachedDuty = -1;
+            this->pwmErrors.dutyFileError = true;
         }
-
+        return result;
     }
 
     bool        BlackPWM::setPeriodTime(uint64_t period, timeType tType)
     {
-        uint64_t writeThis = static_cast<uint64_t>(period * static_cast<double>(pow( 10, static_cast<int>(tType)+9) ));
+        return this->writePeriodTime( toNanoseconds(period, tType) );
+    }
+
+    bool        BlackPWM::setSpaceRatioTime(uint64_t space, timeType tType)
+    {
+        return this->writeSpaceRatioTime( toNanoseconds(space, tType) );
+    }
+
+    bool        BlackPWM::setLoadRatioTime(uint64_t load, timeType tType)
+    {
+        return this->writeLoadRatioTime( toNanoseconds(load, tType) );
+    }
+
+    bool        BlackPWM::writePeriodTime(uint64_t writeThis)
+    {
+        BLACKLIB_TRACE_SCOPE(TracePwmWrite, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.periodFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 0, periodFileErr, this->pwmErrors.periodFileError);
 
         if( writeThis > 1000000000)
         {
-            this->pwmErrors->outOfRange = true;
+            this->pwmErrors.outOfRange      = true;
+            this->pwmErrors.periodFileError = true;
             return false;
         }
         else
         {
-            this->pwmErrors->outOfRange = false;
-            std::ofstream periodFile;
-            periodFile.open(this->periodPath.c_str(),std::ios::out);
-            if(periodFile.fail())
+            this->pwmErrors.outOfRange = false;
+
+            if( this->writeNumeric(this->periodFD, this->periodPath, writeThis) )
             {
-                periodFile.close();
-                this->pwmErrors->periodFileError = true;
-                return false;
+                this->cachedPeriod = writeThis;
+                this->pwmErrors.periodFileError = false;
+                return true;
             }
             else
             {
-                periodFile << writeThis;
-                periodFile.close();
-                this->pwmErrors->periodFileError = false;
-                return true;
+                this->cachedPeriod = -1;
+                this->pwmErrors.periodFileError = true;
+                return false;
             }
         }
 
     }
 
-    bool        BlackPWM::setSpaceRatioTime(uint64_t space, timeType tType)
+    bool        BlackPWM::writeSpaceRatioTime(uint64_t writeThis)
     {
-        uint64_t writeThis = static_cast<int64_t>(space * static_cast<double>(pow( 10, static_cast<int>(tType)+9) ));
+        BLACKLIB_TRACE_SCOPE(TracePwmWrite, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.dutyFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 0, dutyFileErr, this->pwmErrors.dutyFileError);
 
         if( writeThis > 1000000000)
         {
-            this->pwmErrors->outOfRange = true;
+            this->pwmErrors.outOfRange      = true;
+            this->pwmErrors.dutyFileError   = true;
             return false;
         }
         else
         {
-            std::ofstream dutyFile;
-            dutyFile.open(this->dutyPath.c_str(),std::ios::out);
-            if(dutyFile.fail())
+            this->pwmErrors.outOfRange = false;
+
+            if( this->writeNumeric(this->dutyFD, this->dutyPath, writeThis) )
             {
-                dutyFile.close();
-                this->pwmErrors->dutyFileError = true;
-                return false;
+                this->cachedDuty = writeThis;
+                this->pwmErrors.dutyFileError = false;
+                return true;
             }
             else
             {
-                dutyFile << writeThis;
-                dutyFile.close();
-                this->pwmErrors->dutyFileError = false;
-                return true;
+                this->cachedDuty = -1;
+                this->pwmErrors.dutyFileError = true;
+                return false;
             }
         }
     }
 
-    bool        BlackPWM::setLoadRatioTime(uint64_t load, timeType tType)
+    bool        BlackPWM::writeLoadRatioTime(uint64_t load)
     {
-        uint64_t writeThis = (this->getNumericPeriodValue() - static_cast<int64_t>(load * static_cast<double>(pow( 10, static_cast<int>(tType)+9) )));
+        BLACKLIB_TRACE_SCOPE(TracePwmWrite, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.dutyFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 0, dutyFileErr, this->pwmErrors.dutyFileError);
+
+        int64_t period = this->getCachedPeriodValue();
+
+        if( period < 0 or load > static_cast<uint64_t>(period) )
+        {
+            this->pwmErrors.outOfRange      = true;
+            this->pwmErrors.dutyFileError   = true;
+            return false;
+        }
+
+        uint64_t writeThis = static_cast<uint64_t>(period) - load;
 
         if( writeThis > 1000000000)
         {
-            this->pwmErrors->outOfRange = true;
+            this->pwmErrors.outOfRange      = true;
+            this->pwmErrors.dutyFileError   = true;
             return false;
         }
         else
         {
-            std::ofstream dutyFile;
-            dutyFile.open(this->dutyPath.c_str(),std::ios::out);
-            if(dutyFile.fail())
+            this->pwmErrors.outOfRange = false;
+
+            if( this->writeNumeric(this->dutyFD, this->dutyPath, writeThis) )
             {
-                dutyFile.close();
-                this->pwmErrors->dutyFileError = true;
-                return false;
+                this->cachedDuty = writeThis;
+                this->pwmErrors.dutyFileError = false;
+                return true;
             }
             else
             {
-                dutyFile << writeThis;
-                dutyFile.close();
-                this->pwmErrors->dutyFileError = false;
-                return true;
+                this->cachedDuty = -1;
+                this->pwmErrors.dutyFileError = true;
+                return false;
             }
         }
     }
 
     bool        BlackPWM::setPolarity(polarityType polarity)
     {
-        std::ofstream polarityFile;
-        polarityFile.open(this->polarityPath.c_str(),std::ios::out);
-        if(polarityFile.fail())
+        BLACKLIB_TRACE_SCOPE(TracePwmWrite, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.polarityFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 0, polarityFileErr, this->pwmErrors.polarityFileError);
+
+        if( this->writeNumeric(this->polarityFD, this->polarityPath, static_cast<int>(polarity)) )
         {
-            polarityFile.close();
-            this->pwmErrors->polarityFileError = true;
-            return false;
+            this->cachedPolarity = static_cast<int>(polarity);
+            this->pwmErrors.polarityFileError = false;
+            return true;
         }
         else
         {
-            polarityFile << static_cast<int>(polarity);
-            polarityFile.close();
-            this->pwmErrors->polarityFileError = false;
-            return true;
+            this->cachedPolarity = -1;
+            this->pwmErrors.polarityFileError = true;
+            return false;
         }
     }
 
     bool        BlackPWM::setRunState(runValue state)
     {
-        std::ofstream runFile;
-        runFile.open(this->runPath.c_str(),std::ios::out);
-        if(runFile.fail())
+        BLACKLIB_TRACE_SCOPE(TracePwmWrite, static_cast<uint32_t>(this->pwmPinNumber), 0, this->pwmErrors.runFileError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 0, runFileErr, this->pwmErrors.runFileError);
+
+        if( this->writeNumeric(this->runFD, this->runPath, static_cast<int>(state)) )
         {
-            runFile.close();
-            this->pwmErrors->runFileError = true;
-            return false;
+            this->cachedRun = static_cast<int>(state);
+            this->pwmErrors.runFileError = false;
+            return true;
         }
         else
         {
-            runFile << static_cast<int>(state);
-            runFile.close();
-            this->pwmErrors->runFileError = false;
-            return true;
+            this->cachedRun = -1;
+            this->pwmErrors.runFileError = true;
+            return false;
         }
     }
 
@@ -518,24 +657,29 @@ namespace BlackLib
 
     bool        BlackPWM::isRunning()
     {
-        return (this->getRunValue() == "1");
+        return (this->tryGetRunValue().getValueOr(0) == 1);
     }
 
     bool        BlackPWM::isPolarityStraight()
     {
-        return !(this->getPolarityValue() == "1");
+        return (this->tryGetPolarityValue().getValueOr(0) != 1);
     }
 
     bool        BlackPWM::isPolarityReverse()
     {
-        return (this->getPolarityValue() == "1");
+        return (this->tryGetPolarityValue().getValueOr(0) == 1);
     }
 
 
 
     void        BlackPWM::toggleRunState()
     {
-        if( this->getRunValue() == "1" )
+        if( this->cachedRun < 0 )
+        {
+            this->tryGetRunValue();
+        }
+
+        if( this->cachedRun == 1 )
         {
             this->setRunState(stop);
         }
@@ -547,7 +691,12 @@ namespace BlackLib
 
     void        BlackPWM::tooglePolarity()
     {
-        if( this->getPolarityValue() == "0" )
+        if( this->cachedPolarity < 0 )
+        {
+            this->tryGetPolarityValue();
+        }
+
+        if( this->cachedPolarity == 0 )
         {
             this->setPolarity(reverse);
         }
@@ -559,35 +708,40 @@ namespace BlackLib
 
     bool        BlackPWM::fail()
     {
-        return (this->pwmErrors->outOfRange or
-                this->pwmErrors->runFileError or
-                this->pwmErrors->dutyFileError or
-                this->pwmErrors->periodFileError or
-                this->pwmErrors->polarityFileError or
-                this->pwmErrors->pwmCoreErrors->dtError or
-                this->pwmErrors->pwmCoreErrors->dtSsError or
-                this->pwmErrors->pwmCoreErrors->pwmTestError or
-                this->pwmErrors->pwmCoreErrors->coreErrors->ocpError or
-                this->pwmErrors->pwmCoreErrors->coreErrors->capeMgrError
+        return (this->pwmErrors.outOfRange or
+                this->pwmErrors.runFileError or
+                this->pwmErrors.dutyFileError or
+                this->pwmErrors.periodFileError or
+                this->pwmErrors.polarityFileError or
+                this->pwmErrors.pwmCoreErrors->dtError or
+                this->pwmErrors.pwmCoreErrors->dtSsError or
+                this->pwmErrors.pwmCoreErrors->pwmTestError or
+                this->pwmErrors.pwmCoreErrors->coreErrors->ocpError or
+                this->pwmErrors.pwmCoreErrors->coreErrors->capeMgrError
                 );
     }
 
     bool        BlackPWM::fail(BlackPWM::flags f)
     {
-        if(f==outOfRangeErr)    { return this->pwmErrors->outOfRange;                               }
-        if(f==runFileErr)       { return this->pwmErrors->runFileError;                             }
-        if(f==dutyFileErr)      { return this->pwmErrors->dutyFileError;                            }
-        if(f==periodFileErr)    { return this->pwmErrors->periodFileError;                          }
-        if(f==polarityFileErr)  { return this->pwmErrors->polarityFileError;                        }
-        if(f==dtErr)            { return this->pwmErrors->pwmCoreErrors->dtError;                   }
-        if(f==dtSubSystemErr)   { return this->pwmErrors->pwmCoreErrors->dtSsError;                 }
-        if(f==pwmTestErr)       { return this->pwmErrors->pwmCoreErrors->pwmTestError;              }
-        if(f==ocpErr)           { return this->pwmErrors->pwmCoreErrors->coreErrors->ocpError;      }
-        if(f==cpmgrErr)         { return this->pwmErrors->pwmCoreErrors->coreErrors->capeMgrError;  }
+        if(f==outOfRangeErr)    { return this->pwmErrors.outOfRange;                                }
+        if(f==runFileErr)       { return this->pwmErrors.runFileError;                              }
+        if(f==dutyFileErr)      { return this->pwmErrors.dutyFileError;                             }
+        if(f==periodFileErr)    { return this->pwmErrors.periodFileError;                           }
+        if(f==polarityFileErr)  { return this->pwmErrors.polarityFileError;                         }
+        if(f==dtErr)            { return this->pwmErrors.pwmCoreErrors->dtError;                    }
+        if(f==dtSubSystemErr)   { return this->pwmErrors.pwmCoreErrors->dtSsError;                  }
+        if(f==pwmTestErr)       { return this->pwmErrors.pwmCoreErrors->pwmTestError;               }
+        if(f==ocpErr)           { return this->pwmErrors.pwmCoreErrors->coreErrors->ocpError;       }
+        if(f==cpmgrErr)         { return this->pwmErrors.pwmCoreErrors->coreErrors->capeMgrError;   }
 
         return true;
     }
 
+    BlackIoMetrics *BlackPWM::getMetrics()
+    {
+        return &(this->ioMetrics);
+    }
+
     // ########################################### BLACKPWM DEFINITION STARTS ############################################ //
 
 
@@ -36,6 +36,8 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <unistd.h>
+#include <fcntl.h>
 
 
 
@@ -96,7 +98,7 @@ namespace BlackLib
     class BlackCorePWM : virtual private BlackCore
     {
         private:
-            errorCorePWM    *pwmCoreErrors;             /*!< @brief is used to hold the errors of BlackCorePWM class */
+            errorCorePWM     pwmCoreErrors;             /*!< @brief is used to hold the errors of BlackCorePWM class */
             std::string     pwmTestPath;                /*!< @brief is used to hold the pwm_test (pwm device driver) path */
             pwmName         pwmPinName;                 /*!< @brief is used to hold the selected pwm @b pin name */
 
@@ -144,6 +146,12 @@ namespace BlackLib
             */
             std::string     getPolarityFilePath();
 
+            /*! @brief Exports pwm pin name to derived class.
+            *
+            *  @return Pwm pin name.
+            */
+            pwmName         getPwmName();
+
             /*! @brief Exports errorCorePWM struct to derived class.
             *
             *  @return errorCorePWM struct pointer.
@@ -164,8 +172,6 @@ namespace BlackLib
                             BlackCorePWM(pwmName pwm);
 
             /*! @brief Destructor of BlackCorePWM class.
-            *
-            * This function deletes errorCorePWM struct pointer.
             */
             virtual         ~BlackCorePWM();
 
@@ -299,13 +305,92 @@ namespace BlackLib
      */
     class BlackPWM : virtual private BlackCorePWM
     {
+        friend class BlackPWMGroup;
+
         private:
-            errorPWM        *pwmErrors;                 /*!< @brief is used to hold the errors of BlackPWM class */
+            errorPWM         pwmErrors;                 /*!< @brief is used to hold the errors of BlackPWM class */
+            BlackIoMetrics   ioMetrics;                 /*!< @brief is used to hold the I/O metrics of BlackPWM class */
+            int             pwmPinNumber;               /*!< @brief is used to hold the numeric value of selected pwm pin name */
             std::string     periodPath;                 /*!< @brief is used to hold the @a period file path */
             std::string     dutyPath;                   /*!< @brief is used to hold the @a duty file path */
             std::string     runPath;                    /*!< @brief is used to hold the @a run file path */
             std::string     polarityPath;               /*!< @brief is used to hold the @a polarity file path */
 
+            int             periodFD;                   /*!< @brief is used to hold the @a period file's file descriptor */
+            int             dutyFD;                     /*!< @brief is used to hold the @a duty file's file descriptor */
+            int             runFD;                      /*!< @brief is used to hold the @a run file's file descriptor */
+            int             polarityFD;                 /*!< @brief is used to hold the @a polarity file's file descriptor */
+
+            int64_t         cachedPeriod;               /*!< @brief is used to hold the last known period value, negative if unknown */
+            int64_t         cachedDuty;                 /*!< @brief is used to hold the last known duty value, negative if unknown */
+            int             cachedRun;                  /*!< @brief is used to hold the last known run value, negative if unknown */
+            int             cachedPolarity;             /*!< @brief is used to hold the last known polarity value, negative if unknown */
+
+            /*! @brief Opens pwm_test file if it is not open.
+            *
+            *  This function opens the file at @b path with read/write mode, if @b fd doesn't hold
+            *  an open file descriptor. The file descriptor is held until object destruction.
+            *  @param [in,out] fd      file descriptor variable of the file
+            *  @param [in] path        file path
+            *  @return True if file descriptor is ready, else false.
+            */
+            bool            openFile(int &fd, const std::string &path);
+
+            /*! @brief Writes integer value to pwm_test file.
+            *
+            *  This function formats value into a stack buffer and writes it with single pwrite() call.
+            *  @param [in,out] fd      file descriptor variable of the file
+            *  @param [in] path        file path
+            *  @param [in] value       value which will be written
+            *  @return True if successful, else false.
+            */
+            bool            writeNumeric(int &fd, const std::string &path, int64_t value);
+
+            /*! @brief Reads integer value from pwm_test file.
+            *
+            *  This function reads the file with single pread() call and parses decimal value.
+            *  @param [in,out] fd      file descriptor variable of the file
+            *  @param [in] path        file path
+            *  @return Read value if successful, else BlackLib::FILE_COULD_NOT_OPEN_INT.
+            */
+            int64_t         readNumeric(int &fd, const std::string &path);
+
+            /*! @brief Writes integer value to pwm_test file and returns an error code.
+            */
+            BlackResult<void>    tryWriteNumeric(int &fd, const std::string &path, int64_t value);
+
+            /*! @brief Reads integer value from pwm_test file and returns it with an error code.
+            */
+            BlackResult<int64_t> tryReadNumeric(int &fd, const std::string &path);
+
+            /*! @brief Exports period value from cache.
+            *
+            *  This function reads the period file only if period value isn't cached yet.
+            *  @return Period value if successful, else BlackLib::FILE_COULD_NOT_OPEN_INT.
+            */
+            int64_t         getCachedPeriodValue();
+
+            /*! @brief Writes nanosecond period value to period file.
+            *
+            *  @param [in] period      new period value in nanoseconds
+            *  @return True if successful, else false.
+            */
+            bool            writePeriodTime(uint64_t period);
+
+            /*! @brief Writes nanosecond space time value to duty file.
+            *
+            *  @param [in] space       new space time value in nanoseconds
+            *  @return True if successful, else false.
+            */
+            bool            writeSpaceRatioTime(uint64_t space);
+
+            /*! @brief Calculates space time from nanosecond load time and writes it to duty file.
+            *
+            *  @param [in] load        new load time value in nanoseconds
+            *  @return True if successful, else false.
+            */
+            bool            writeLoadRatioTime(uint64_t load);
+
 
         public:
             /*!
@@ -326,7 +411,8 @@ namespace BlackLib
             /*! @brief Constructor of BlackPWM class.
             *
             * This function initializes BlackCorePWM class with entered parameter and errorPWM struct.
-            * Then it sets file paths of period, duty, polarity and run files.
+            * Then it sets file paths of period, duty, polarity and run files. These files are opened at
+            * first access and their file descriptors are held until object destruction.
             * @param [in] pwm        pwm name (enum)
             *
             * @par Example
@@ -345,7 +431,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackPWM class.
             *
-            * This function deletes errorPWM struct pointer.
+            * This function closes pwm_test files.
             */
             virtual         ~BlackPWM();
 
@@ -378,6 +464,8 @@ namespace BlackLib
             *
             * This function reads specified file from path, where defined at BlackPWM::periodPath variable.
             * This file holds pwm period value at nanosecond (ns) level.
+            * It is implemented on top of the numeric read, so the file is read with one pread() call and
+            * the string is created from the parsed value.
             *  @return @a string type period value. If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_STRING.
             *
             *  @par Example
@@ -403,6 +491,8 @@ namespace BlackLib
             *
             * This function reads specified file from path, where defined at BlackPWM::dutyPath variable.
             * This file holds pwm duty value at nanosecond (ns) level.
+            * It is implemented on top of the numeric read, so the file is read with one pread() call and
+            * the string is created from the parsed value.
             *  @return @a string type duty value. If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_STRING.
             *
             *  @par Example
@@ -429,6 +519,8 @@ namespace BlackLib
             *
             * This function reads specified file from path, where defined at BlackPWM::runPath variable.
             * This file holds pwm run value.
+            * It is implemented on top of the numeric read, so the file is read with one pread() call and
+            * the string is created from the parsed value.
             *  @return @a string type run value. If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_STRING.
             *
             *  @par Example
@@ -456,6 +548,8 @@ namespace BlackLib
             *
             * This function reads specified file from path, where defined at BlackPWM::polarityPath variable.
             * This file holds pwm polarity value.
+            * It is implemented on top of the numeric read, so the file is read with one pread() call and
+            * the string is created from the parsed value.
             *  @return @a String type polarity value. If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_STRING.
             *
             *  @par Example
@@ -507,9 +601,9 @@ namespace BlackLib
             /*! @brief Reads numeric period value of pwm signal.
             *
             * This function reads specified file from path, where defined at BlackPWM::periodPath variable.
-            * This file holds pwm period value at nanosecond (ns) level.
-            * @return @a int64_t (long int) type period value.  If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_INT.
-            * @warning Any alphabetic character existence in period file can crash your application.
+            * This file holds pwm period value at nanosecond (ns) level. Read value also refreshes the
+            * period cache which is used by setter functions.
+            * @return @a int64_t (long int) type period value.  If file reading fails, it returns BlackLib::FILE_COULD_NOT_OPEN_INT.
             *
             * @par Example
             * @code{.cpp}
@@ -533,9 +627,9 @@ namespace BlackLib
             /*! @brief Reads numeric duty value of pwm signal.
             *
             * This function reads specified file from path, where defined at BlackPWM::dutyPath variable.
-            * This file holds pwm duty value at nanosecond (ns) level.
-            * @return @a int64_t (long int) type duty value.  If file opening fails, it returns BlackLib::FILE_COULD_NOT_OPEN_INT.
-            * @warning Any alphabetic character existence in period file can crash your application.
+            * This file holds pwm duty value at nanosecond (ns) level. Read value also refreshes the
+            * duty cache.
+            * @return @a int64_t (long int) type duty value.  If file reading fails, it returns BlackLib::FILE_COULD_NOT_OPEN_INT.
             *
             * @par Example
             * @code{.cpp}
@@ -559,13 +653,39 @@ namespace BlackLib
             */
             int64_t         getNumericDutyValue();
 
+            /*! @brief Reads period value of pwm signal and returns it with an error code.
+            *
+            *  @return Period value in nanoseconds, or BlackLib::BlackError::OpenFailed, ReadFailed or ParseFailed.
+            */
+            BlackResult<int64_t> tryGetPeriodValue();
+
+            /*! @brief Reads duty value of pwm signal and returns it with an error code.
+            *
+            *  @return Duty value in nanoseconds, or BlackLib::BlackError::OpenFailed, ReadFailed or ParseFailed.
+            */
+            BlackResult<int64_t> tryGetDutyValue();
+
+            /*! @brief Reads run value of pwm signal and returns it with an error code.
+            *
+            *  @return Run value(1 or 0), or BlackLib::BlackError::OpenFailed, ReadFailed or ParseFailed.
+            */
+            BlackResult<int>     tryGetRunValue();
+
+            /*! @brief Reads polarity value of pwm signal and returns it with an error code.
+            *
+            *  @return Polarity value(1 or 0), or BlackLib::BlackError::OpenFailed, ReadFailed or ParseFailed.
+            */
+            BlackResult<int>     tryGetPolarityValue();
+
 
             /*! @brief Sets percentage value of duty cycle.
             *
             * If input parameter is in range (from 0.0 to 100.0), this function changes duty value
             * without changing period value. For calculating new duty value, the current period
             * multiplies by (1 - entered percentage/100) value. After do that, this calculated value
-            * is saved to duty file.
+            * is saved to duty file. The current period is taken from cache, so the period file is
+            * read only once and duty is written with single system call. If the period is changed
+            * outside of this object, getNumericPeriodValue() must be called to refresh the cache.
             * @param [in] percentage new percantage value(float)
             * @return True if setting new value is successful, else false.
             *
@@ -595,6 +715,13 @@ namespace BlackLib
             */
             bool            setDutyPercent(float percentage);
 
+            /*! @brief Sets percentage value of duty cycle and returns an error code.
+            *
+            *  @param [in] percentage   new percantage value(float)
+            *  @return BlackLib::BlackError::None if successful, else OutOfRange, OpenFailed, ReadFailed or WriteFailed.
+            */
+            BlackResult<void> trySetDutyPercent(float percentage);
+
             /*! @brief Sets period value of pwm signal.
             *
             * If input parameter's nanosecond equivalent is in range (from 0 to 10^9), this function changes period value
@@ -636,6 +763,35 @@ namespace BlackLib
             */
             bool            setPeriodTime(uint64_t period, timeType tType = nanosecond);
 
+            /*! @brief Sets period value of pwm signal with compile time specified time type.
+            *
+            * This function works like setPeriodTime(uint64_t, timeType), but the unit conversion is resolved
+            * at compile time and uses only integer operations.
+            * @tparam T time type of your new period value(enum)
+            * @param [in] period new period value
+            * @return True if setting new period value is successful, else false.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackPWM myPwm(BlackLib::P8_19);
+            *
+            *   myPwm.setDutyPercent(100.0);
+            *   myPwm.setPeriodTime<BlackLib::microsecond>(700);
+            *   std::cout << "Pwm period time: " << myPwm.getPeriodValue() << " nanoseconds \n";
+            * @endcode
+            * @code{.cpp}
+            *   // Possible Output:
+            *   // Pwm period time: 700000 nanoseconds
+            * @endcode
+            *
+            * @sa BlackLib::toNanoseconds()
+            */
+            template <timeType T>
+            bool            setPeriodTime(uint64_t period)
+            {
+                return this->writePeriodTime( toNanoseconds<T>(period) );
+            }
+
             /*! @brief Sets space time value of pwm signal.
             *
             * If input parameter's nanosecond equivalent is in range (from 0 to 10^9), this function changes duty value
@@ -671,6 +827,22 @@ namespace BlackLib
             */
             bool            setSpaceRatioTime(uint64_t space, timeType tType = nanosecond);
 
+            /*! @brief Sets space time value of pwm signal with compile time specified time type.
+            *
+            * This function works like setSpaceRatioTime(uint64_t, timeType), but the unit conversion is
+            * resolved at compile time and uses only integer operations.
+            * @tparam T time type of your new space time value(enum)
+            * @param [in] space new space time value
+            * @return True if setting new value is successful, else false.
+            *
+            * @sa BlackLib::toNanoseconds()
+            */
+            template <timeType T>
+            bool            setSpaceRatioTime(uint64_t space)
+            {
+                return this->writeSpaceRatioTime( toNanoseconds<T>(space) );
+            }
+
             /*! @brief Sets load time value of pwm signal.
             *
             * If input parameter's nanosecond equivalent is in range (from 0 to 10^9), this function changes duty value
@@ -707,6 +879,22 @@ namespace BlackLib
             */
             bool            setLoadRatioTime(uint64_t load, timeType tType = nanosecond);
 
+            /*! @brief Sets load time value of pwm signal with compile time specified time type.
+            *
+            * This function works like setLoadRatioTime(uint64_t, timeType), but the unit conversion is
+            * resolved at compile time and uses only integer operations.
+            * @tparam T time type of your new load time value(enum)
+            * @param [in] load new load time value
+            * @return True if setting new value is successful, else false.
+            *
+            * @sa BlackLib::toNanoseconds()
+            */
+            template <timeType T>
+            bool            setLoadRatioTime(uint64_t load)
+            {
+                return this->writeLoadRatioTime( toNanoseconds<T>(load) );
+            }
+
             /*! @brief Sets polarity of pwm signal.
             *
             * The input parameter is converted to 1 or 0 and this value is saved to polarity file.
@@ -977,6 +1165,18 @@ namespace BlackLib
             * @sa errorPWM
             */
             bool            fail(BlackPWM::flags f);
+
+            /*! @brief Exports I/O metrics of the object.
+            *
+            * Operations aren't measured until the returned metrics are registered with BlackMetrics::add().
+            * @return Pointer of BlackPWM::ioMetrics variable.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackMetrics::add("my_pwm", myPwm.getMetrics());
+            * @endcode
+            */
+            BlackIoMetrics *getMetrics();
     };
     // ########################################### BLACKPWM DECLARATION STARTS ############################################ //
 
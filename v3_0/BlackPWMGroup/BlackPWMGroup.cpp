@@ -0,0 +1,504 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackPWMGroup.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    /*!
+    * Physical base addresses of PWMSS0, PWMSS1 and PWMSS2 on AM335x.
+    */
+    static const off_t      pwmssBaseAddress[3]     = { 0x48300000, 0x48302000, 0x48304000 };
+    static const off_t      ehrpwmOffset            = 0x200;
+    static const size_t     pwmssPageSize           = 0x1000;
+
+    /*!
+    * EHRPWM register offsets as 16 bit word index.
+    */
+    enum ehrpwmRegister     {   TBCTL                   = 0x00 / 2,
+                                TBCNT                   = 0x08 / 2,
+                                TBPRD                   = 0x0A / 2,
+                                CMPCTL                  = 0x0E / 2,
+                                CMPA                    = 0x12 / 2,
+                                CMPB                    = 0x14 / 2
+                            };
+
+    static const uint16_t   TBCTL_PRDLD_IMMEDIATE   = (1 << 3);
+    static const uint16_t   CMPCTL_SHDWAMODE        = (1 << 4);
+    static const uint16_t   CMPCTL_SHDWBMODE        = (1 << 6);
+    static const uint16_t   CMPCTL_LOADMODE_MASK    = 0x000F;
+    static const uint16_t   CMPCTL_LOADMODE_FREEZE  = 0x000F;
+    static const int64_t    commitGuardNanoseconds  = 2000;
+
+
+
+    // ######################################### BLACKPWMGROUP DEFINITION STARTS ########################################## //
+    BlackPWMGroup::BlackPWMGroup(pwmGroupMode mode)
+    {
+        this->groupMode     = mode;
+        this->memFD         = -1;
+
+        for( int i = 0 ; i < moduleCount ; i++ )
+        {
+            this->moduleRegisters[i] = NULL;
+            this->modulePages[i]     = MAP_FAILED;
+        }
+
+        if( this->groupMode == GroupRegister )
+        {
+            this->memFD = ::open("/dev/mem", O_RDWR | O_SYNC);
+            this->groupErrors.mapError = (this->memFD < 0);
+        }
+    }
+
+    BlackPWMGroup::~BlackPWMGroup()
+    {
+        for( int i = 0 ; i < moduleCount ; i++ )
+        {
+            if( this->modulePages[i] != MAP_FAILED )
+            {
+                munmap(this->modulePages[i], pwmssPageSize);
+            }
+        }
+
+        if( this->memFD >= 0 )
+        {
+            ::close(this->memFD);
+        }
+
+    }
+
+    BlackPWMGroup::channel *BlackPWMGroup::findChannel(BlackPWM &pwm)
+    {
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            if( this->channels[i].pwm == &pwm )
+            {
+                this->groupErrors.channelError = false;
+                return &(this->channels[i]);
+            }
+        }
+
+        this->groupErrors.channelError = true;
+        return NULL;
+    }
+
+    bool        BlackPWMGroup::mapModule(int module)
+    {
+        if( module < 0 or module >= moduleCount or this->memFD < 0 )
+        {
+            this->groupErrors.mapError = true;
+            return false;
+        }
+
+        if( this->moduleRegisters[module] == NULL )
+        {
+            void *page = mmap(NULL, pwmssPageSize, PROT_READ | PROT_WRITE, MAP_SHARED, this->memFD, pwmssBaseAddress[module]);
+            if( page == MAP_FAILED )
+            {
+                this->groupErrors.mapError = true;
+                return false;
+            }
+
+            this->modulePages[module]     = page;
+            this->moduleRegisters[module] = reinterpret_cast<volatile uint16_t*>(static_cast<char*>(page) + ehrpwmOffset);
+        }
+
+        this->groupErrors.mapError = false;
+        return true;
+    }
+
+    uint32_t    BlackPWMGroup::toCounts(int module, int64_t nanoseconds)
+    {
+        uint16_t tbctl      = this->moduleRegisters[module][TBCTL];
+        uint32_t clkDiv     = 1u << ((tbctl >> 10) & 0x7);
+        uint32_t hspClkDiv  = (tbctl >> 7) & 0x7;
+        hspClkDiv           = (hspClkDiv == 0) ? 1 : (2 * hspClkDiv);
+
+        // time base clock is 100 MHz / (CLKDIV * HSPCLKDIV), so one count is 10 ns * prescaler.
+        return static_cast<uint32_t>(nanoseconds / (10 * static_cast<int64_t>(clkDiv * hspClkDiv)));
+    }
+
+    bool        BlackPWMGroup::addChannel(BlackPWM &pwm)
+    {
+        if( this->findChannel(pwm) != NULL )
+        {
+            return true;
+        }
+
+        channel newChannel;
+        newChannel.pwm          = &pwm;
+        newChannel.period       = -1;
+        newChannel.duty         = -1;
+        newChannel.periodStaged = false;
+        newChannel.dutyStaged   = false;
+
+        switch( pwm.getPwmName() )
+        {
+            case EHRPWM0A:  { newChannel.module = 0;    newChannel.isChannelB = false;  break; }
+            case EHRPWM0B:  { newChannel.module = 0;    newChannel.isChannelB = true;   break; }
+            case EHRPWM1A:  { newChannel.module = 1;    newChannel.isChannelB = false;  break; }
+            case EHRPWM1B:  { newChannel.module = 1;    newChannel.isChannelB = true;   break; }
+            case EHRPWM2A:  { newChannel.module = 2;    newChannel.isChannelB = false;  break; }
+            case EHRPWM2B:  { newChannel.module = 2;    newChannel.isChannelB = true;   break; }
+            default:        { newChannel.module = -1;   newChannel.isChannelB = false;  break; }
+        }
+
+        if( this->groupMode == GroupRegister and !this->mapModule(newChannel.module) )
+        {
+            return false;
+        }
+
+        this->channels.push_back(newChannel);
+        this->groupErrors.channelError = false;
+        return true;
+    }
+
+    bool        BlackPWMGroup::stageDutyPercent(BlackPWM &pwm, float percentage)
+    {
+        channel *ch = this->findChannel(pwm);
+        if( ch == NULL )
+        {
+            return false;
+        }
+
+        if( percentage > 100.0 or percentage < 0.0 )
+        {
+            this->groupErrors.outOfRange = true;
+            return false;
+        }
+
+        int64_t period = ch->periodStaged ? ch->period : pwm.getCachedPeriodValue();
+        if( period < 0 )
+        {
+            this->groupErrors.outOfRange = true;
+            return false;
+        }
+
+        this->groupErrors.outOfRange = false;
+        ch->duty       = static_cast<int64_t>(std::round(period * (1.0 - (percentage/100))));
+        ch->dutyStaged = true;
+        return true;
+    }
+
+    bool        BlackPWMGroup::stagePeriodTime(BlackPWM &pwm, uint64_t period, timeType tType)
+    {
+        channel *ch = this->findChannel(pwm);
+        if( ch == NULL )
+        {
+            return false;
+        }
+
+        uint64_t newPeriod = toNanoseconds(period, tType);
+        if( newPeriod > 1000000000 )
+        {
+            this->groupErrors.outOfRange = true;
+            return false;
+        }
+
+        this->groupErrors.outOfRange = false;
+        ch->period       = newPeriod;
+        ch->periodStaged = true;
+        return true;
+    }
+
+    bool        BlackPWMGroup::stageSpaceRatioTime(BlackPWM &pwm, uint64_t space, timeType tType)
+    {
+        channel *ch = this->findChannel(pwm);
+        if( ch == NULL )
+        {
+            return false;
+        }
+
+        uint64_t newDuty = toNanoseconds(space, tType);
+        if( newDuty > 1000000000 )
+        {
+            this->groupErrors.outOfRange = true;
+            return false;
+        }
+
+        this->groupErrors.outOfRange = false;
+        ch->duty       = newDuty;
+        ch->dutyStaged = true;
+        return true;
+    }
+
+    bool        BlackPWMGroup::commitSysfs()
+    {
+        bool isAllWritten = true;
+
+        // phase 0: growing periods, phase 1: duties, phase 2: shrinking periods
+        for( int phase = 0 ; phase < 3 ; phase++ )
+        {
+            for( size_t i = 0 ; i < this->channels.size() ; i++ )
+            {
+                channel  &ch  = this->channels[i];
+                BlackPWM *pwm = ch.pwm;
+
+                if( phase == 1 )
+                {
+                    if( !ch.dutyStaged )
+                    {
+                        continue;
+                    }
+
+                    bool isWritten = pwm->writeNumeric(pwm->dutyFD, pwm->dutyPath, ch.duty);
+                    pwm->cachedDuty                 = isWritten ? ch.duty : -1;
+                    pwm->pwmErrors.dutyFileError    = !isWritten;
+                    isAllWritten                    = isAllWritten and isWritten;
+                }
+                else
+                {
+                    if( !ch.periodStaged )
+                    {
+                        continue;
+                    }
+
+                    bool isGrowing = (ch.period >= pwm->cachedPeriod);
+                    if( (phase == 0) != isGrowing )
+                    {
+                        continue;
+                    }
+
+                    bool isWritten = pwm->writeNumeric(pwm->periodFD, pwm->periodPath, ch.period);
+                    pwm->cachedPeriod               = isWritten ? ch.period : -1;
+                    pwm->pwmErrors.periodFileError = !isWritten;
+                    isAllWritten                    = isAllWritten and isWritten;
+                }
+            }
+        }
+
+        return isAllWritten;
+    }
+
+    bool        BlackPWMGroup::commitRegister()
+    {
+        uint32_t periodCounts[moduleCount];
+        bool     isModuleUsed[moduleCount];
+        bool     isPeriodStaged[moduleCount];
+        uint16_t releaseValue[moduleCount];
+
+        for( int m = 0 ; m < moduleCount ; m++ )
+        {
+            isModuleUsed[m]   = false;
+            isPeriodStaged[m] = false;
+            periodCounts[m]   = 0;
+        }
+
+
+        // validate all staged values before touching any register
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            channel &ch = this->channels[i];
+            if( !ch.periodStaged and !ch.dutyStaged )
+            {
+                continue;
+            }
+
+            if( ch.module < 0 or this->moduleRegisters[ch.module] == NULL )
+            {
+                this->groupErrors.mapError = true;
+                return false;
+            }
+
+            int m = ch.module;
+            if( !isModuleUsed[m] )
+            {
+                isModuleUsed[m] = true;
+                periodCounts[m] = static_cast<uint32_t>(this->moduleRegisters[m][TBPRD]) + 1;
+            }
+
+            if( ch.periodStaged )
+            {
+                uint32_t counts = this->toCounts(m, ch.period);
+                if( counts == 0 or counts > 0x10000 or (isPeriodStaged[m] and counts != periodCounts[m]) )
+                {
+                    this->groupErrors.outOfRange = true;
+                    return false;
+                }
+
+                periodCounts[m]   = counts;
+                isPeriodStaged[m] = true;
+            }
+        }
+
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            channel &ch = this->channels[i];
+            if( ch.dutyStaged and this->toCounts(ch.module, ch.duty) > periodCounts[ch.module] )
+            {
+                this->groupErrors.outOfRange = true;
+                return false;
+            }
+        }
+        this->groupErrors.outOfRange = false;
+
+        int reference = 0;
+        while( reference < moduleCount and !isModuleUsed[reference] )
+        {
+            reference++;
+        }
+
+        if( reference == moduleCount )
+        {
+            return true;
+        }
+
+
+        // freeze shadow to active loading of compare registers
+        for( int m = 0 ; m < moduleCount ; m++ )
+        {
+            if( !isModuleUsed[m] )
+            {
+                continue;
+            }
+
+            volatile uint16_t *regs = this->moduleRegisters[m];
+            uint16_t cmpctl = regs[CMPCTL] & ~(CMPCTL_SHDWAMODE | CMPCTL_SHDWBMODE);
+
+            releaseValue[m] = cmpctl & ~CMPCTL_LOADMODE_MASK;
+            regs[CMPCTL]    = cmpctl | CMPCTL_LOADMODE_FREEZE;
+            regs[TBCTL]     = regs[TBCTL] & ~TBCTL_PRDLD_IMMEDIATE;
+        }
+
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            channel &ch = this->channels[i];
+            if( ch.dutyStaged )
+            {
+                this->moduleRegisters[ch.module][ch.isChannelB ? CMPB : CMPA] = static_cast<uint16_t>(this->toCounts(ch.module, ch.duty));
+            }
+        }
+
+
+        // don't release near the end of a period, else some modules could load at different zero events.
+        // waiting is limited, because the counter doesn't move while pwm is stopped.
+        volatile uint16_t *refRegs = this->moduleRegisters[reference];
+        uint32_t guardCounts = this->toCounts(reference, commitGuardNanoseconds);
+        uint32_t refPeriod   = static_cast<uint32_t>(refRegs[TBPRD]) + 1;
+
+        if( refPeriod > 2 * guardCounts )
+        {
+            timespec start, now;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+
+            while( refPeriod - refRegs[TBCNT] <= guardCounts )
+            {
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                if( (now.tv_sec - start.tv_sec) * 1000000000LL + (now.tv_nsec - start.tv_nsec) > 2 * commitGuardNanoseconds )
+                {
+                    break;
+                }
+            }
+        }
+
+        for( int m = 0 ; m < moduleCount ; m++ )
+        {
+            if( isPeriodStaged[m] )
+            {
+                this->moduleRegisters[m][TBPRD] = static_cast<uint16_t>(periodCounts[m] - 1);
+            }
+        }
+
+        for( int m = 0 ; m < moduleCount ; m++ )
+        {
+            if( isModuleUsed[m] )
+            {
+                this->moduleRegisters[m][CMPCTL] = releaseValue[m];
+            }
+        }
+
+
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            channel &ch = this->channels[i];
+            if( ch.periodStaged ) { ch.pwm->cachedPeriod = ch.period; }
+            if( ch.dutyStaged   ) { ch.pwm->cachedDuty   = ch.duty;   }
+        }
+
+        return true;
+    }
+
+    bool        BlackPWMGroup::commit()
+    {
+        bool isCommitted = (this->groupMode == GroupRegister) ? this->commitRegister() : this->commitSysfs();
+
+        this->groupErrors.writeError = !isCommitted;
+        this->clearStage();
+        return isCommitted;
+    }
+
+    void        BlackPWMGroup::clearStage()
+    {
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            this->channels[i].periodStaged = false;
+            this->channels[i].dutyStaged   = false;
+        }
+    }
+
+    void        BlackPWMGroup::discard()
+    {
+        this->clearStage();
+    }
+
+    pwmGroupMode BlackPWMGroup::getMode()
+    {
+        return this->groupMode;
+    }
+
+    bool        BlackPWMGroup::fail()
+    {
+        return (this->groupErrors.outOfRange or
+                this->groupErrors.channelError or
+                this->groupErrors.writeError or
+                this->groupErrors.mapError
+                );
+    }
+
+    bool        BlackPWMGroup::fail(BlackPWMGroup::flags f)
+    {
+        if(f==outOfRangeErr)    { return this->groupErrors.outOfRange;      }
+        if(f==channelErr)       { return this->groupErrors.channelError;    }
+        if(f==writeErr)         { return this->groupErrors.writeError;      }
+        if(f==mapErr)           { return this->groupErrors.mapError;        }
+
+        return true;
+    }
+    // ########################################## BLACKPWMGROUP DEFINITION ENDS ########################################### //
+
+
+} /* namespace BlackLib */
@@ -0,0 +1,293 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKPWMGROUP_H_
+#define BLACKPWMGROUP_H_
+
+#include "../BlackPWM/BlackPWM.h"
+
+#include <vector>
+#include <cstdint>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/mman.h>
+
+
+
+namespace BlackLib
+{
+
+    /*!
+    * This enum is used for selecting the update mechanism of BlackPWMGroup.
+    */
+    enum pwmGroupMode       {   GroupSysfs              = 0,
+                                GroupRegister           = 1
+                            };
+
+
+
+
+    // ######################################### BLACKPWMGROUP DECLARATION STARTS ########################################## //
+
+    /*! @brief Updates several PWM channels together.
+     *
+     *    This class stages duty and period changes of multiple BlackPWM objects and writes them to hardware
+     *    together with commit() function. It has two modes:
+     *
+     *    @li @b GroupSysfs : Staged values are written to pwm_test files back-to-back through the held file
+     *    descriptors of BlackPWM objects. All values are calculated before the first write, so the skew
+     *    between channels is only the system call time.
+     *    @li @b GroupRegister : EHRPWM registers are mapped from /dev/mem. Staged values are written to the
+     *    shadow registers while shadow-to-active loading is frozen, then loading is released for all modules
+     *    back-to-back. New values become active at the next counter-zero event, so both outputs of one
+     *    EHRPWM module are updated at exactly the same time and phase-synchronized modules are updated at
+     *    the same zero event.
+     *
+     *    @warning GroupRegister mode needs root privileges and works with EHRPWM outputs only (ECAP0 is not
+     *    supported). Register writes bypass the kernel driver, so values in pwm_test files aren't updated;
+     *    BlackPWM objects' internal caches are updated instead. Period values must fit the time base
+     *    prescaler which is selected by kernel driver.
+     *
+     * @par Example
+     * @code{.cpp}
+     *  // Filename: myPwmGroupProject.cpp
+     *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+     *
+     *  #include <iostream>
+     *  #include "BlackLib/BlackPWMGroup/BlackPWMGroup.h"
+     *
+     *  int main()
+     *  {
+     *      BlackLib::BlackPWM  phaseA(BlackLib::EHRPWM0A);
+     *      BlackLib::BlackPWM  phaseB(BlackLib::EHRPWM1A);
+     *      BlackLib::BlackPWM  phaseC(BlackLib::EHRPWM2A);
+     *
+     *      BlackLib::BlackPWMGroup inverter(BlackLib::GroupRegister);
+     *      inverter.addChannel(phaseA);
+     *      inverter.addChannel(phaseB);
+     *      inverter.addChannel(phaseC);
+     *
+     *      inverter.stageDutyPercent(phaseA, 50.0);
+     *      inverter.stageDutyPercent(phaseB, 25.0);
+     *      inverter.stageDutyPercent(phaseC, 75.0);
+     *
+     *      if( !inverter.commit() )
+     *      {
+     *          std::cout << "COMMIT FAILED" << std::endl;
+     *      }
+     *
+     *      return 0;
+     *  }
+     * @endcode
+     */
+    class BlackPWMGroup
+    {
+        private:
+            /*! @brief Holds one channel of the group and its staged values.
+             */
+            struct channel
+            {
+                BlackPWM        *pwm;               /*!< @brief is used to hold the pwm object of channel */
+                int             module;             /*!< @brief is used to hold the EHRPWM module number, -1 for ECAP */
+                bool            isChannelB;         /*!< @brief is used to hold the channel is output B of module */
+                int64_t         period;             /*!< @brief is used to hold the staged period value in nanoseconds */
+                int64_t         duty;               /*!< @brief is used to hold the staged duty value in nanoseconds */
+                bool            periodStaged;       /*!< @brief is used to hold the period value is staged */
+                bool            dutyStaged;         /*!< @brief is used to hold the duty value is staged */
+            };
+
+            static const int    moduleCount = 3;    /*!< @brief is used to hold the EHRPWM module count */
+
+            errorPWMGroup        groupErrors;       /*!< @brief is used to hold the errors of BlackPWMGroup class */
+            pwmGroupMode        groupMode;          /*!< @brief is used to hold the update mode of group */
+            std::vector<channel> channels;          /*!< @brief is used to hold the channels of group */
+
+            int                 memFD;              /*!< @brief is used to hold the /dev/mem file descriptor */
+            volatile uint16_t   *moduleRegisters[moduleCount];  /*!< @brief is used to hold the mapped EHRPWM register bases */
+            void                *modulePages[moduleCount];      /*!< @brief is used to hold the mapped PWMSS pages */
+
+            /*! @brief Finds the channel of pwm object.
+            *
+            *  @param [in] pwm         pwm object
+            *  @return Pointer of channel if pwm is in group, else null and sets errorPWMGroup::channelError flag.
+            */
+            channel             *findChannel(BlackPWM &pwm);
+
+            /*! @brief Maps registers of EHRPWM module.
+            *
+            *  This function maps PWMSS page of the module from /dev/mem, if it isn't mapped yet.
+            *  @param [in] module      EHRPWM module number
+            *  @return True if successful, else false.
+            */
+            bool                mapModule(int module);
+
+            /*! @brief Converts nanoseconds to time base counts of EHRPWM module.
+            *
+            *  This function calculates time base clock from prescaler bits of TBCTL register.
+            *  @param [in] module      EHRPWM module number
+            *  @param [in] nanoseconds time value
+            *  @return Count value.
+            */
+            uint32_t            toCounts(int module, int64_t nanoseconds);
+
+            /*! @brief Writes staged values to pwm_test files.
+            *
+            *  @return True if all writes are successful, else false.
+            */
+            bool                commitSysfs();
+
+            /*! @brief Writes staged values to EHRPWM shadow registers.
+            *
+            *  @return True if all writes are successful, else false.
+            */
+            bool                commitRegister();
+
+            /*! @brief Clears staged flags of all channels.
+            */
+            void                clearStage();
+
+
+        public:
+            /*!
+            * This enum is used to define PWM group debugging flags.
+            */
+            enum flags      {   outOfRangeErr   = 0,    /*!< enumeration for @a errorPWMGroup::outOfRange status */
+                                channelErr      = 1,    /*!< enumeration for @a errorPWMGroup::channelError status */
+                                writeErr        = 2,    /*!< enumeration for @a errorPWMGroup::writeError status */
+                                mapErr          = 3     /*!< enumeration for @a errorPWMGroup::mapError status */
+                            };
+
+            /*! @brief Constructor of BlackPWMGroup class.
+            *
+            * This function initializes errorPWMGroup struct and sets update mode. If mode is GroupRegister,
+            * it opens /dev/mem.
+            *
+            * @param [in] mode          update mode of group (enum)
+            *
+            * @sa pwmGroupMode
+            */
+                                BlackPWMGroup(pwmGroupMode mode = GroupSysfs);
+
+            /*! @brief Destructor of BlackPWMGroup class.
+            *
+            * This function unmaps registers and closes /dev/mem.
+            */
+            virtual             ~BlackPWMGroup();
+
+            /*! @brief Adds pwm object to group.
+            *
+            * In GroupRegister mode, this function also maps registers of pwm's EHRPWM module.
+            * The pwm object must live longer than group.
+            *
+            * @param [in] pwm           pwm object
+            * @return True if successful, else false.
+            */
+            bool                addChannel(BlackPWM &pwm);
+
+            /*! @brief Stages percentage value of duty cycle.
+            *
+            * New duty value is calculated from staged period value if it exists, else from cached period
+            * value of pwm object. The value isn't written until commit() call.
+            *
+            * @param [in] pwm           pwm object which is added to group
+            * @param [in] percentage    new percentage value(float)
+            * @return True if staging is successful, else false.
+            *
+            * @sa BlackPWM::setDutyPercent()
+            */
+            bool                stageDutyPercent(BlackPWM &pwm, float percentage);
+
+            /*! @brief Stages period value of pwm signal.
+            *
+            * @param [in] pwm           pwm object which is added to group
+            * @param [in] period        new period value
+            * @param [in] tType         time type of your new period value(enum)
+            * @return True if staging is successful, else false.
+            *
+            * @sa BlackPWM::setPeriodTime()
+            */
+            bool                stagePeriodTime(BlackPWM &pwm, uint64_t period, timeType tType = nanosecond);
+
+            /*! @brief Stages space time (duty file) value of pwm signal.
+            *
+            * @param [in] pwm           pwm object which is added to group
+            * @param [in] space         new space time value
+            * @param [in] tType         time type of your new space time value(enum)
+            * @return True if staging is successful, else false.
+            *
+            * @sa BlackPWM::setSpaceRatioTime()
+            */
+            bool                stageSpaceRatioTime(BlackPWM &pwm, uint64_t space, timeType tType = nanosecond);
+
+            /*! @brief Writes all staged values to hardware.
+            *
+            * In GroupSysfs mode, increasing periods are written first, then duties and then decreasing periods,
+            * so the kernel never sees a duty value greater than its period. In GroupRegister mode, shadow
+            * registers are written while loading is frozen and loading is released for all modules together.
+            * Staged values are cleared after this call.
+            *
+            * @return True if all values are written successfully, else false.
+            */
+            bool                commit();
+
+            /*! @brief Drops all staged values without writing them.
+            */
+            void                discard();
+
+            /*! @brief Exports update mode of group.
+            *
+            * @return Update mode of group.
+            */
+            pwmGroupMode        getMode();
+
+            /*! @brief Is used for general debugging.
+            *
+            * @return True if any error occured, else false.
+            *
+            * @sa errorPWMGroup
+            */
+            bool                fail();
+
+            /*! @brief Is used for specific debugging.
+            *
+            * @param [in] f specific error type (enum)
+            * @return Value of @a selected error.
+            *
+            * @sa errorPWMGroup
+            */
+            bool                fail(BlackPWMGroup::flags f);
+    };
+    // ########################################## BLACKPWMGROUP DECLARATION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKPWMGROUP_H_ */
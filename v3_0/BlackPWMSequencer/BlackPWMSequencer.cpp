@@ -0,0 +1,243 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackPWMSequencer.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ####################################### BLACKPWMSEQUENCER DEFINITION STARTS ######################################### //
+    BlackPWMSequencer::BlackPWMSequencer(BlackThread::priority tp, pwmGroupMode mode) : pwmGroup(mode)
+    {
+        this->repeatCount       = 1;
+
+        this->setPriority(tp);
+    }
+
+    BlackPWMSequencer::~BlackPWMSequencer()
+    {
+        this->requestStop();
+        this->waitUntilFinish();
+    }
+
+    unsigned int BlackPWMSequencer::addChannel(BlackPWM &pwm)
+    {
+        for( size_t i = 0 ; i < this->channels.size() ; i++ )
+        {
+            if( this->channels[i] == &pwm )
+            {
+                return i;
+            }
+        }
+
+        this->pwmGroup.addChannel(pwm);
+        this->channels.push_back(&pwm);
+        return (this->channels.size() - 1);
+    }
+
+    bool        BlackPWMSequencer::addStep(const BlackPWMStep &step)
+    {
+        if( this->isRunning() or step.channel >= this->channels.size() )
+        {
+            return false;
+        }
+
+        this->steps.push_back(step);
+        return true;
+    }
+
+    bool        BlackPWMSequencer::clearSteps()
+    {
+        if( this->isRunning() )
+        {
+            return false;
+        }
+
+        this->steps.clear();
+        return true;
+    }
+
+    void        BlackPWMSequencer::setRepeatCount(unsigned int count)
+    {
+        this->repeatCount = count;
+    }
+
+    bool        BlackPWMSequencer::start()
+    {
+        if( this->isRunning() or this->steps.empty() )
+        {
+            return false;
+        }
+
+        uint64_t totalHoldTime = 0;
+        for( size_t i = 0 ; i < this->steps.size() ; i++ )
+        {
+            totalHoldTime += this->steps[i].holdTime;
+        }
+
+        // an endless table without any waiting would only spin
+        if( this->repeatCount == 0 and totalHoldTime == 0 )
+        {
+            return false;
+        }
+
+        this->statisticsMutex.lock();
+        this->statistics = BlackPWMSequencerStats();
+        this->statistics.stepJitter.resize(this->steps.size(), 0);
+        this->statisticsMutex.unlock();
+
+        this->run();
+
+        return this->isRunning();
+    }
+
+    BlackPWMSequencerStats BlackPWMSequencer::getStatistics()
+    {
+        this->statisticsMutex.lock();
+        BlackPWMSequencerStats copy = this->statistics;
+        this->statisticsMutex.unlock();
+
+        return copy;
+    }
+
+    void        BlackPWMSequencer::recordJitter(size_t stepIndex, int64_t jitter, bool isOverrun)
+    {
+        this->statisticsMutex.lock();
+
+        this->statistics.stepJitter[stepIndex]  = jitter;
+        this->statistics.totalJitter           += jitter;
+        this->statistics.jitterSamples         += 1;
+
+        if( jitter > this->statistics.maxJitter )
+        {
+            this->statistics.maxJitter = jitter;
+        }
+
+        if( isOverrun )
+        {
+            this->statistics.overruns += 1;
+        }
+
+        this->statisticsMutex.unlock();
+    }
+
+    void        BlackPWMSequencer::onStartHandler()
+    {
+        timespec deadline;
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        for( unsigned int pass = 0 ; (this->repeatCount == 0) or (pass < this->repeatCount) ; pass++ )
+        {
+            size_t index = 0;
+
+            while( index < this->steps.size() )
+            {
+                if( this->isStopRequested() )
+                {
+                    return;
+                }
+
+                // stage all steps until the first step which has hold time
+                size_t  groupSize = 0;
+                bool    isStaged  = true;
+
+                while( index < this->steps.size() )
+                {
+                    const BlackPWMStep &step = this->steps[index++];
+                    BlackPWM *pwm = this->channels[step.channel];
+
+                    if( step.period > 0 )
+                    {
+                        isStaged = this->pwmGroup.stagePeriodTime(*pwm, step.period, nanosecond) and isStaged;
+                    }
+
+                    if( step.dutyPercent >= 0.0 )
+                    {
+                        isStaged = this->pwmGroup.stageDutyPercent(*pwm, step.dutyPercent) and isStaged;
+                    }
+
+                    groupSize++;
+
+                    if( step.holdTime > 0 )
+                    {
+                        break;
+                    }
+                }
+
+                bool isApplied = this->pwmGroup.commit() and isStaged;
+
+                this->statisticsMutex.lock();
+                if( isApplied ) { this->statistics.appliedSteps += groupSize; }
+                else            { this->statistics.failedSteps  += groupSize; }
+                this->statisticsMutex.unlock();
+
+
+                uint64_t holdTime = this->steps[index - 1].holdTime;
+                if( holdTime == 0 )
+                {
+                    continue;
+                }
+
+                uint64_t nanoseconds = deadline.tv_nsec + holdTime;
+                deadline.tv_sec     += nanoseconds / 1000000000;
+                deadline.tv_nsec     = nanoseconds % 1000000000;
+
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                bool isOverrun = ( (now.tv_sec > deadline.tv_sec) or
+                                   (now.tv_sec == deadline.tv_sec and now.tv_nsec > deadline.tv_nsec) );
+
+                // park condition uses CLOCK_MONOTONIC, so a stop request ends the hold at once. Other
+                // wakeups don't end it, the deadline stays absolute.
+                while( this->parkUntil(deadline) )
+                {
+                    if( not this->checkPoint() )
+                    {
+                        return;
+                    }
+                }
+
+                clock_gettime(CLOCK_MONOTONIC, &now);
+                int64_t jitter = static_cast<int64_t>(now.tv_sec - deadline.tv_sec) * 1000000000LL
+                               + (now.tv_nsec - deadline.tv_nsec);
+
+                this->recordJitter(index - 1, jitter, isOverrun);
+            }
+        }
+    }
+    // ######################################## BLACKPWMSEQUENCER DEFINITION ENDS ########################################## //
+
+
+} /* namespace BlackLib */
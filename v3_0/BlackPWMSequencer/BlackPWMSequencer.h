@@ -0,0 +1,256 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKPWMSEQUENCER_H_
+#define BLACKPWMSEQUENCER_H_
+
+#include "../BlackPWMGroup/BlackPWMGroup.h"
+#include "../BlackThread/BlackThread.h"
+#include "../BlackMutex/BlackMutex.h"
+
+#include <vector>
+#include <cstdint>
+#include <time.h>
+
+
+
+namespace BlackLib
+{
+
+    // ######################################### BLACKPWMSTEP DECLARATION STARTS ########################################## //
+
+    /*! @brief Holds one step of a pwm waveform table.
+     *
+     *    A step changes duty and/or period of one channel and then holds for @b holdTime nanoseconds.
+     *    Consecutive steps with zero hold time are applied together with the next step which has non-zero
+     *    hold time, so several channels can change at the same time.
+     *    @sa BlackPWMSequencer::addStep()
+     */
+    struct BlackPWMStep
+    {
+        unsigned int    channel;        /*!< @brief is used to hold the channel index which is returned from BlackPWMSequencer::addChannel() */
+        float           dutyPercent;    /*!< @brief is used to hold the new duty percentage, negative value keeps current duty */
+        uint64_t        period;         /*!< @brief is used to hold the new period in nanoseconds, zero keeps current period */
+        uint64_t        holdTime;       /*!< @brief is used to hold the waiting time after this step in nanoseconds */
+
+        /*! @brief Default constructor of BlackPWMStep struct.
+         *
+         *  This function creates a step which changes nothing.
+         */
+        BlackPWMStep()
+        {
+            channel     = 0;
+            dutyPercent = -1.0;
+            period      = 0;
+            holdTime    = 0;
+        }
+
+        /*! @brief Overloaded constructor of BlackPWMStep struct.
+         *
+         *  This function sets input arguments to variables.
+         */
+        BlackPWMStep(unsigned int S_channel, float S_dutyPercent, uint64_t S_period, uint64_t S_holdTime)
+        {
+            channel     = S_channel;
+            dutyPercent = S_dutyPercent;
+            period      = S_period;
+            holdTime    = S_holdTime;
+        }
+    };
+    // ########################################## BLACKPWMSTEP DECLARATION ENDS ########################################### //
+
+
+
+
+    // ###################################### BLACKPWMSEQUENCERSTATS DECLARATION STARTS ####################################### //
+
+    /*! @brief Holds timing report of BlackPWMSequencer.
+     *
+     *    Jitter is the difference between the scheduled and the real wakeup time of a step group.
+     *    @sa BlackPWMSequencer::getStatistics()
+     */
+    struct BlackPWMSequencerStats
+    {
+        uint64_t                appliedSteps;   /*!< @brief is used to hold the applied step count */
+        uint64_t                failedSteps;    /*!< @brief is used to hold the step count which couldn't be written */
+        uint64_t                overruns;       /*!< @brief is used to hold the count of wakeups which were later than next deadline */
+        int64_t                 maxJitter;      /*!< @brief is used to hold the maximum wakeup jitter in nanoseconds */
+        int64_t                 totalJitter;    /*!< @brief is used to hold the sum of wakeup jitters in nanoseconds */
+        uint64_t                jitterSamples;  /*!< @brief is used to hold the wakeup count */
+        std::vector<int64_t>    stepJitter;     /*!< @brief is used to hold the last wakeup jitter of each step in nanoseconds */
+
+        /*! @brief Default constructor of BlackPWMSequencerStats struct.
+         *
+         *  This function clears all counters.
+         */
+        BlackPWMSequencerStats()
+        {
+            appliedSteps    = 0;
+            failedSteps     = 0;
+            overruns        = 0;
+            maxJitter       = 0;
+            totalJitter     = 0;
+            jitterSamples   = 0;
+        }
+    };
+    // ####################################### BLACKPWMSEQUENCERSTATS DECLARATION ENDS ######################################## //
+
+
+
+
+    // ####################################### BLACKPWMSEQUENCER DECLARATION STARTS ######################################### //
+
+    /*! @brief Plays precomputed waveform tables on pwm channels from a real-time thread.
+     *
+     *    This class applies a table of BlackPWMStep entries to one or more BlackPWM objects from its own
+     *    thread. Step deadlines are absolute @b CLOCK_MONOTONIC times and the thread waits with
+     *    BlackThread::parkUntil(), so waiting errors don't accumulate and requestStop() ends a hold at
+     *    once. Changes of a step group are written with BlackPWMGroup. Wakeup jitter of each step is
+     *    recorded and can be read while the sequence is playing.
+     *
+     * @par Example
+     * @code{.cpp}
+     *  // Filename: myServoRamp.cpp
+     *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+     *
+     *  #include <iostream>
+     *  #include "BlackLib/BlackPWMSequencer/BlackPWMSequencer.h"
+     *
+     *  int main()
+     *  {
+     *      BlackLib::BlackPWM          servo(BlackLib::EHRPWM2A);
+     *      BlackLib::BlackPWMSequencer sequencer;
+     *
+     *      unsigned int ch = sequencer.addChannel(servo);
+     *
+     *      // 20 ms period, ramp from 5% to 10% in 1% steps, 100 ms each
+     *      for( int i = 5 ; i <= 10 ; i++ )
+     *      {
+     *          sequencer.addStep( BlackLib::BlackPWMStep(ch, i, 20000000, 100000000) );
+     *      }
+     *
+     *      sequencer.start();
+     *      WAIT_THREAD_FINISH(&sequencer)
+     *
+     *      BlackLib::BlackPWMSequencerStats stats = sequencer.getStatistics();
+     *      std::cout << "Max jitter: " << stats.maxJitter << " ns" << std::endl;
+     *
+     *      return 0;
+     *  }
+     * @endcode
+     */
+    class BlackPWMSequencer : public BlackThread
+    {
+        private:
+            BlackPWMGroup               pwmGroup;           /*!< @brief is used to hold the group which writes the step changes */
+            std::vector<BlackPWM*>      channels;           /*!< @brief is used to hold the pwm objects of sequencer */
+            std::vector<BlackPWMStep>   steps;              /*!< @brief is used to hold the waveform table */
+            unsigned int                repeatCount;        /*!< @brief is used to hold the table repeat count, zero means forever */
+
+            BlackPWMSequencerStats      statistics;         /*!< @brief is used to hold the timing report */
+            BlackMutex                  statisticsMutex;    /*!< @brief is used to protect the timing report */
+
+            /*! @brief Plays the waveform table.
+            *
+            *  This function is called from the sequencer thread.
+            */
+            void                        onStartHandler();
+
+            /*! @brief Records wakeup jitter of a step.
+            *
+            *  @param [in] stepIndex       index of step at table
+            *  @param [in] jitter          wakeup jitter in nanoseconds
+            *  @param [in] isOverrun       wakeup is later than next deadline
+            */
+            void                        recordJitter(size_t stepIndex, int64_t jitter, bool isOverrun);
+
+
+        public:
+            /*! @brief Constructor of BlackPWMSequencer class.
+            *
+            * @param [in] tp            priority of sequencer thread, default is BlackThread::PriorityHIGHEST
+            * @param [in] mode          update mode of internal BlackPWMGroup
+            */
+                                        BlackPWMSequencer(BlackThread::priority tp = BlackThread::PriorityHIGHEST,
+                                                          pwmGroupMode mode = GroupSysfs);
+
+            /*! @brief Destructor of BlackPWMSequencer class.
+            *
+            * This function requests stop and waits the sequencer thread.
+            */
+            virtual                     ~BlackPWMSequencer();
+
+            /*! @brief Adds pwm object to sequencer.
+            *
+            * The pwm object must live longer than sequencer. Channels can't be added while playing.
+            * @param [in] pwm           pwm object
+            * @return Channel index of pwm object which is used at BlackPWMStep::channel.
+            */
+            unsigned int                addChannel(BlackPWM &pwm);
+
+            /*! @brief Appends a step to the waveform table.
+            *
+            * @param [in] step          new step
+            * @return True if channel index of step is valid and sequencer isn't playing, else false.
+            */
+            bool                        addStep(const BlackPWMStep &step);
+
+            /*! @brief Removes all steps from the waveform table.
+            *
+            * @return True if sequencer isn't playing, else false.
+            */
+            bool                        clearSteps();
+
+            /*! @brief Sets repeat count of the waveform table.
+            *
+            * @param [in] count         repeat count, zero means forever
+            */
+            void                        setRepeatCount(unsigned int count);
+
+            /*! @brief Starts playing the waveform table.
+            *
+            * This function clears timing report and runs the sequencer thread.
+            * @return True if thread is running, else false.
+            */
+            bool                        start();
+
+            /*! @brief Exports timing report.
+            *
+            * This function can be called while sequence is playing.
+            * @return Copy of the timing report.
+            */
+            BlackPWMSequencerStats      getStatistics();
+    };
+    // ######################################## BLACKPWMSEQUENCER DECLARATION ENDS ########################################## //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKPWMSEQUENCER_H_ */
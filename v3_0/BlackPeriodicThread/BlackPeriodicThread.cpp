@@ -0,0 +1,195 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackPeriodicThread.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ####################################### BLACKPERIODICTHREAD DEFINITION STARTS ######################################## //
+    BlackPeriodicThread::BlackPeriodicThread(uint64_t period_ns)
+    {
+        this->periodNs              = period_ns;
+        this->isMemoryLockEnabled   = false;
+        this->stackPrefaultSize     = 64 * 1024;
+    }
+
+    BlackPeriodicThread::~BlackPeriodicThread()
+    {
+        this->requestStop();
+        this->waitUntilFinish();
+    }
+
+    void        BlackPeriodicThread::setPeriod(uint64_t period_ns)
+    {
+        this->periodNs = period_ns;
+    }
+
+    uint64_t    BlackPeriodicThread::getPeriod()
+    {
+        return this->periodNs;
+    }
+
+    void        BlackPeriodicThread::setMemoryLock(bool isEnabled)
+    {
+        this->isMemoryLockEnabled = isEnabled;
+    }
+
+    void        BlackPeriodicThread::setStackPrefaultSize(size_t bytes)
+    {
+        this->stackPrefaultSize = bytes;
+    }
+
+    void        BlackPeriodicThread::resetStatistics()
+    {
+        this->statisticsMutex.lock();
+        bool isLocked       = this->statistics.isMemoryLocked;
+        this->statistics    = BlackPeriodicThreadStats();
+        this->statistics.isMemoryLocked = isLocked;
+        this->statisticsMutex.unlock();
+    }
+
+    BlackPeriodicThreadStats BlackPeriodicThread::getStatistics()
+    {
+        this->statisticsMutex.lock();
+        BlackPeriodicThreadStats copy = this->statistics;
+        this->statisticsMutex.unlock();
+
+        return copy;
+    }
+
+    void        BlackPeriodicThread::prefaultStack(size_t bytes)
+    {
+        if( bytes == 0 )
+        {
+            return;
+        }
+
+        volatile unsigned char *stack = static_cast<volatile unsigned char*>(alloca(bytes));
+        for( size_t i = 0 ; i < bytes ; i += 4096 )
+        {
+            stack[i] = 0;
+        }
+        stack[bytes - 1] = 0;
+    }
+
+    void        BlackPeriodicThread::recordCycle(int64_t latency, uint64_t missed)
+    {
+        uint64_t micros = (latency > 0) ? static_cast<uint64_t>(latency) / 1000 : 0;
+        unsigned int bucket = 0;
+        while( micros > 1 and bucket < BlackPeriodicThreadStats::latencyBucketCount - 1 )
+        {
+            micros >>= 1;
+            bucket++;
+        }
+
+        this->statisticsMutex.lock();
+
+        if( this->statistics.cycles == 0 or latency < this->statistics.latencyMin )
+        {
+            this->statistics.latencyMin = latency;
+        }
+
+        if( this->statistics.cycles == 0 or latency > this->statistics.latencyMax )
+        {
+            this->statistics.latencyMax = latency;
+        }
+
+        this->statistics.cycles                    += 1;
+        this->statistics.overruns                  += missed;
+        this->statistics.latencyTotal              += latency;
+        this->statistics.latencyHistogram[bucket]  += 1;
+
+        this->statisticsMutex.unlock();
+    }
+
+    void        BlackPeriodicThread::onStartHandler()
+    {
+        bool isLocked = false;
+        if( this->isMemoryLockEnabled )
+        {
+            isLocked = (mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+        }
+
+        prefaultStack(this->stackPrefaultSize);
+
+        this->statisticsMutex.lock();
+        this->statistics.isMemoryLocked = isLocked;
+        this->statisticsMutex.unlock();
+
+
+        timespec deadline;
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        while( not this->isStopRequested() )
+        {
+            uint64_t period      = this->periodNs;
+            uint64_t nanoseconds = deadline.tv_nsec + period;
+            deadline.tv_sec     += nanoseconds / 1000000000;
+            deadline.tv_nsec     = nanoseconds % 1000000000;
+
+            while( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR )
+            {
+            }
+
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            int64_t latency = static_cast<int64_t>(now.tv_sec - deadline.tv_sec) * 1000000000LL
+                            + (now.tv_nsec - deadline.tv_nsec);
+
+            // skip the deadlines which already passed instead of running a burst of late cycles
+            uint64_t missed = 0;
+            if( period > 0 and latency >= static_cast<int64_t>(period) )
+            {
+                missed               = static_cast<uint64_t>(latency) / period;
+                nanoseconds          = deadline.tv_nsec + missed * period;
+                deadline.tv_sec     += nanoseconds / 1000000000;
+                deadline.tv_nsec     = nanoseconds % 1000000000;
+            }
+
+            this->recordCycle(latency, missed);
+
+            if( this->isStopRequested() )
+            {
+                break;
+            }
+
+            this->onStepHandler();
+        }
+    }
+    // ######################################## BLACKPERIODICTHREAD DEFINITION ENDS ######################################### //
+
+
+} /* namespace BlackLib */
@@ -0,0 +1,238 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKPERIODICTHREAD_H_
+#define BLACKPERIODICTHREAD_H_
+
+#include "../BlackThread/BlackThread.h"
+#include "../BlackMutex/BlackMutex.h"
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <time.h>
+#include <alloca.h>
+#include <sys/mman.h>
+
+
+
+namespace BlackLib
+{
+
+    // ###################################### BLACKPERIODICTHREADSTATS DECLARATION STARTS ###################################### //
+
+    /*! @brief Holds timing report of BlackPeriodicThread.
+     *
+     *    Wakeup latency is the difference between the scheduled and the real wakeup time of a cycle.
+     *    Histogram bucket @a i holds the latencies in the range [2^i, 2^(i+1)) microseconds, the first
+     *    bucket also holds latencies under 1 us and the last bucket holds all latencies which don't fit
+     *    to the others.
+     *    @sa BlackPeriodicThread::getStatistics()
+     */
+    struct BlackPeriodicThreadStats
+    {
+        static const unsigned int latencyBucketCount = 16;  /*!< @brief is used to hold the bucket count of latency histogram */
+
+        uint64_t        cycles;                             /*!< @brief is used to hold the executed cycle count */
+        uint64_t        overruns;                           /*!< @brief is used to hold the count of missed deadlines */
+        int64_t         latencyMin;                         /*!< @brief is used to hold the minimum wakeup latency in nanoseconds */
+        int64_t         latencyMax;                         /*!< @brief is used to hold the maximum wakeup latency in nanoseconds */
+        int64_t         latencyTotal;                       /*!< @brief is used to hold the sum of wakeup latencies in nanoseconds */
+        uint64_t        latencyHistogram[latencyBucketCount];   /*!< @brief is used to hold the wakeup latency histogram */
+        bool            isMemoryLocked;                     /*!< @brief is used to hold the mlockall() result */
+
+        /*! @brief Default constructor of BlackPeriodicThreadStats struct.
+         *
+         *  This function clears all counters.
+         */
+        BlackPeriodicThreadStats()
+        {
+            cycles          = 0;
+            overruns        = 0;
+            latencyMin      = 0;
+            latencyMax      = 0;
+            latencyTotal    = 0;
+            isMemoryLocked  = false;
+
+            memset(latencyHistogram, 0, sizeof(latencyHistogram));
+        }
+    };
+    // ####################################### BLACKPERIODICTHREADSTATS DECLARATION ENDS ####################################### //
+
+
+
+
+    // ######################################## BLACKPERIODICTHREAD DECLARATION STARTS ######################################### //
+
+    /*! @brief Interface class for fixed-rate real-time tasks.
+    *
+    *    This class runs users' onStepHandler() function at a fixed period. Cycle deadlines are absolute
+    *    @b CLOCK_MONOTONIC times and the thread waits with clock_nanosleep(TIMER_ABSTIME), so the period
+    *    doesn't drift with the execution time of step function. Before the first cycle, the thread can
+    *    lock the process memory with mlockall() and prefault its stack, so page faults don't happen in
+    *    the loop. Missed deadlines are counted as overruns and skipped, and the wakeup
+    *    latency of each cycle is recorded to a histogram.
+    *
+    *    Users have to derive their own class from BlackPeriodicThread and implement onStepHandler().
+    *    Scheduling priority, policy and cpu affinity are set with BlackThread::setPriority(),
+    *    BlackThread::setPolicy() and BlackThread::setCpuAffinity().
+    *
+    * @par Example
+    * @code{.cpp}
+    *  // Filename: myControlLoop.cpp
+    *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+    *
+    *  #include <iostream>
+    *  #include "BlackLib/BlackPeriodicThread/BlackPeriodicThread.h"
+    *
+    *  class ControlLoop : public BlackLib::BlackPeriodicThread
+    *  {
+    *       public:
+    *           ControlLoop() : BlackLib::BlackPeriodicThread(1000000) {}
+    *
+    *           void onStepHandler()
+    *           {
+    *               // read sensors, calculate and update outputs here
+    *           }
+    *  };
+    *
+    *  int main()
+    *  {
+    *       ControlLoop *loop = new ControlLoop();
+    *
+    *       loop->setPolicy(BlackLib::BlackThread::PolicyFIFO);
+    *       loop->setPriority(BlackLib::BlackThread::PriorityHIGHEST);
+    *       loop->setCpuAffinity(1);
+    *       loop->setMemoryLock(true);
+    *       loop->run();
+    *
+    *       BlackLib::BlackThread::sleep(10);
+    *       loop->requestStop();
+    *       WAIT_THREAD_FINISH(loop)
+    *
+    *       BlackLib::BlackPeriodicThreadStats stats = loop->getStatistics();
+    *       std::cout << "Cycles: " << stats.cycles << ", overruns: " << stats.overruns
+    *                 << ", max latency: " << stats.latencyMax << " ns" << std::endl;
+    *
+    *       return 0;
+    *  }
+    * @endcode
+    */
+    class BlackPeriodicThread : public BlackThread
+    {
+        public:
+            /*! @brief Constructor of BlackPeriodicThread class.
+            *
+            * @param [in] period_ns     cycle period in nanoseconds
+            */
+                                        BlackPeriodicThread(uint64_t period_ns);
+
+            /*! @brief Destructor of BlackPeriodicThread class.
+            */
+            virtual                     ~BlackPeriodicThread();
+
+            /*! @brief Changes cycle period.
+            *
+            * New period is used from the next cycle.
+            * @param [in] period_ns     cycle period in nanoseconds
+            */
+            void                        setPeriod(uint64_t period_ns);
+
+            /*! @brief Exports cycle period.
+            *
+            * @return Cycle period in nanoseconds.
+            */
+            uint64_t                    getPeriod();
+
+            /*! @brief Enables locking all current and future memory of process with mlockall().
+            *
+            * This setting is applied when the thread starts.
+            * @param [in] isEnabled     lock memory or not
+            */
+            void                        setMemoryLock(bool isEnabled);
+
+            /*! @brief Sets stack size which will be touched before the first cycle.
+            *
+            * This setting is applied when the thread starts. Default value is 64 KB.
+            * @param [in] bytes         prefault size, zero disables prefaulting
+            */
+            void                        setStackPrefaultSize(size_t bytes);
+
+            /*! @brief Clears timing report.
+            */
+            void                        resetStatistics();
+
+            /*! @brief Exports timing report.
+            *
+            * This function can be called while thread is running.
+            * @return Copy of the timing report.
+            */
+            BlackPeriodicThreadStats    getStatistics();
+
+
+        private:
+            volatile uint64_t           periodNs;               /*!< @brief is used to hold the cycle period in nanoseconds */
+            bool                        isMemoryLockEnabled;    /*!< @brief is used to hold the mlockall() setting */
+            size_t                      stackPrefaultSize;      /*!< @brief is used to hold the stack prefault size */
+
+            BlackPeriodicThreadStats    statistics;             /*!< @brief is used to hold the timing report */
+            BlackMutex                  statisticsMutex;        /*!< @brief is used to protect the timing report */
+
+            /*! @brief Users' cyclic function.
+            *
+            *  This function has to overload at user's derived class. It is called once at every period.
+            */
+            virtual void                onStepHandler() = 0;
+
+            /*! @brief Prepares the thread and runs the cycle loop.
+            *
+            *  Users should not call or override this function.
+            */
+            void                        onStartHandler();
+
+            /*! @brief Touches stack memory.
+            *
+            *  @param [in] bytes        touched size
+            */
+            static void                 prefaultStack(size_t bytes);
+
+            /*! @brief Records wakeup latency of a cycle.
+            *
+            *  @param [in] latency      wakeup latency in nanoseconds
+            *  @param [in] missed       missed period count before this cycle
+            */
+            void                        recordCycle(int64_t latency, uint64_t missed);
+    };
+    // ######################################### BLACKPERIODICTHREAD DECLARATION ENDS ########################################## //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKPERIODICTHREAD_H_ */
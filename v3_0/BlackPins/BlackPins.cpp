@@ -0,0 +1,65 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackPins.h"
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKPINMASK DEFINITION STARTS ######################################### //
+    std::string BlackPinMask::toString() const
+    {
+        std::string names;
+
+        for( unsigned header = 8 ; header <= 9 ; header++ )
+        {
+            uint64_t headerMask = (header == 8) ? this->p8Mask : this->p9Mask;
+
+            for( unsigned number = 1 ; number <= 46 ; number++ )
+            {
+                if( headerMask & (1ULL << (number - 1)) )
+                {
+                    if( not names.empty() )
+                    {
+                        names += ' ';
+                    }
+                    names += "P" + intToString(header) + "_" + intToString(number);
+                }
+            }
+        }
+
+        return names;
+    }
+    // ############################################ BLACKPINMASK DEFINITION ENDS ########################################## //
+
+} /* namespace BlackLib */
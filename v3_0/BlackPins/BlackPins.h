@@ -0,0 +1,503 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKPINS_H_
+#define BLACKPINS_H_
+
+#include "../BlackCore.h"
+#include "../BlackGPIO/BlackGPIO.h"
+#include "../BlackADC/BlackADC.h"
+#include "../BlackPWM/BlackPWM.h"
+#include "../BlackSPI/BlackSPI.h"
+#include "../BlackI2C/BlackI2C.h"
+#include "../BlackUART/BlackUART.h"
+
+#include <string>
+#include <cstdint>
+
+
+
+namespace BlackLib
+{
+
+    /*!
+    * This array is used for mapping gpio number to expansion header pin. Values are encoded as
+    * header * 100 + pin number (e.g. 912 is P9_12). Zero means the gpio isn't routed to P8 or P9.
+    */
+    constexpr uint16_t gpioHeaderPins[128] = {
+                                                          0,   0, 922, 921, 918, 917,   0, 942,     // 0 - 7
+                                                        835, 833, 831, 832, 920, 919, 926, 924,     // 8 - 15
+                                                          0,   0,   0,   0, 941,   0, 819, 813,     // 16 - 23
+                                                          0,   0, 814, 817,   0,   0, 911, 913,     // 24 - 31
+                                                        825, 824, 805, 806, 823, 822, 803, 804,     // 32 - 39
+                                                          0,   0,   0,   0, 812, 811, 816, 815,     // 40 - 47
+                                                        915, 923, 914, 916,   0,   0,   0,   0,     // 48 - 55
+                                                          0,   0,   0,   0, 912, 826, 821, 820,     // 56 - 63
+                                                          0, 818, 807, 808, 810, 809, 845, 846,     // 64 - 71
+                                                        843, 844, 841, 842, 839, 840, 837, 838,     // 72 - 79
+                                                        836, 834,   0,   0,   0,   0, 827, 829,     // 80 - 87
+                                                        828, 830,   0,   0,   0,   0,   0,   0,     // 88 - 95
+                                                          0,   0,   0,   0,   0,   0,   0,   0,     // 96 - 103
+                                                          0,   0,   0,   0,   0,   0, 931, 929,     // 104 - 111
+                                                        930, 928, 942, 927, 941, 925,   0,   0,     // 112 - 119
+                                                          0,   0,   0,   0,   0,   0,   0,   0     // 120 - 127
+                                             };
+
+    /*!
+    * This array is used for mapping pwm name to expansion header pin.
+    */
+    constexpr uint16_t pwmHeaderPins[7]     = { 813, 819, 914, 916, 921, 922, 942 };
+
+    /*!
+    * This array is used for mapping pwm name to pinmux mode.
+    */
+    constexpr uint8_t  pwmMuxModes[7]       = { 4, 4, 6, 6, 3, 3, 0 };
+
+    /*!
+    * This array is used for mapping adc name to expansion header pin. Analog inputs aren't muxed.
+    */
+    constexpr uint16_t adcHeaderPins[7]     = { 939, 940, 937, 938, 933, 936, 935 };
+
+    /*!
+    * These arrays are used for mapping uart name to TX/RX expansion header pins and pinmux mode.
+    * They are indexed by uart number, unused numbers are zero.
+    */
+    constexpr uint16_t uartTxHeaderPins[6]  = { 0, 924, 921, 0, 913, 837 };
+    constexpr uint16_t uartRxHeaderPins[6]  = { 0, 926, 922, 0, 911, 838 };
+    constexpr uint8_t  uartMuxModes[6]      = { 0, 0,   1,   0, 6,   4   };
+
+    /*!
+    * These arrays are used for mapping spi bus to SCLK, D0 and D1 expansion header pins and pinmux mode,
+    * and spi name to chip select pin. Chip select 1 of SPI0 isn't routed to expansion headers.
+    */
+    constexpr uint16_t spiBusHeaderPins[2][3]   = { { 922, 921, 918 }, { 931, 929, 930 } };
+    constexpr uint8_t  spiMuxModes[2]           = { 0, 3 };
+    constexpr uint16_t spiCsHeaderPins[4]       = { 917, 0, 928, 942 };
+
+    /*!
+    * These arrays are used for mapping i2c name to SCL/SDA expansion header pins. I2C_0 is the
+    * on-board bus, I2C_1 is the I2C2 module of the processor.
+    */
+    constexpr uint16_t i2cSclHeaderPins[2]  = { 0, 919 };
+    constexpr uint16_t i2cSdaHeaderPins[2]  = { 0, 920 };
+
+
+
+
+    // ########################################## BLACKPINMASK DECLARATION STARTS ######################################### //
+
+    /*! @brief Set of P8 and P9 expansion header pins.
+    *
+    *    This class is a literal type, so pin sets of peripherals can be built and compared at compile
+    *    time. Each header is held as a 64 bit mask, bit 0 is pin 1.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   // fails to compile, UART2 uses P9_21 and P9_22
+    *   static_assert( BlackLib::arePinsFree( BlackLib::uartPins(BlackLib::UART2),
+    *                                         BlackLib::pwmPins(BlackLib::P9_22),
+    *                                         BlackLib::gpioPins(BlackLib::GPIO_60) ), "pin conflict");
+    *
+    *   // eMMC pins can't be used while the board boots from eMMC
+    *   static_assert( not BlackLib::gpioPins(BlackLib::GPIO_38).overlaps(BlackLib::boardEmmcPins()), "eMMC pin");
+    *
+    *   std::cout << BlackLib::spiPins(BlackLib::SPI1_1).toString() << std::endl;   // P9_29 P9_30 P9_31 P9_42
+    * @endcode
+    */
+    class BlackPinMask
+    {
+        private:
+            uint64_t                p8Mask;             /*!< @brief is used to hold the P8 header pins */
+            uint64_t                p9Mask;             /*!< @brief is used to hold the P9 header pins */
+
+        public:
+            /*! @brief Constructor of BlackPinMask class, it creates empty set.
+            */
+            constexpr               BlackPinMask() : p8Mask(0), p9Mask(0) {}
+
+            /*! @brief Constructor of BlackPinMask class with header masks.
+            *
+            *  @param[in] p8 mask of P8 header pins
+            *  @param[in] p9 mask of P9 header pins
+            */
+            constexpr               BlackPinMask(uint64_t p8, uint64_t p9) : p8Mask(p8), p9Mask(p9) {}
+
+            /*! @brief Creates set of one pin from encoded header pin.
+            *
+            *  @param[in] headerPin header * 100 + pin number, zero creates empty set
+            *  @return BlackPinMask which holds the pin.
+            */
+            static constexpr BlackPinMask fromHeaderPin(unsigned headerPin)
+            {
+                return BlackPinMask( (headerPin / 100 == 8) ? (1ULL << (headerPin % 100 - 1)) : 0,
+                                     (headerPin / 100 == 9) ? (1ULL << (headerPin % 100 - 1)) : 0 );
+            }
+
+            /*! @brief Exports P8 header mask.
+            */
+            constexpr uint64_t      getP8Mask() const { return this->p8Mask; }
+
+            /*! @brief Exports P9 header mask.
+            */
+            constexpr uint64_t      getP9Mask() const { return this->p9Mask; }
+
+            /*! @brief Checks the set is empty or not.
+            */
+            constexpr bool          isEmpty() const { return (this->p8Mask == 0 and this->p9Mask == 0); }
+
+            /*! @brief Checks the sets have common pins or not.
+            *
+            *  @param[in] other other pin set
+            *  @return True if any pin is in both of the sets, else false.
+            */
+            constexpr bool          overlaps(const BlackPinMask &other) const
+            {
+                return ((this->p8Mask & other.p8Mask) != 0 or (this->p9Mask & other.p9Mask) != 0);
+            }
+
+            /*! @brief Merges two pin sets.
+            */
+            constexpr BlackPinMask  operator|(const BlackPinMask &other) const
+            {
+                return BlackPinMask(this->p8Mask | other.p8Mask, this->p9Mask | other.p9Mask);
+            }
+
+            /*! @brief Exports pin names of the set.
+            *
+            *  @return Pin names like "P8_13 P9_22", separated by space.
+            */
+            std::string             toString() const;
+    };
+    // ########################################### BLACKPINMASK DECLARATION ENDS ########################################## //
+
+
+
+
+    /*! @brief Exports expansion header pin of gpio, encoded as header * 100 + pin number.
+    */
+    constexpr unsigned      gpioHeaderPin(gpioName pin)     { return (static_cast<unsigned>(pin) < 128) ? gpioHeaderPins[pin] : 0; }
+
+    /*! @brief Exports gpio bank (module) number of gpio.
+    */
+    constexpr unsigned      gpioBank(gpioName pin)          { return static_cast<unsigned>(pin) / 32; }
+
+    /*! @brief Exports bit number of gpio in its bank.
+    */
+    constexpr unsigned      gpioBit(gpioName pin)           { return static_cast<unsigned>(pin) % 32; }
+
+    /*! @brief Exports register mask of gpio in its bank.
+    */
+    constexpr uint32_t      gpioMask(gpioName pin)          { return (1U << gpioBit(pin)); }
+
+    /*! @brief Exports pinmux mode of gpio.
+    */
+    constexpr unsigned      gpioMuxMode(gpioName)           { return 7; }
+
+    /*! @brief Exports pin set of gpio.
+    */
+    constexpr BlackPinMask  gpioPins(gpioName pin)          { return BlackPinMask::fromHeaderPin(gpioHeaderPin(pin)); }
+
+    /*! @brief Exports pinmux mode of pwm.
+    */
+    constexpr unsigned      pwmMuxMode(pwmName pwm)         { return pwmMuxModes[pwm]; }
+
+    /*! @brief Exports pin set of pwm.
+    */
+    constexpr BlackPinMask  pwmPins(pwmName pwm)            { return BlackPinMask::fromHeaderPin(pwmHeaderPins[pwm]); }
+
+    /*! @brief Exports pin set of analog input.
+    */
+    constexpr BlackPinMask  adcPins(adcName adc)            { return BlackPinMask::fromHeaderPin(adcHeaderPins[adc]); }
+
+    /*! @brief Exports pinmux mode of uart.
+    */
+    constexpr unsigned      uartMuxMode(uartName uart)      { return uartMuxModes[uart]; }
+
+    /*! @brief Exports pin set of uart, TX and RX pins.
+    */
+    constexpr BlackPinMask  uartPins(uartName uart)
+    {
+        return BlackPinMask::fromHeaderPin(uartTxHeaderPins[uart]) | BlackPinMask::fromHeaderPin(uartRxHeaderPins[uart]);
+    }
+
+    /*! @brief Exports pinmux mode of spi bus pins.
+    */
+    constexpr unsigned      spiMuxMode(spiName spi)         { return spiMuxModes[spi / 2]; }
+
+    /*! @brief Exports pin set of spi, SCLK, D0, D1 and chip select pins.
+    */
+    constexpr BlackPinMask  spiPins(spiName spi)
+    {
+        return BlackPinMask::fromHeaderPin(spiBusHeaderPins[spi / 2][0]) | BlackPinMask::fromHeaderPin(spiBusHeaderPins[spi / 2][1])
+             | BlackPinMask::fromHeaderPin(spiBusHeaderPins[spi / 2][2]) | BlackPinMask::fromHeaderPin(spiCsHeaderPins[spi]);
+    }
+
+    /*! @brief Exports pinmux mode of i2c.
+    */
+    constexpr unsigned      i2cMuxMode(i2cName)             { return 3; }
+
+    /*! @brief Exports pin set of i2c, SCL and SDA pins.
+    */
+    constexpr BlackPinMask  i2cPins(i2cName i2c)
+    {
+        return BlackPinMask::fromHeaderPin(i2cSclHeaderPins[i2c]) | BlackPinMask::fromHeaderPin(i2cSdaHeaderPins[i2c]);
+    }
+
+    /*! @brief Exports pin set which is used by on-board eMMC (P8_3 - P8_6 and P8_20 - P8_25).
+    */
+    constexpr BlackPinMask  boardEmmcPins()                 { return BlackPinMask(0x0000000001F8003CULL, 0); }
+
+    /*! @brief Exports pin set which is used by on-board HDMI framer (P8_27 - P8_46, and audio pins P9_25, P9_28, P9_29 and P9_31).
+    */
+    constexpr BlackPinMask  boardHdmiPins()                 { return BlackPinMask(0x00003FFFFC000000ULL, 0x0000000059000000ULL); }
+
+    /*! @brief Merges pin sets, the last overload of combinePins().
+    */
+    constexpr BlackPinMask  combinePins()                   { return BlackPinMask(); }
+
+    /*! @brief Merges pin sets.
+    */
+    template <typename... masks>
+    constexpr BlackPinMask  combinePins(const BlackPinMask &first, const masks&... rest)
+    {
+        return first | combinePins(rest...);
+    }
+
+    /*! @brief Checks pin sets, the last overload of arePinsFree().
+    */
+    constexpr bool          arePinsFree()                   { return true; }
+
+    /*! @brief Checks pin sets are disjoint or not.
+    *
+    *  It can be used in static_assert, so pin conflicts are found at compile time.
+    *  @return True if no pin is used by two of the sets, else false.
+    */
+    template <typename... masks>
+    constexpr bool          arePinsFree(const BlackPinMask &first, const masks&... rest)
+    {
+        return (not first.overlaps(combinePins(rest...)) and arePinsFree(rest...));
+    }
+
+
+
+
+    /*! @brief Null terminated string which is built at compile time from characters.
+    */
+    template <char... characters>
+    struct BlackPinString
+    {
+        static const char   value[sizeof...(characters) + 1];   /*!< @brief is used to hold the characters */
+    };
+
+    template <char... characters>
+    const char BlackPinString<characters...>::value[sizeof...(characters) + 1] = { characters..., '\0' };
+
+    /*! @brief Builds sysfs paths of gpio at compile time, digits of the number are collected to template parameters.
+    */
+    template <unsigned number, char... digits>
+    struct BlackGpioPaths
+    {
+        typedef typename BlackGpioPaths<number / 10, static_cast<char>('0' + number % 10), digits...>::valuePath       valuePath;
+        typedef typename BlackGpioPaths<number / 10, static_cast<char>('0' + number % 10), digits...>::directionPath   directionPath;
+    };
+
+    template <char... digits>
+    struct BlackGpioPaths<0, digits...>
+    {
+        typedef BlackPinString<'/','s','y','s','/','c','l','a','s','s','/','g','p','i','o','/','g','p','i','o',
+                               digits..., '/','v','a','l','u','e'>                                                    valuePath;
+        typedef BlackPinString<'/','s','y','s','/','c','l','a','s','s','/','g','p','i','o','/','g','p','i','o',
+                               digits..., '/','d','i','r','e','c','t','i','o','n'>                                    directionPath;
+    };
+
+
+
+
+    // ########################################## BLACKGPIOPIN DECLARATION STARTS ######################################### //
+
+    /*! @brief GPIO pin which is selected at compile time.
+    *
+    *    This class is a BlackGPIO, so exporting, direction setting and sysfs reading/writing work same.
+    *    Bank, bit mask, header pin and sysfs paths of the pin are compile time constants. Additionally
+    *    it reads and writes the pin from GPIO registers of the processor, which are mapped from /dev/mem
+    *    once per process by BlackBoard class. Register mask and offsets are folded by compiler, so a
+    *    fast write is one store instruction. Fast functions don't check pin ready state and don't update
+    *    error flags, trace records and metrics of the object.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   BlackLib::BlackGPIOPin<BlackLib::GPIO_60> led(BlackLib::output);
+    *
+    *   static_assert( BlackLib::BlackGPIOPin<BlackLib::GPIO_60>::headerPin == 912, "GPIO_60 is P9_12");
+    *
+    *   for( int i = 0 ; i < 1000 ; i++ )
+    *   {
+    *       led.tryFastSetValue(BlackLib::high);
+    *       led.tryFastSetValue(BlackLib::low);
+    *   }
+    *
+    *   std::cout << led.getSysfsValuePath() << std::endl;     // "/sys/class/gpio/gpio60/value"
+    * @endcode
+    */
+    template <gpioName pin>
+    class BlackGPIOPin : public BlackGPIO
+    {
+        private:
+
+            /*!
+            * GPIO register offsets as 32 bit word index.
+            */
+            enum gpioRegister   {   DATAIN          = 0x138 / 4,
+                                    CLEARDATAOUT    = 0x190 / 4,
+                                    SETDATAOUT      = 0x194 / 4
+                                };
+
+            volatile uint32_t       *bankRegisters;         /*!< @brief is used to hold the mapped registers of the pin's bank */
+
+            /*! @brief Maps registers of the pin's bank, if they aren't mapped yet.
+            *
+            *  @return True if registers are mapped, else false.
+            *  @sa BlackBoard::getGpioRegisters()
+            */
+            bool                    mapRegisters();
+
+
+        public:
+            static const unsigned   bank        = gpioBank(pin);        /*!< @brief is used to hold the gpio bank number */
+            static const unsigned   bit         = gpioBit(pin);         /*!< @brief is used to hold the bit number in bank */
+            static const uint32_t   mask        = gpioMask(pin);        /*!< @brief is used to hold the register mask */
+            static const unsigned   headerPin   = gpioHeaderPin(pin);   /*!< @brief is used to hold the encoded header pin */
+
+            /*! @brief Constructor of BlackGPIOPin class.
+            *
+            * This function initializes BlackGPIO class with the template pin. Registers are mapped at the
+            * first fast read/write.
+            * @param [in] pd        gpio pin direction(enum)
+            * @param [in] wm        working mode of sysfs functions(enum), default value is SecureMode
+            */
+                                    BlackGPIOPin(direction pd, workingMode wm = SecureMode);
+
+            /*! @brief Exports pin set of the pin for compile time conflict checks.
+            */
+            static constexpr BlackPinMask getPins() { return gpioPins(pin); }
+
+            /*! @brief Exports value file path, it is built at compile time.
+            */
+            static const char       *getSysfsValuePath();
+
+            /*! @brief Exports direction file path, it is built at compile time.
+            */
+            static const char       *getSysfsDirectionPath();
+
+            /*! @brief Reads value of gpio pin from DATAIN register.
+            *
+            *  @return Pin value (0 or 1) or BlackError::OpenFailed with errno, if registers can't be mapped.
+            */
+            BlackResult<int>        tryFastGetValue();
+
+            /*! @brief Sets value of gpio pin by writing the mask to SETDATAOUT or CLEARDATAOUT register.
+            *
+            *  @param[in] v new pin value(enum)
+            *  @return BlackError::OutOfRange if pin isn't output, BlackError::OpenFailed with errno if
+            *  registers can't be mapped.
+            */
+            BlackResult<void>       tryFastSetValue(digitalValue v);
+    };
+    // ########################################### BLACKGPIOPIN DECLARATION ENDS ########################################## //
+
+
+
+
+    // ########################################## BLACKGPIOPIN DEFINITION STARTS ########################################## //
+
+    // BlackCoreGPIO is a private virtual base of BlackGPIO, so it has to be named from namespace scope
+    template <gpioName pin>
+    BlackGPIOPin<pin>::BlackGPIOPin(direction pd, workingMode wm) : BlackLib::BlackCoreGPIO(pin, pd), BlackGPIO(pin, pd, wm)
+    {
+        this->bankRegisters = NULL;
+    }
+
+    template <gpioName pin>
+    bool BlackGPIOPin<pin>::mapRegisters()
+    {
+        if( this->bankRegisters == NULL )
+        {
+            this->bankRegisters = BlackBoard::getDefault().getGpioRegisters(bank);
+        }
+
+        return (this->bankRegisters != NULL);
+    }
+
+    template <gpioName pin>
+    const char *BlackGPIOPin<pin>::getSysfsValuePath()
+    {
+        return BlackGpioPaths<pin / 10, static_cast<char>('0' + pin % 10)>::valuePath::value;
+    }
+
+    template <gpioName pin>
+    const char *BlackGPIOPin<pin>::getSysfsDirectionPath()
+    {
+        return BlackGpioPaths<pin / 10, static_cast<char>('0' + pin % 10)>::directionPath::value;
+    }
+
+    template <gpioName pin>
+    BlackResult<int> BlackGPIOPin<pin>::tryFastGetValue()
+    {
+        if( not this->mapRegisters() )
+        {
+            return BlackResult<int>(BlackError::OpenFailed, errno);
+        }
+
+        return BlackResult<int>( (this->bankRegisters[DATAIN] & mask) ? 1 : 0 );
+    }
+
+    template <gpioName pin>
+    BlackResult<void> BlackGPIOPin<pin>::tryFastSetValue(digitalValue v)
+    {
+        if( this->getDirection() != output )
+        {
+            return BlackResult<void>(BlackError::OutOfRange, 0);
+        }
+
+        if( not this->mapRegisters() )
+        {
+            return BlackResult<void>(BlackError::OpenFailed, errno);
+        }
+
+        this->bankRegisters[(v == high) ? SETDATAOUT : CLEARDATAOUT] = mask;
+        return BlackResult<void>();
+    }
+
+    // ########################################### BLACKGPIOPIN DEFINITION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKPINS_H_ */
@@ -0,0 +1,257 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackProcess.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ############################################ BLACKPROCESS DEFINITION STARTS ########################################### //
+    BlackProcessResult BlackProcess::run(const std::vector<std::string> &arguments, unsigned int timeoutMs, bool mergeStderr)
+    {
+        BlackProcessResult result;
+
+        if( arguments.empty() )
+        {
+            return result;
+        }
+
+        int outputPipe[2];
+        if( pipe2(outputPipe, O_CLOEXEC) != 0 )
+        {
+            return result;
+        }
+
+        std::vector<char*> argumentList;
+        argumentList.reserve(arguments.size() + 1);
+        for( size_t i = 0 ; i < arguments.size() ; i++ )
+        {
+            argumentList.push_back( const_cast<char*>(arguments[i].c_str()) );
+        }
+        argumentList.push_back(NULL);
+
+        posix_spawn_file_actions_t fileActions;
+        posix_spawn_file_actions_init(&fileActions);
+        posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_adddup2(&fileActions, outputPipe[1], STDOUT_FILENO);
+        if( mergeStderr )
+        {
+            posix_spawn_file_actions_adddup2(&fileActions, outputPipe[1], STDERR_FILENO);
+        }
+
+        // the child doesn't inherit real-time policy, blocked signals and ignored signals of the caller
+        short spawnFlags = POSIX_SPAWN_SETSCHEDULER | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+#ifdef POSIX_SPAWN_USEVFORK
+        spawnFlags      |= POSIX_SPAWN_USEVFORK;
+#endif
+
+        sched_param schedulingParameters;
+        schedulingParameters.sched_priority = 0;
+
+        sigset_t emptySignals;
+        sigset_t defaultSignals;
+        sigemptyset(&emptySignals);
+        sigfillset(&defaultSignals);
+
+        posix_spawnattr_t spawnAttributes;
+        posix_spawnattr_init(&spawnAttributes);
+        posix_spawnattr_setflags(&spawnAttributes, spawnFlags);
+        posix_spawnattr_setschedpolicy(&spawnAttributes, SCHED_OTHER);
+        posix_spawnattr_setschedparam(&spawnAttributes, &schedulingParameters);
+        posix_spawnattr_setsigmask(&spawnAttributes, &emptySignals);
+        posix_spawnattr_setsigdefault(&spawnAttributes, &defaultSignals);
+
+        pid_t pid;
+        int   spawnResult = posix_spawnp(&pid, argumentList[0], &fileActions, &spawnAttributes, &argumentList[0], environ);
+
+        posix_spawn_file_actions_destroy(&fileActions);
+        posix_spawnattr_destroy(&spawnAttributes);
+        ::close(outputPipe[1]);
+
+        if( spawnResult != 0 )
+        {
+            ::close(outputPipe[0]);
+            return result;
+        }
+
+        result.isStarted = true;
+
+
+        timespec deadline;
+        timespec *deadlinePtr = NULL;
+        if( timeoutMs > 0 )
+        {
+            ::clock_gettime(CLOCK_MONOTONIC, &deadline);
+            deadline.tv_sec  += timeoutMs / 1000;
+            deadline.tv_nsec += static_cast<long>(timeoutMs % 1000) * 1000000;
+            if( deadline.tv_nsec >= 1000000000 )
+            {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+            deadlinePtr = &deadline;
+        }
+
+        pollfd descriptor;
+        descriptor.fd       = outputPipe[0];
+        descriptor.events   = POLLIN;
+
+        char buffer[4096];
+        while( true )
+        {
+            descriptor.revents = 0;
+            int waitTime       = BlackProcess::remainingTime(deadlinePtr);
+            int pollResult     = (waitTime == 0) ? 0 : ::poll(&descriptor, 1, waitTime);
+
+            if( pollResult < 0 and errno == EINTR ) { continue; }
+            if( pollResult <= 0 ) { break; }
+
+            ssize_t readSize = ::read(outputPipe[0], buffer, sizeof(buffer));
+            if( readSize < 0 and errno == EINTR ) { continue; }
+            if( readSize <= 0 ) { break; }
+
+            result.output.append(buffer, static_cast<size_t>(readSize));
+        }
+
+        ::close(outputPipe[0]);
+
+        BlackProcess::waitChild(pid, deadlinePtr, result);
+        return result;
+    }
+
+    BlackProcessResult BlackProcess::run(const std::string &command, unsigned int timeoutMs, bool mergeStderr)
+    {
+        return BlackProcess::run(BlackProcess::splitArguments(command), timeoutMs, mergeStderr);
+    }
+
+    std::vector<std::string> BlackProcess::splitArguments(const std::string &command)
+    {
+        std::vector<std::string> arguments;
+        std::string              current;
+        bool                     hasArgument = false;
+        char                     quote       = '\0';
+
+        for( size_t i = 0 ; i < command.size() ; i++ )
+        {
+            char c = command[i];
+
+            if( quote != '\0' )
+            {
+                if( c == quote )                                                { quote = '\0'; }
+                else if( c == '\\' and quote == '"' and i+1 < command.size() )   { current += command[++i]; }
+                else                                                            { current += c; }
+            }
+            else
+            if( c == ' ' or c == '\t' )
+            {
+                if( hasArgument )
+                {
+                    arguments.push_back(current);
+                    current.clear();
+                    hasArgument = false;
+                }
+            }
+            else
+            {
+                hasArgument = true;
+
+                if( c == '\'' or c == '"' )                                     { quote = c; }
+                else if( c == '\\' and i+1 < command.size() )                   { current += command[++i]; }
+                else                                                            { current += c; }
+            }
+        }
+
+        if( hasArgument )
+        {
+            arguments.push_back(current);
+        }
+
+        return arguments;
+    }
+
+    void BlackProcess::waitChild(pid_t pid, const timespec *deadline, BlackProcessResult &result)
+    {
+        int status = 0;
+
+        while( true )
+        {
+            pid_t waitResult = ::waitpid(pid, &status, (deadline == NULL) ? 0 : WNOHANG);
+
+            if( waitResult == pid ) { break; }
+            if( waitResult < 0 and errno == EINTR ) { continue; }
+            if( waitResult < 0 ) { return; }
+
+            // the child closed its output but it is still running
+            if( BlackProcess::remainingTime(deadline) == 0 )
+            {
+                ::kill(pid, SIGKILL);
+                result.isTimedOut = true;
+                deadline = NULL;
+                continue;
+            }
+
+            timespec pause = { 0, 1000000 };
+            ::nanosleep(&pause, NULL);
+        }
+
+        if( WIFEXITED(status) )
+        {
+            result.exitCode     = WEXITSTATUS(status);
+        }
+        else if( WIFSIGNALED(status) )
+        {
+            result.signalNumber = WTERMSIG(status);
+        }
+    }
+
+    int BlackProcess::remainingTime(const timespec *deadline)
+    {
+        if( deadline == NULL )
+        {
+            return -1;
+        }
+
+        timespec now;
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+
+        long long int remaining = static_cast<long long int>(deadline->tv_sec - now.tv_sec) * 1000
+                                + (deadline->tv_nsec - now.tv_nsec) / 1000000;
+
+        return (remaining > 0) ? static_cast<int>(remaining) : 0;
+    }
+    // ############################################# BLACKPROCESS DEFINITION ENDS ############################################ //
+
+
+} /* namespace BlackLib */
@@ -0,0 +1,176 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKPROCESS_H_
+#define BLACKPROCESS_H_
+
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <spawn.h>
+#include <sched.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+
+
+namespace BlackLib
+{
+
+    // ########################################## BLACKPROCESSRESULT DECLARATION STARTS ######################################## //
+
+    /*! @brief Holds the result of a program which is run by BlackProcess.
+    */
+    struct BlackProcessResult
+    {
+        /*! @brief Default constructor of BlackProcessResult struct.
+         *
+         *  This function sets default value to variables.
+         */
+        BlackProcessResult()
+        {
+            isStarted       = false;
+            isTimedOut      = false;
+            exitCode        = -1;
+            signalNumber    = 0;
+        }
+
+        /*! @brief Checks the program is finished normally with zero exit code.
+        */
+        bool isSucceeded() const
+        {
+            return ( isStarted and not isTimedOut and exitCode == 0 );
+        }
+
+        bool            isStarted;          /*!< @brief is used to hold the program could be started or not */
+        bool            isTimedOut;         /*!< @brief is used to hold the program is killed because of timeout or not */
+        int             exitCode;           /*!< @brief is used to hold the exit code, -1 if the program didn't exit normally */
+        int             signalNumber;       /*!< @brief is used to hold the signal which terminated the program, 0 if it exited */
+        std::string     output;             /*!< @brief is used to hold the captured standard output */
+    };
+
+    // ########################################### BLACKPROCESSRESULT DECLARATION ENDS ######################################### //
+
+
+
+
+
+    // ############################################ BLACKPROCESS DECLARATION STARTS ########################################### //
+
+    /*! @brief Runs external programs without a shell.
+    *
+    *    Programs are started with posix_spawnp(), so the calling process isn't forked: the child
+    *    shares the parent's memory until exec and the page tables of a large process aren't copied.
+    *    This keeps program calls cheap for processes with big mappings or real-time threads. Standard
+    *    output is captured through a pipe, standard input is connected to /dev/null and the program is
+    *    killed if it doesn't finish in the given time. The program runs with SCHED_OTHER policy, an empty
+    *    signal mask and default signal actions, even if it is started from a real-time thread.
+    *
+    *    There isn't any shell, so pipes, redirections, variables and wildcards aren't supported. The
+    *    arguments are given to the program exactly.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   std::vector<std::string> arguments;
+    *   arguments.push_back("uname");
+    *   arguments.push_back("-r");
+    *
+    *   BlackLib::BlackProcessResult result = BlackLib::BlackProcess::run(arguments, 500);
+    *
+    *   if( result.isSucceeded() )
+    *   {
+    *       std::cout << "Kernel: " << result.output;
+    *   }
+    *
+    *   // simple command lines are split to the arguments, quotes are supported
+    *   result = BlackLib::BlackProcess::run("ls -la '/home/root/my logs'", 1000);
+    * @endcode
+    */
+    class BlackProcess
+    {
+        private:
+
+            /*! @brief Waits the child with a deadline and kills it at the deadline.
+            */
+            static void                     waitChild(pid_t pid, const timespec *deadline, BlackProcessResult &result);
+
+            /*! @brief Calculates the remaining milliseconds to a deadline, -1 if there isn't a deadline.
+            */
+            static int                      remainingTime(const timespec *deadline);
+
+
+        public:
+
+            /*! @brief Runs a program and captures its output.
+            *
+            *  The program is searched in PATH if its name doesn't include a slash.
+            *
+            *  @param [in] arguments        program name and its arguments
+            *  @param [in] timeoutMs        time limit in milliseconds, 0 means no limit
+            *  @param [in] mergeStderr      captures standard error with standard output if it is true
+            *  @return Result of the program.
+            */
+            static BlackProcessResult       run(const std::vector<std::string> &arguments, unsigned int timeoutMs = 0, bool mergeStderr = false);
+
+            /*! @brief Splits a command line and runs it.
+            *
+            *  @param [in] command          command line, see splitArguments()
+            *  @param [in] timeoutMs        time limit in milliseconds, 0 means no limit
+            *  @param [in] mergeStderr      captures standard error with standard output if it is true
+            *  @return Result of the program.
+            */
+            static BlackProcessResult       run(const std::string &command, unsigned int timeoutMs = 0, bool mergeStderr = false);
+
+            /*! @brief Splits a command line to the arguments.
+            *
+            *  Arguments are separated with spaces or tabs. Single or double quotes group the text
+            *  which includes spaces and backslash escapes the next character out of single quotes.
+            *
+            *  @param [in] command          command line
+            *  @return List of the arguments.
+            */
+            static std::vector<std::string> splitArguments(const std::string &command);
+    };
+
+    // ############################################# BLACKPROCESS DECLARATION ENDS ############################################ //
+
+
+
+} /* namespace BlackLib */
+
+#endif /* BLACKPROCESS_H_ */
@@ -0,0 +1,106 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackQueue.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKQUEUEEVENT DEFINITION STARTS ########################################## //
+    BlackQueueEvent::BlackQueueEvent()
+    {
+        this->counter = 0;
+        this->waiters = 0;
+    }
+
+    int BlackQueueEvent::prepareWait()
+    {
+        // full barrier, the condition check after this call can't be moved before the registration
+        __sync_fetch_and_add( &(this->waiters), 1);
+        return this->counter;
+    }
+
+    void BlackQueueEvent::wait(int key, unsigned int usec)
+    {
+        if( usec == 0 )
+        {
+            syscall(SYS_futex, &(this->counter), FUTEX_WAIT_PRIVATE, key, NULL, NULL, 0);
+            return;
+        }
+
+        timespec timeout;
+        timeout.tv_sec  = usec / 1000000;
+        timeout.tv_nsec = (usec % 1000000) * 1000;
+
+        syscall(SYS_futex, &(this->counter), FUTEX_WAIT_PRIVATE, key, &timeout, NULL, 0);
+    }
+
+    bool BlackQueueEvent::waitUntil(int key, const timespec &deadline)
+    {
+        // FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC time, so repeated waits don't extend the timeout
+        long result = syscall(SYS_futex, &(this->counter), FUTEX_WAIT_BITSET_PRIVATE, key, &deadline, NULL, FUTEX_BITSET_MATCH_ANY);
+
+        return not (result != 0 and errno == ETIMEDOUT);
+    }
+
+    void BlackQueueEvent::makeDeadline(timespec &deadline, unsigned int usec)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+        unsigned long long nanoseconds = deadline.tv_nsec + static_cast<unsigned long long>(usec) * 1000;
+        deadline.tv_sec    += nanoseconds / 1000000000;
+        deadline.tv_nsec    = nanoseconds % 1000000000;
+    }
+
+    void BlackQueueEvent::finishWait()
+    {
+        __sync_fetch_and_sub( &(this->waiters), 1);
+    }
+
+    void BlackQueueEvent::notify()
+    {
+        // pairs with the barrier at prepareWait(), the queue update is visible before waiters is read
+        __sync_synchronize();
+
+        if( this->waiters > 0 )
+        {
+            __sync_fetch_and_add( &(this->counter), 1);
+            syscall(SYS_futex, &(this->counter), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+        }
+    }
+    // ############################################ BLACKQUEUEEVENT DEFINITION ENDS ########################################### //
+
+
+} /* namespace BlackLib */
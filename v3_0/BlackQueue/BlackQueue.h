@@ -0,0 +1,735 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKQUEUE_H_
+#define BLACKQUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <cerrno>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+
+
+namespace BlackLib
+{
+    #define BLACKLIB_CACHE_LINE_SIZE    64      //!< Cache line size of Cortex-A8, it is used for separating the fields which are written by different threads.
+
+
+
+    // ########################################### BLACKQUEUEEVENT DECLARATION STARTS ######################################### //
+
+    /*! @brief Futex based wait/notify helper of the blocking queue functions.
+    *
+    *    Waiters register themselves, read the event counter, check their condition again and then
+    *    sleep only if the counter is not changed. notify() makes a system call only when there are
+    *    registered waiters, so non-blocking usage of the queues never enters the kernel.
+    *    Users don't need to use this class directly.
+    */
+    class BlackQueueEvent
+    {
+        public:
+            /*! @brief Constructor of BlackQueueEvent class.
+            */
+                                    BlackQueueEvent();
+
+            /*! @brief Registers the caller as a waiter.
+            *
+            *  @return Current event counter, it is passed to wait().
+            */
+            int                     prepareWait();
+
+            /*! @brief Sleeps until notify() is called after prepareWait() or timeout occurs.
+            *
+            *  @param [in] key      return value of prepareWait()
+            *  @param [in] usec     timeout in microseconds, zero means no timeout
+            */
+            void                    wait(int key, unsigned int usec = 0);
+
+            /*! @brief Sleeps until notify() is called after prepareWait() or the deadline passes.
+            *
+            *  @param [in] key      return value of prepareWait()
+            *  @param [in] deadline absolute CLOCK_MONOTONIC time, it is created by makeDeadline()
+            *  @return false if the deadline passed, else true (woken up, interrupted or the counter changed).
+            */
+            bool                    waitUntil(int key, const timespec &deadline);
+
+            /*! @brief Calculates the absolute CLOCK_MONOTONIC time after the timeout.
+            *
+            *  @param [out] deadline    calculated time
+            *  @param [in]  usec        timeout in microseconds
+            */
+            static void             makeDeadline(timespec &deadline, unsigned int usec);
+
+            /*! @brief Unregisters the caller, it is called after every prepareWait().
+            */
+            void                    finishWait();
+
+            /*! @brief Wakes up all waiters.
+            */
+            void                    notify();
+
+        private:
+            volatile int            counter;            /*!< @brief is used to hold the event counter which is the futex word */
+            volatile int            waiters;            /*!< @brief is used to hold the registered waiter count */
+    };
+
+    // ############################################ BLACKQUEUEEVENT DECLARATION ENDS ########################################## //
+
+
+
+
+    // ########################################### BLACKSPSCQUEUE DECLARATION STARTS ########################################## //
+
+    /*! @brief Bounded lock-free queue for one producer thread and one consumer thread.
+    *
+    *    This class passes items between two threads without any lock and without any allocation after
+    *    construction. The items are stored in a ring buffer, its capacity is rounded up to a power of two.
+    *    Producer and consumer indexes are placed on different cache lines and each side keeps a cached
+    *    copy of the other side's index, so the threads touch the shared cache lines only when the cached
+    *    value is not enough.
+    *
+    *    try* functions never wait. push() and pop() wait on a futex while the queue is full or empty.
+    *    Batch functions move many items with one index update.
+    *
+    *    Only one thread may push and only one thread may pop at the same time. BlackMPMCQueue should be
+    *    used for more threads.
+    *
+    * @par Example
+    * @code{.cpp}
+    *  // Filename: myQueueProject.cpp
+    *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+    *
+    *  #include "BlackLib/BlackQueue/BlackQueue.h"
+    *  #include "BlackLib/BlackThread/BlackThread.h"
+    *  #include "BlackLib/BlackADC/BlackADC.h"
+    *
+    *  BlackLib::BlackSPSCQueue<unsigned int> samples(1024);
+    *
+    *  class Sampler : public BlackLib::BlackThread
+    *  {
+    *       public:
+    *           void onStartHandler()
+    *           {
+    *               BlackLib::BlackADC adc(BlackLib::AIN0);
+    *               while( this->checkPoint() )
+    *               {
+    *                   samples.push( adc.getNumericValue() );
+    *               }
+    *           }
+    *  };
+    *
+    *  int main()
+    *  {
+    *       Sampler *sampler = new Sampler();
+    *       sampler->run();
+    *
+    *       unsigned int block[64];
+    *       while( true )
+    *       {
+    *           size_t count = samples.tryPopBatch(block, 64);
+    *           if( count == 0 )
+    *           {
+    *               samples.pop(block[0]);
+    *               count = 1;
+    *           }
+    *           // filter the block here
+    *       }
+    *  }
+    * @endcode
+    */
+    template <typename T>
+    class BlackSPSCQueue
+    {
+        public:
+            /*! @brief Constructor of BlackSPSCQueue class.
+            *
+            *  @param [in] minCapacity  minimum item count, it is rounded up to a power of two
+            */
+            explicit BlackSPSCQueue(size_t minCapacity)
+            {
+                size_t capacity = 2;
+                while( capacity < minCapacity )
+                {
+                    capacity <<= 1;
+                }
+
+                this->buffer.resize(capacity);
+                this->mask          = capacity - 1;
+                this->head          = 0;
+                this->tail          = 0;
+                this->cachedHead    = 0;
+                this->cachedTail    = 0;
+            }
+
+            /*! @brief Adds an item if the queue is not full. Producer side.
+            *
+            *  @return true if the item is added else false.
+            */
+            bool tryPush(const T &item)
+            {
+                size_t currentTail = this->tail;
+
+                if( currentTail - this->cachedHead > this->mask )
+                {
+                    this->cachedHead = this->head;
+                    if( currentTail - this->cachedHead > this->mask )
+                    {
+                        return false;
+                    }
+                }
+
+                this->buffer[currentTail & this->mask] = item;
+
+                __sync_synchronize();
+                this->tail = currentTail + 1;
+
+                this->notEmpty.notify();
+                return true;
+            }
+
+            /*! @brief Adds items as many as the free space allows. Producer side.
+            *
+            *  @param [in] items    item array
+            *  @param [in] count    item count at the array
+            *  @return Added item count.
+            */
+            size_t tryPushBatch(const T *items, size_t count)
+            {
+                size_t currentTail = this->tail;
+                size_t freeSpace   = this->mask + 1 - (currentTail - this->cachedHead);
+
+                if( freeSpace < count )
+                {
+                    this->cachedHead = this->head;
+                    freeSpace        = this->mask + 1 - (currentTail - this->cachedHead);
+                }
+
+                if( count > freeSpace ) { count = freeSpace; }
+                if( count == 0 )        { return 0; }
+
+                for( size_t i = 0 ; i < count ; i++ )
+                {
+                    this->buffer[(currentTail + i) & this->mask] = items[i];
+                }
+
+                __sync_synchronize();
+                this->tail = currentTail + count;
+
+                this->notEmpty.notify();
+                return count;
+            }
+
+            /*! @brief Adds an item, waits while the queue is full. Producer side.
+            */
+            void push(const T &item)
+            {
+                while( not this->tryPush(item) )
+                {
+                    int key = this->notFull.prepareWait();
+                    if( this->isFull() )
+                    {
+                        this->notFull.wait(key);
+                    }
+                    this->notFull.finishWait();
+                }
+            }
+
+            /*! @brief Takes an item if the queue is not empty. Consumer side.
+            *
+            *  @return true if an item is taken else false.
+            */
+            bool tryPop(T &item)
+            {
+                size_t currentHead = this->head;
+
+                if( currentHead == this->cachedTail )
+                {
+                    this->cachedTail = this->tail;
+                    if( currentHead == this->cachedTail )
+                    {
+                        return false;
+                    }
+                }
+
+                __sync_synchronize();
+                item = this->buffer[currentHead & this->mask];
+
+                __sync_synchronize();
+                this->head = currentHead + 1;
+
+                this->notFull.notify();
+                return true;
+            }
+
+            /*! @brief Takes items as many as available. Consumer side.
+            *
+            *  @param [out] items       item array
+            *  @param [in]  maxCount    size of the item array
+            *  @return Taken item count.
+            */
+            size_t tryPopBatch(T *items, size_t maxCount)
+            {
+                size_t currentHead = this->head;
+                size_t available   = this->cachedTail - currentHead;
+
+                if( available < maxCount )
+                {
+                    this->cachedTail = this->tail;
+                    available        = this->cachedTail - currentHead;
+                }
+
+                if( maxCount > available ) { maxCount = available; }
+                if( maxCount == 0 )        { return 0; }
+
+                __sync_synchronize();
+                for( size_t i = 0 ; i < maxCount ; i++ )
+                {
+                    items[i] = this->buffer[(currentHead + i) & this->mask];
+                }
+
+                __sync_synchronize();
+                this->head = currentHead + maxCount;
+
+                this->notFull.notify();
+                return maxCount;
+            }
+
+            /*! @brief Takes an item, waits while the queue is empty. Consumer side.
+            */
+            void pop(T &item)
+            {
+                while( not this->tryPop(item) )
+                {
+                    int key = this->notEmpty.prepareWait();
+                    if( this->isEmpty() )
+                    {
+                        this->notEmpty.wait(key);
+                    }
+                    this->notEmpty.finishWait();
+                }
+            }
+
+            /*! @brief Takes an item, waits while the queue is empty until timeout occurs. Consumer side.
+            *
+            *  The function waits again after interrupts and after wake ups whose item is taken by another
+            *  consumer, until an item is taken or the deadline passes.
+            *
+            *  @param [out] item    taken item
+            *  @param [in]  usec    timeout in microseconds, zero means trying once without waiting
+            *  @return true if an item is taken else false.
+            */
+            bool popFor(T &item, unsigned int usec)
+            {
+                if( this->tryPop(item) )
+                {
+                    return true;
+                }
+
+                if( usec == 0 )
+                {
+                    return false;
+                }
+
+                timespec deadline;
+                BlackQueueEvent::makeDeadline(deadline, usec);
+
+                while( true )
+                {
+                    bool isTimedOut = false;
+
+                    int key = this->notEmpty.prepareWait();
+                    if( this->isEmpty() )
+                    {
+                        isTimedOut = not this->notEmpty.waitUntil(key, deadline);
+                    }
+                    this->notEmpty.finishWait();
+
+                    if( this->tryPop(item) )
+                    {
+                        return true;
+                    }
+
+                    if( isTimedOut )
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            /*! @brief Checks the queue is empty or not.
+            */
+            bool isEmpty()          { return (this->head == this->tail); }
+
+            /*! @brief Checks the queue is full or not.
+            */
+            bool isFull()           { return (this->tail - this->head > this->mask); }
+
+            /*! @brief Exports the approximate item count.
+            */
+            size_t getSize()        { return (this->tail - this->head); }
+
+            /*! @brief Exports the item capacity.
+            */
+            size_t getCapacity()    { return (this->mask + 1); }
+
+        private:
+            std::vector<T>          buffer;             /*!< @brief is used to hold the ring buffer */
+            size_t                  mask;               /*!< @brief is used to hold the capacity - 1 */
+            BlackQueueEvent         notEmpty;           /*!< @brief is used to wake up the waiting consumer */
+            BlackQueueEvent         notFull;            /*!< @brief is used to wake up the waiting producer */
+
+            char                    padding0[BLACKLIB_CACHE_LINE_SIZE];
+            volatile size_t         head;               /*!< @brief is used to hold the consumer index */
+            size_t                  cachedTail;         /*!< @brief is used to hold the consumer's copy of producer index */
+
+            char                    padding1[BLACKLIB_CACHE_LINE_SIZE];
+            volatile size_t         tail;               /*!< @brief is used to hold the producer index */
+            size_t                  cachedHead;         /*!< @brief is used to hold the producer's copy of consumer index */
+
+            char                    padding2[BLACKLIB_CACHE_LINE_SIZE];
+
+            BlackSPSCQueue(const BlackSPSCQueue&);
+            BlackSPSCQueue& operator=(const BlackSPSCQueue&);
+    };
+
+    // ############################################ BLACKSPSCQUEUE DECLARATION ENDS ########################################### //
+
+
+
+
+    // ########################################### BLACKMPMCQUEUE DECLARATION STARTS ########################################## //
+
+    /*! @brief Bounded lock-free queue for many producer and consumer threads.
+    *
+    *    Every slot of the ring buffer has a sequence number which tells whether the slot is ready for
+    *    writing or reading at the current turn. Producers and consumers claim positions with a
+    *    compare-and-swap on their own index and then wait only for their own slot, so a slow thread
+    *    doesn't block the others. Producer and consumer indexes are placed on different cache lines.
+    *    Capacity is rounded up to a power of two and there isn't any allocation after construction.
+    *
+    *    try* functions never wait. push() and pop() wait on a futex while the queue is full or empty.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   BlackLib::BlackMPMCQueue<std::string> logLines(256);
+    *
+    *   // any thread
+    *   if( ! logLines.tryPush("adc overrun") )
+    *   {
+    *       // queue is full, drop or count the line
+    *   }
+    *
+    *   // logger thread
+    *   std::string line;
+    *   logLines.pop(line);
+    * @endcode
+    */
+    template <typename T>
+    class BlackMPMCQueue
+    {
+        public:
+            /*! @brief Constructor of BlackMPMCQueue class.
+            *
+            *  @param [in] minCapacity  minimum item count, it is rounded up to a power of two
+            */
+            explicit BlackMPMCQueue(size_t minCapacity)
+            {
+                size_t capacity = 2;
+                while( capacity < minCapacity )
+                {
+                    capacity <<= 1;
+                }
+
+                this->cells.resize(capacity);
+                for( size_t i = 0 ; i < capacity ; i++ )
+                {
+                    this->cells[i].sequence = i;
+                }
+
+                this->mask  = capacity - 1;
+                this->head  = 0;
+                this->tail  = 0;
+            }
+
+            /*! @brief Adds an item if the queue is not full.
+            *
+            *  @return true if the item is added else false.
+            */
+            bool tryPush(const T &item)
+            {
+                cell  *target;
+                size_t position = this->tail;
+
+                while( true )
+                {
+                    target = &(this->cells[position & this->mask]);
+                    __sync_synchronize();
+                    intptr_t difference = static_cast<intptr_t>(target->sequence) - static_cast<intptr_t>(position);
+
+                    if( difference == 0 )
+                    {
+                        if( __sync_bool_compare_and_swap( &(this->tail), position, position + 1) )
+                        {
+                            break;
+                        }
+                        position = this->tail;
+                    }
+                    else
+                    if( difference < 0 )
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = this->tail;
+                    }
+                }
+
+                target->data = item;
+
+                __sync_synchronize();
+                target->sequence = position + 1;
+
+                this->notEmpty.notify();
+                return true;
+            }
+
+            /*! @brief Adds items until the queue is full.
+            *
+            *  @param [in] items    item array
+            *  @param [in] count    item count at the array
+            *  @return Added item count.
+            */
+            size_t tryPushBatch(const T *items, size_t count)
+            {
+                size_t pushed = 0;
+                while( pushed < count and this->tryPush(items[pushed]) )
+                {
+                    pushed++;
+                }
+                return pushed;
+            }
+
+            /*! @brief Adds an item, waits while the queue is full.
+            */
+            void push(const T &item)
+            {
+                while( not this->tryPush(item) )
+                {
+                    int key = this->notFull.prepareWait();
+                    if( this->isFull() )
+                    {
+                        this->notFull.wait(key);
+                    }
+                    this->notFull.finishWait();
+                }
+            }
+
+            /*! @brief Takes an item if the queue is not empty.
+            *
+            *  @return true if an item is taken else false.
+            */
+            bool tryPop(T &item)
+            {
+                cell  *target;
+                size_t position = this->head;
+
+                while( true )
+                {
+                    target = &(this->cells[position & this->mask]);
+                    __sync_synchronize();
+                    intptr_t difference = static_cast<intptr_t>(target->sequence) - static_cast<intptr_t>(position + 1);
+
+                    if( difference == 0 )
+                    {
+                        if( __sync_bool_compare_and_swap( &(this->head), position, position + 1) )
+                        {
+                            break;
+                        }
+                        position = this->head;
+                    }
+                    else
+                    if( difference < 0 )
+                    {
+                        return false;
+                    }
+                    else
+                    {
+                        position = this->head;
+                    }
+                }
+
+                __sync_synchronize();
+                item = target->data;
+
+                __sync_synchronize();
+                target->sequence = position + this->mask + 1;
+
+                this->notFull.notify();
+                return true;
+            }
+
+            /*! @brief Takes items until the queue is empty.
+            *
+            *  @param [out] items       item array
+            *  @param [in]  maxCount    size of the item array
+            *  @return Taken item count.
+            */
+            size_t tryPopBatch(T *items, size_t maxCount)
+            {
+                size_t popped = 0;
+                while( popped < maxCount and this->tryPop(items[popped]) )
+                {
+                    popped++;
+                }
+                return popped;
+            }
+
+            /*! @brief Takes an item, waits while the queue is empty.
+            */
+            void pop(T &item)
+            {
+                while( not this->tryPop(item) )
+                {
+                    int key = this->notEmpty.prepareWait();
+                    if( this->isEmpty() )
+                    {
+                        this->notEmpty.wait(key);
+                    }
+                    this->notEmpty.finishWait();
+                }
+            }
+
+            /*! @brief Takes an item, waits while the queue is empty until timeout occurs.
+            *
+            *  The function waits again after interrupts and after wake ups whose item is taken by another
+            *  consumer, until an item is taken or the deadline passes.
+            *
+            *  @param [out] item    taken item
+            *  @param [in]  usec    timeout in microseconds, zero means trying once without waiting
+            *  @return true if an item is taken else false.
+            */
+            bool popFor(T &item, unsigned int usec)
+            {
+                if( this->tryPop(item) )
+                {
+                    return true;
+                }
+
+                if( usec == 0 )
+                {
+                    return false;
+                }
+
+                timespec deadline;
+                BlackQueueEvent::makeDeadline(deadline, usec);
+
+                while( true )
+                {
+                    bool isTimedOut = false;
+
+                    int key = this->notEmpty.prepareWait();
+                    if( this->isEmpty() )
+                    {
+                        isTimedOut = not this->notEmpty.waitUntil(key, deadline);
+                    }
+                    this->notEmpty.finishWait();
+
+                    if( this->tryPop(item) )
+                    {
+                        return true;
+                    }
+
+                    if( isTimedOut )
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            /*! @brief Checks the queue is empty or not, result is approximate while other threads work.
+            */
+            bool isEmpty()          { return (this->getSize() == 0); }
+
+            /*! @brief Checks the queue is full or not, result is approximate while other threads work.
+            */
+            bool isFull()           { return (this->getSize() > this->mask); }
+
+            /*! @brief Exports the approximate item count.
+            */
+            size_t getSize()
+            {
+                size_t currentHead = this->head;
+                size_t currentTail = this->tail;
+                return (currentTail > currentHead) ? (currentTail - currentHead) : 0;
+            }
+
+            /*! @brief Exports the item capacity.
+            */
+            size_t getCapacity()    { return (this->mask + 1); }
+
+        private:
+            /*! @brief Slot of the ring buffer.
+            */
+            struct cell
+            {
+                volatile size_t     sequence;           /*!< @brief is used to hold the turn of the slot */
+                T                   data;               /*!< @brief is used to hold the item */
+            };
+
+            std::vector<cell>       cells;              /*!< @brief is used to hold the ring buffer */
+            size_t                  mask;               /*!< @brief is used to hold the capacity - 1 */
+            BlackQueueEvent         notEmpty;           /*!< @brief is used to wake up the waiting consumers */
+            BlackQueueEvent         notFull;            /*!< @brief is used to wake up the waiting producers */
+
+            char                    padding0[BLACKLIB_CACHE_LINE_SIZE];
+            volatile size_t         head;               /*!< @brief is used to hold the consumer index */
+
+            char                    padding1[BLACKLIB_CACHE_LINE_SIZE];
+            volatile size_t         tail;               /*!< @brief is used to hold the producer index */
+
+            char                    padding2[BLACKLIB_CACHE_LINE_SIZE];
+
+            BlackMPMCQueue(const BlackMPMCQueue&);
+            BlackMPMCQueue& operator=(const BlackMPMCQueue&);
+    };
+
+    // ############################################ BLACKMPMCQUEUE DECLARATION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKQUEUE_H_ */
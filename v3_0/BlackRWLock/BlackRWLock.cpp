@@ -0,0 +1,90 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackRWLock.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ############################################# BLACKRWLOCK DEFINITION STARTS ############################################ //
+    BlackRWLock::BlackRWLock(BlackRWLock::rwLockPreference preference)
+    {
+        pthread_rwlockattr_t tempLockAttr;
+        pthread_rwlockattr_init(&tempLockAttr);
+
+        #ifdef __USE_GNU
+            if( preference == BlackRWLock::PreferWriter )
+            {
+                pthread_rwlockattr_setkind_np(&tempLockAttr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+            }
+        #endif
+
+        pthread_rwlock_init( &(this->rwLock), &tempLockAttr);
+        pthread_rwlockattr_destroy(&tempLockAttr);
+    }
+
+    BlackRWLock::~BlackRWLock()
+    {
+        pthread_rwlock_destroy( &(this->rwLock) );
+    }
+
+    bool BlackRWLock::readLock()
+    {
+        return ( pthread_rwlock_rdlock( &(this->rwLock) ) == 0 );
+    }
+
+    bool BlackRWLock::tryReadLock()
+    {
+        return ( pthread_rwlock_tryrdlock( &(this->rwLock) ) == 0 );
+    }
+
+    bool BlackRWLock::writeLock()
+    {
+        return ( pthread_rwlock_wrlock( &(this->rwLock) ) == 0 );
+    }
+
+    bool BlackRWLock::tryWriteLock()
+    {
+        return ( pthread_rwlock_trywrlock( &(this->rwLock) ) == 0 );
+    }
+
+    bool BlackRWLock::unlock()
+    {
+        return ( pthread_rwlock_unlock( &(this->rwLock) ) == 0 );
+    }
+    // ############################################## BLACKRWLOCK DEFINITION ENDS ############################################# //
+
+
+} /* namespace BlackLib */
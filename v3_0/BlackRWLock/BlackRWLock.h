@@ -0,0 +1,170 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKRWLOCK_H_
+#define BLACKRWLOCK_H_
+
+#include <pthread.h>
+
+
+
+namespace BlackLib
+{
+
+    // ############################################ BLACKRWLOCK DECLARATION STARTS ############################################ //
+
+    /*! @brief Reader-writer lock.
+    *
+    *    This class lets many threads read shared data at the same time, while a writer gets exclusive
+    *    access. It is useful for data which is read much more often than it is written, like
+    *    configuration or calibration tables. Readers are preferred by default; with writer preference,
+    *    new readers wait while a writer is waiting, so continuous reading can't starve the writer.
+    *
+    * @par Example
+    *  @code{.cpp}
+    *   BlackLib::BlackRWLock calibrationLock(BlackLib::BlackRWLock::PreferWriter);
+    *   float                 calibration[8];
+    *
+    *   float readCalibration(int index)
+    *   {
+    *       BlackLib::BlackReadGuard guard(calibrationLock);
+    *       return calibration[index];
+    *   }
+    *
+    *   void writeCalibration(int index, float value)
+    *   {
+    *       BlackLib::BlackWriteGuard guard(calibrationLock);
+    *       calibration[index] = value;
+    *   }
+    * @endcode
+    */
+    class BlackRWLock
+    {
+        public:
+
+            /*!
+            * This enum is used to define which side is preferred when readers and writers wait together.
+            */
+            enum rwLockPreference
+            {
+                PreferReader    = 0,            /*!< enumeration for @a reader preferred lock */
+                PreferWriter    = 1             /*!< enumeration for @a writer preferred lock */
+            };
+
+            /*! @brief Constructor of BlackRWLock class.
+            *
+            * @param [in] preference    waiting side preference
+            */
+            BlackRWLock(BlackRWLock::rwLockPreference preference = BlackRWLock::PreferReader);
+
+            /*! @brief Destructor of BlackRWLock class.
+            */
+            virtual ~BlackRWLock();
+
+            /*! @brief Locks for reading, waits while a writer holds the lock.
+            *
+            * @return true if locking is successful else false.
+            */
+            bool readLock();
+
+            /*! @brief Tries to lock for reading without waiting.
+            *
+            * @return true if locking is successful else false.
+            */
+            bool tryReadLock();
+
+            /*! @brief Locks for writing, waits until all readers and writers release the lock.
+            *
+            * @return true if locking is successful else false.
+            */
+            bool writeLock();
+
+            /*! @brief Tries to lock for writing without waiting.
+            *
+            * @return true if locking is successful else false.
+            */
+            bool tryWriteLock();
+
+            /*! @brief Releases the read or write lock of calling thread.
+            *
+            * @return true if unlocking is successful else false.
+            */
+            bool unlock();
+
+        private:
+            pthread_rwlock_t        rwLock;              /*!< @brief is used to hold the rwlock posix data structure */
+
+            BlackRWLock(const BlackRWLock&);
+            BlackRWLock& operator=(const BlackRWLock&);
+    };
+
+    // ############################################# BLACKRWLOCK DECLARATION ENDS ############################################# //
+
+
+
+
+    // ######################################## BLACKREADGUARD/BLACKWRITEGUARD STARTS ######################################### //
+
+    /*! @brief Holds a read lock of BlackRWLock in its scope.
+    */
+    class BlackReadGuard
+    {
+        public:
+            explicit BlackReadGuard(BlackRWLock &lock) : rwLock(lock)   { this->rwLock.readLock(); }
+            ~BlackReadGuard()                                           { this->rwLock.unlock(); }
+
+        private:
+            BlackRWLock             &rwLock;             /*!< @brief is used to hold the guarded lock */
+
+            BlackReadGuard(const BlackReadGuard&);
+            BlackReadGuard& operator=(const BlackReadGuard&);
+    };
+
+    /*! @brief Holds a write lock of BlackRWLock in its scope.
+    */
+    class BlackWriteGuard
+    {
+        public:
+            explicit BlackWriteGuard(BlackRWLock &lock) : rwLock(lock)  { this->rwLock.writeLock(); }
+            ~BlackWriteGuard()                                          { this->rwLock.unlock(); }
+
+        private:
+            BlackRWLock             &rwLock;             /*!< @brief is used to hold the guarded lock */
+
+            BlackWriteGuard(const BlackWriteGuard&);
+            BlackWriteGuard& operator=(const BlackWriteGuard&);
+    };
+
+    // ######################################### BLACKREADGUARD/BLACKWRITEGUARD ENDS ########################################## //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKRWLOCK_H_ */
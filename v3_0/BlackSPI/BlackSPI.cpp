@@ -36,8 +36,17 @@
 namespace BlackLib
 {
 
+    // names of the BlackSPI::flags values, they are used as error labels of metrics
+    static const char *const spiFlagNames[BlackIoMetrics::flagCount] =
+    {
+        NULL, "dtErr", "openErr", "closeErr",
+        "portPathErr", "transferErr", "modeErr", "speedErr",
+        "bitSizeErr"
+    };
+
 
-    BlackSPI::BlackSPI(spiName spi)
+
+    BlackSPI::BlackSPI(spiName spi) : spiErrors(this->getErrorsFromCore()), ioMetrics("spi", spiFlagNames)
     {
         this->spiChipNumber     = (static_cast<int>(spi) % 2);
         this->spiBusNumber      = ( (static_cast<int>(spi) - this->spiChipNumber)/2 );
@@ -46,7 +55,6 @@ namespace BlackLib
         this->spiFD             = -1;
         this->isOpenFlag        = false;
         this->isCurrentEqDefault= true;
-        this->spiErrors         = new errorSPI( this->getErrorsFromCore() );
 
 
         this->loadDeviceTree();
@@ -54,7 +62,7 @@ namespace BlackLib
 
     }
 
-    BlackSPI::BlackSPI(spiName spi, BlackSpiProperties spiProperties)
+    BlackSPI::BlackSPI(spiName spi, BlackSpiProperties spiProperties) : spiErrors(this->getErrorsFromCore()), ioMetrics("spi", spiFlagNames)
     {
         this->spiChipNumber     = (static_cast<int>(spi) % 2);
         this->spiBusNumber      = ( (static_cast<int>(spi) - this->spiChipNumber)/2 );
@@ -63,7 +71,6 @@ namespace BlackLib
         this->spiFD             = -1;
         this->isOpenFlag        = false;
         this->isCurrentEqDefault= false;
-        this->spiErrors         = new errorSPI( this->getErrorsFromCore() );
 
         constructorProperties   = spiProperties;
 
@@ -72,7 +79,7 @@ namespace BlackLib
 
     }
 
-    BlackSPI::BlackSPI(spiName spi, uint8_t spiBitsPerWord, uint8_t spiMode, uint32_t spiSpeed)
+    BlackSPI::BlackSPI(spiName spi, uint8_t spiBitsPerWord, uint8_t spiMode, uint32_t spiSpeed) : spiErrors(this->getErrorsFromCore()), ioMetrics("spi", spiFlagNames)
     {
         this->spiChipNumber     = (static_cast<int>(spi) % 2);
         this->spiBusNumber      = ( (static_cast<int>(spi) - this->spiChipNumber)/2 );
@@ -81,7 +88,6 @@ namespace BlackLib
         this->spiFD             = -1;
         this->isOpenFlag        = false;
         this->isCurrentEqDefault= false;
-        this->spiErrors         = new errorSPI( this->getErrorsFromCore() );
 
 
         constructorProperties.spiBitsPerWord    = spiBitsPerWord;
@@ -95,7 +101,6 @@ namespace BlackLib
     BlackSPI::~BlackSPI()
     {
         this->close();
-        delete this->spiErrors;
     }
 
 
@@ -105,21 +110,14 @@ namespace BlackLib
 
     bool        BlackSPI::loadDeviceTree()
     {
-        std::string file = this->getSlotsFilePath();
-
-        std::ofstream slotsFile;
-        slotsFile.open(file.c_str(),std::ios::out);
-        if(slotsFile.fail())
+        if( not this->loadOverlay(this->dtSpiFilename) )
         {
-            this->spiErrors->dtError = true;
-            slotsFile.close();
+            this->spiErrors.dtError = true;
             return false;
         }
         else
         {
-            this->spiErrors->dtError = false;
-            slotsFile << this->dtSpiFilename;
-            slotsFile.close();
+            this->spiErrors.dtError = false;
             return true;
         }
     }
@@ -138,24 +136,24 @@ namespace BlackLib
         }
         else
         {
-            this->spiErrors->portPathError = true;
+            this->spiErrors.portPathError = true;
             return false;
         }
 
 
         if( limitedSearchResult == SEARCH_DIR_NOT_FOUND )
         {
-            this->spiErrors->portPathError = true;
+            this->spiErrors.portPathError = true;
             return false;
         }
         else if( ::isdigit( static_cast<int>(limitedSearchResult[3]) ) == 0 )
         {
-            this->spiErrors->portPathError = true;
+            this->spiErrors.portPathError = true;
             return false;
         }
         else
         {
-            this->spiErrors->portPathError = false;
+            this->spiErrors.portPathError = false;
             this->spiPortPath = "/dev/spidev" + tostr( limitedSearchResult[3] ) + "." + tostr(this->spiChipNumber);
             return true;
         }
@@ -180,13 +178,13 @@ namespace BlackLib
 
         if( this->spiFD < 0 )
         {
-            this->spiErrors->openError  = true;
+            this->spiErrors.openError   = true;
             this->isOpenFlag            = false;
             return false;
         }
 
 
-        this->spiErrors->openError  = false;
+        this->spiErrors.openError   = false;
         this->isOpenFlag            = true;
         this->defaultProperties     = this->getProperties();
 
@@ -212,12 +210,12 @@ namespace BlackLib
     {
         if( ::close(this->spiFD) < 0 )
         {
-            this->spiErrors->closeError = true;
+            this->spiErrors.closeError = true;
             return false;
         }
         else
         {
-            this->spiErrors->closeError = false;
+            this->spiErrors.closeError = false;
             this->isOpenFlag = false;
             return true;
         }
@@ -234,12 +232,12 @@ namespace BlackLib
     {
        if( ::ioctl(this->spiFD, SPI_IOC_WR_MODE, &newMode) == -1 )
        {
-           this->spiErrors->modeError = true;
+           this->spiErrors.modeError = true;
            return false;
        }
        else
        {
-           this->spiErrors->modeError = false;
+           this->spiErrors.modeError = false;
            this->currentProperties.spiMode = newMode;
            return true;
        }
@@ -251,12 +249,12 @@ namespace BlackLib
 
         if( ::ioctl(this->spiFD, SPI_IOC_RD_MODE, &mode) == -1 )
         {
-            this->spiErrors->modeError = true;
+            this->spiErrors.modeError = true;
             return 0;
         }
         else
         {
-            this->spiErrors->modeError = false;
+            this->spiErrors.modeError = false;
             this->currentProperties.spiMode = mode;
             return mode;
         }
@@ -268,12 +266,12 @@ namespace BlackLib
     {
        if( ::ioctl(this->spiFD, SPI_IOC_WR_MAX_SPEED_HZ, &newSpeed) == -1 )
        {
-           this->spiErrors->speedError = true;
+           this->spiErrors.speedError = true;
            return false;
        }
        else
        {
-           this->spiErrors->speedError = false;
+           this->spiErrors.speedError = false;
            this->currentProperties.spiSpeed = newSpeed;
            return true;
        }
@@ -285,12 +283,12 @@ namespace BlackLib
 
         if( ::ioctl(this->spiFD, SPI_IOC_RD_MAX_SPEED_HZ, &speed) == -1 )
         {
-            this->spiErrors->speedError = true;
+            this->spiErrors.speedError = true;
             return 0;
         }
         else
         {
-            this->spiErrors->speedError = false;
+            this->spiErrors.speedError = false;
             this->currentProperties.spiSpeed = speed;
             return speed;
         }
@@ -302,12 +300,12 @@ namespace BlackLib
     {
        if( ::ioctl(this->spiFD, SPI_IOC_WR_BITS_PER_WORD, &newBitSize) == -1 )
        {
-           this->spiErrors->bitSizeError = true;
+           this->spiErrors.bitSizeError = true;
            return false;
        }
        else
        {
-           this->spiErrors->bitSizeError = false;
+           this->spiErrors.bitSizeError = false;
            this->currentProperties.spiBitsPerWord = newBitSize;
            return true;
        }
@@ -319,12 +317,12 @@ namespace BlackLib
 
         if( ::ioctl(this->spiFD, SPI_IOC_RD_BITS_PER_WORD, &bitsSize) == -1 )
         {
-            this->spiErrors->bitSizeError = true;
+            this->spiErrors.bitSizeError = true;
             return 0;
         }
         else
         {
-            this->spiErrors->bitSizeError = false;
+            this->spiErrors.bitSizeError = false;
             this->currentProperties.spiBitsPerWord = bitsSize;
             return bitsSize;
         }
@@ -352,19 +350,22 @@ namespace BlackLib
 
     uint8_t     BlackSPI::transfer(uint8_t writeByte, uint16_t wait_us)
     {
+        BLACKLIB_TRACE_SCOPE(TraceSpiTransfer, static_cast<uint32_t>((this->spiBusNumber << 8) | this->spiChipNumber), 1, this->spiErrors.transferError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, 1, transferErr, this->spiErrors.transferError);
+
         uint8_t tempReadByte = 0x00;
 
 
         if( ! this->isOpenFlag )
         {
-            this->spiErrors->openError      = true;
-            this->spiErrors->transferError  = true;
+            this->spiErrors.openError       = true;
+            this->spiErrors.transferError   = true;
             return tempReadByte;
         }
 
 
 
-        this->spiErrors->openError          = false;
+        this->spiErrors.openError           = false;
         spi_ioc_transfer package;
 
         package.tx_buf          = (unsigned long)&writeByte;
@@ -377,34 +378,42 @@ namespace BlackLib
 
         if( ::ioctl(this->spiFD, SPI_IOC_MESSAGE(1), &package) >= 0)
         {
-            this->spiErrors->transferError = false;
+            this->spiErrors.transferError = false;
             return tempReadByte;
         }
         else
         {
-            this->spiErrors->transferError = true;
+            this->spiErrors.transferError = true;
             return tempReadByte;
         }
     }
 
     bool        BlackSPI::transfer(uint8_t *writeBuffer, uint8_t *readBuffer, size_t bufferSize, uint16_t wait_us)
     {
+        return this->tryTransfer(writeBuffer, readBuffer, bufferSize, wait_us).isOk();
+    }
+
+    BlackResult<void> BlackSPI::tryTransfer(uint8_t *writeBuffer, uint8_t *readBuffer, size_t bufferSize, uint16_t wait_us)
+    {
+        BLACKLIB_TRACE_SCOPE(TraceSpiTransfer, static_cast<uint32_t>((this->spiBusNumber << 8) | this->spiChipNumber), bufferSize, this->spiErrors.transferError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, bufferSize, transferErr, this->spiErrors.transferError);
+
         if( ! this->isOpenFlag )
         {
-            this->spiErrors->openError      = true;
-            this->spiErrors->transferError  = true;
-            return false;
+            this->spiErrors.openError       = true;
+            this->spiErrors.transferError   = true;
+            return BlackResult<void>(BlackError::NotReady, 0);
         }
 
 
 
-        this->spiErrors->openError          = false;
-        uint8_t tempReadBuffer[ bufferSize ];
-        memset( tempReadBuffer, 0, bufferSize);
+        this->spiErrors.openError           = false;
 
         spi_ioc_transfer package;
+        memset(&package, 0, sizeof(package));
+
         package.tx_buf          = (unsigned long)writeBuffer;
-        package.rx_buf          = (unsigned long)tempReadBuffer;
+        package.rx_buf          = (unsigned long)readBuffer;
         package.len             = bufferSize;
         package.delay_usecs     = wait_us;
         package.speed_hz        = this->currentProperties.spiSpeed;
@@ -413,14 +422,13 @@ namespace BlackLib
 
         if( ::ioctl(this->spiFD, SPI_IOC_MESSAGE(1), &package) >= 0)
         {
-            this->spiErrors->transferError = false;
-            memcpy(readBuffer, tempReadBuffer, bufferSize);
-            return true;
+            this->spiErrors.transferError = false;
+            return BlackResult<void>();
         }
         else
         {
-            this->spiErrors->transferError = true;
-            return false;
+            this->spiErrors.transferError = true;
+            return BlackResult<void>(BlackError::IoctlFailed, errno);
         }
     }
 
@@ -447,30 +455,35 @@ namespace BlackLib
 
     bool        BlackSPI::fail()
     {
-        return (this->spiErrors->dtError or
-                this->spiErrors->openError or
-                this->spiErrors->closeError or
-                this->spiErrors->portPathError or
-                this->spiErrors->transferError or
-                this->spiErrors->modeError or
-                this->spiErrors->speedError or
-                this->spiErrors->bitSizeError
+        return (this->spiErrors.dtError or
+                this->spiErrors.openError or
+                this->spiErrors.closeError or
+                this->spiErrors.portPathError or
+                this->spiErrors.transferError or
+                this->spiErrors.modeError or
+                this->spiErrors.speedError or
+                this->spiErrors.bitSizeError
                 );
     }
 
     bool        BlackSPI::fail(BlackSPI::flags f)
     {
-        if(f==dtErr)            { return this->spiErrors->dtError;         }
-        if(f==openErr)          { return this->spiErrors->openError;       }
-        if(f==closeErr)         { return this->spiErrors->closeError;      }
-        if(f==portPathErr)      { return this->spiErrors->portPathError;   }
-        if(f==transferErr)      { return this->spiErrors->transferError;   }
-        if(f==modeErr)          { return this->spiErrors->modeError;       }
-        if(f==speedErr)         { return this->spiErrors->speedError;      }
-        if(f==bitSizeErr)       { return this->spiErrors->bitSizeError;    }
+        if(f==dtErr)            { return this->spiErrors.dtError;          }
+        if(f==openErr)          { return this->spiErrors.openError;        }
+        if(f==closeErr)         { return this->spiErrors.closeError;       }
+        if(f==portPathErr)      { return this->spiErrors.portPathError;    }
+        if(f==transferErr)      { return this->spiErrors.transferError;    }
+        if(f==modeErr)          { return this->spiErrors.modeError;        }
+        if(f==speedErr)         { return this->spiErrors.speedError;       }
+        if(f==bitSizeErr)       { return this->spiErrors.bitSizeError;     }
 
         return true;
     }
 
+    BlackIoMetrics *BlackSPI::getMetrics()
+    {
+        return &(this->ioMetrics);
+    }
+
 
 } /* namespace BlackLib */
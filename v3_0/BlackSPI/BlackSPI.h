@@ -277,7 +277,8 @@ namespace BlackLib
             BlackSpiProperties defaultProperties;       /*!< @brief is used to hold the default properties of spi */
             BlackSpiProperties currentProperties;       /*!< @brief is used to hold the current properties of spi */
 
-            errorSPI        *spiErrors;                 /*!< @brief is used to hold the errors of BlackSPI class */
+            errorSPI         spiErrors;                 /*!< @brief is used to hold the errors of BlackSPI class */
+            BlackIoMetrics   ioMetrics;                 /*!< @brief is used to hold the I/O metrics of BlackSPI class */
 
             std::string     spiPortPath;                /*!< @brief is used to hold the spi's tty port path */
             std::string     dtSpiFilename;              /*!< @brief is used to hold the spi's device tree overlay name */
@@ -408,7 +409,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackSPI class.
             *
-            * This function closes TTY file and deletes errorSPI struct pointer.
+            * This function closes TTY file.
             */
             virtual ~BlackSPI();
 
@@ -528,6 +529,18 @@ namespace BlackLib
             */
             bool            transfer(uint8_t *writeBuffer, uint8_t *readBuffer, size_t bufferSize, uint16_t wait_us = 10);
 
+            /*! @brief Transfers buffers over spi line and returns an error code.
+            *
+            *  Values are received directly to @b readBuffer, without a temporary buffer.
+            *
+            *  @param [in] writeBuffer  values which will be sent
+            *  @param [out] readBuffer  received values
+            *  @param [in] bufferSize   size of the buffers
+            *  @param [in] wait_us      delay time after transfer
+            *  @return BlackLib::BlackError::None if successful, else NotReady or IoctlFailed.
+            */
+            BlackResult<void> tryTransfer(uint8_t *writeBuffer, uint8_t *readBuffer, size_t bufferSize, uint16_t wait_us = 10);
+
 
             /*! @brief Changes word size of spi.
             *
@@ -886,6 +899,18 @@ namespace BlackLib
             */
             bool            fail(BlackSPI::flags f);
 
+            /*! @brief Exports I/O metrics of the object.
+            *
+            * Operations aren't measured until the returned metrics are registered with BlackMetrics::add().
+            * @return Pointer of BlackSPI::ioMetrics variable.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackMetrics::add("my_spi", mySpi.getMetrics());
+            * @endcode
+            */
+            BlackIoMetrics *getMetrics();
+
     };
     // ########################################### BLACKSPI DECLARATION ENDS ############################################## //
 
@@ -0,0 +1,105 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackSpinLock.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ############################################ BLACKSPINLOCK DEFINITION STARTS ########################################### //
+    BlackSpinLock::BlackSpinLock()
+    {
+        this->nextTicket    = 0;
+        this->servingTicket = 0;
+    }
+
+    void BlackSpinLock::lock()
+    {
+        unsigned int ticket = __sync_fetch_and_add( &(this->nextTicket), 1);
+        unsigned int rounds = isSpinningUseful() ? 0 : 64;
+
+        while( true )
+        {
+            unsigned int distance = ticket - this->servingTicket;
+            if( distance == 0 )
+            {
+                break;
+            }
+
+            if( rounds < 64 )
+            {
+                // every waiter ahead needs some time, don't hammer the cache line meanwhile
+                for( unsigned int i = 0 ; i < distance * 32 ; i++ )
+                {
+                    cpuRelax();
+                }
+
+                rounds++;
+            }
+            else
+            {
+                sched_yield();
+            }
+        }
+
+        __sync_synchronize();
+    }
+
+    bool BlackSpinLock::tryLock()
+    {
+        unsigned int ticket = this->servingTicket;
+
+        if( this->nextTicket != ticket )
+        {
+            return false;
+        }
+
+        return __sync_bool_compare_and_swap( &(this->nextTicket), ticket, ticket + 1);
+    }
+
+    void BlackSpinLock::unlock()
+    {
+        __sync_synchronize();
+        this->servingTicket = this->servingTicket + 1;
+    }
+
+    bool BlackSpinLock::isLocked()
+    {
+        return (this->nextTicket != this->servingTicket);
+    }
+    // ############################################# BLACKSPINLOCK DEFINITION ENDS ############################################ //
+
+
+} /* namespace BlackLib */
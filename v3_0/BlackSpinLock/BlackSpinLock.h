@@ -0,0 +1,142 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKSPINLOCK_H_
+#define BLACKSPINLOCK_H_
+
+#include "../BlackMutex/BlackMutex.h"
+
+#include <sched.h>
+#include <unistd.h>
+
+
+
+namespace BlackLib
+{
+
+    /*! @brief Tells the cpu that the caller is in a busy-wait loop.
+    *
+    *    It is the "yield" hint on ARM and the "pause" instruction on x86. On the other platforms it is
+    *    only a compiler barrier.
+    */
+    inline void cpuRelax()
+    {
+        #if defined(__arm__) && ( defined(__ARM_ARCH_7A__) || defined(__ARM_ARCH_7__) || defined(__ARM_ARCH_6K__) )
+            __asm__ __volatile__("yield" ::: "memory");
+        #elif defined(__i386__) || defined(__x86_64__)
+            __asm__ __volatile__("pause" ::: "memory");
+        #else
+            __asm__ __volatile__("" ::: "memory");
+        #endif
+    }
+
+
+
+    /*! @brief Checks busy-waiting can be useful at this system.
+    *
+    *    On a single cpu system, the lock holder can't run while another thread spins, so spinning only
+    *    wastes the time slice. Lock classes give the cpu up immediately there.
+    *
+    *    @return true if more than one cpu is online else false.
+    */
+    inline bool isSpinningUseful()
+    {
+        static const bool isMultiCpu = ( sysconf(_SC_NPROCESSORS_ONLN) > 1 );
+        return isMultiCpu;
+    }
+
+
+
+    // ########################################### BLACKSPINLOCK DECLARATION STARTS ########################################### //
+
+    /*! @brief Busy-waiting ticket lock for very short critical sections.
+    *
+    *    This class doesn't use any system call. Every locker takes a ticket and waits until the lock
+    *    serves its ticket, so threads get the lock in arrival order and none of them starves. The
+    *    waiting thread backs off in proportion to its place in the queue, and it gives the cpu to
+    *    the other threads with sched_yield() when it waits too long. On single cpu systems it yields
+    *    without spinning.
+    *
+    *    It is faster than BlackMutex when the lock is held for a few instructions only. It shouldn't be
+    *    used when the holder can sleep or do I/O. It is not recursive.
+    *
+    * @par Example
+    *  @code{.cpp}
+    *   BlackLib::BlackSpinLock counterLock;
+    *   unsigned int            counter = 0;
+    *
+    *   void increment()
+    *   {
+    *       BlackLib::BlackLockGuard<BlackLib::BlackSpinLock> guard(counterLock);
+    *       ++counter;
+    *   }
+    * @endcode
+    */
+    class BlackSpinLock
+    {
+        public:
+            /*! @brief Constructor of BlackSpinLock class.
+            */
+            BlackSpinLock();
+
+            /*! @brief Locks the spin lock, waits until it is available.
+            */
+            void lock();
+
+            /*! @brief Tries to lock the spin lock without waiting.
+            *
+            * @return true if the lock is taken else false.
+            */
+            bool tryLock();
+
+            /*! @brief Unlocks the spin lock.
+            */
+            void unlock();
+
+            /*! @brief Checks the spin lock state.
+            *
+            * @return true if the lock is held by a thread else false.
+            */
+            bool isLocked();
+
+        private:
+            volatile unsigned int   nextTicket;          /*!< @brief is used to hold the next given ticket */
+            volatile unsigned int   servingTicket;       /*!< @brief is used to hold the ticket which holds the lock */
+
+            BlackSpinLock(const BlackSpinLock&);
+            BlackSpinLock& operator=(const BlackSpinLock&);
+    };
+
+    // ############################################ BLACKSPINLOCK DECLARATION ENDS ############################################ //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKSPINLOCK_H_ */
@@ -0,0 +1,264 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackStopwatch.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKSTOPWATCH DEFINITION STARTS ########################################### //
+    BlackStopwatch::BlackStopwatch(BlackStopwatch::stopwatchClock clk)
+    {
+        this->clockType     = BlackStopwatch::ClockMonotonicRaw;
+        this->running       = false;
+        this->startTicks    = 0;
+        this->lapTicks      = 0;
+        this->stoppedTime   = 0;
+
+        if( clk == BlackStopwatch::ClockCycleCounter and BlackStopwatch::isCycleCounterEnabled() )
+        {
+            // calibrate before the first measurement
+            BlackStopwatch::getCycleScale();
+            this->clockType = BlackStopwatch::ClockCycleCounter;
+        }
+
+        this->laps.reserve(64);
+    }
+
+    void BlackStopwatch::start()
+    {
+        this->laps.clear();
+        this->stoppedTime   = 0;
+        this->running       = true;
+        this->startTicks    = this->readTicks();
+        this->lapTicks      = this->startTicks;
+    }
+
+    int64_t BlackStopwatch::stop()
+    {
+        if( this->running )
+        {
+            this->stoppedTime   = this->ticksToNanoseconds(this->startTicks, this->readTicks());
+            this->running       = false;
+        }
+
+        return this->stoppedTime;
+    }
+
+    int64_t BlackStopwatch::restart()
+    {
+        uint64_t current    = this->readTicks();
+        int64_t  elapsedNs  = this->running ? this->ticksToNanoseconds(this->startTicks, current) : this->stoppedTime;
+
+        this->laps.clear();
+        this->stoppedTime   = 0;
+        this->running       = true;
+        this->startTicks    = current;
+        this->lapTicks      = current;
+
+        return elapsedNs;
+    }
+
+    int64_t BlackStopwatch::elapsed()
+    {
+        if( this->running )
+        {
+            return this->ticksToNanoseconds(this->startTicks, this->readTicks());
+        }
+
+        return this->stoppedTime;
+    }
+
+    int64_t BlackStopwatch::lap()
+    {
+        if( not this->running )
+        {
+            return 0;
+        }
+
+        uint64_t current    = this->readTicks();
+        int64_t  lapTime    = this->ticksToNanoseconds(this->lapTicks, current);
+
+        this->lapTicks      = current;
+        this->laps.push_back(lapTime);
+
+        return lapTime;
+    }
+
+    const std::vector<int64_t>& BlackStopwatch::getLaps()
+    {
+        return this->laps;
+    }
+
+    bool BlackStopwatch::isRunning()
+    {
+        return this->running;
+    }
+
+    BlackStopwatch::stopwatchClock BlackStopwatch::getClock()
+    {
+        return this->clockType;
+    }
+
+    int64_t BlackStopwatch::now()
+    {
+        timespec current;
+        clock_gettime(CLOCK_MONOTONIC_RAW, &current);
+
+        return static_cast<int64_t>(current.tv_sec) * 1000000000LL + current.tv_nsec;
+    }
+
+    BlackTimeElapsed BlackStopwatch::toElapsed(int64_t ns)
+    {
+        BlackTimeElapsed temp;
+
+        if( ns < 0 )
+        {
+            return temp;
+        }
+
+        uint64_t micros     = static_cast<uint64_t>(ns) / 1000;
+        temp.microSecond    = micros % 1000;
+        temp.miliSecond     = (micros / 1000) % 1000;
+
+        uint64_t seconds    = micros / 1000000;
+        temp.second         = seconds % 60;
+        temp.minute         = (seconds / 60) % 60;
+        temp.hour           = static_cast<unsigned int>(seconds / 3600);
+
+        return temp;
+    }
+
+    std::string BlackStopwatch::toString(int64_t ns)
+    {
+        std::ostringstream output;
+        int64_t magnitude = (ns < 0) ? -ns : ns;
+
+        if( magnitude < 1000 )
+        {
+            output << ns << " ns";
+            return output.str();
+        }
+
+        output.setf(std::ios::fixed);
+        output.precision(3);
+
+        if( magnitude < 1000000LL )             { output << ns / 1e3 << " us"; }
+        else if( magnitude < 1000000000LL )     { output << ns / 1e6 << " ms"; }
+        else                                    { output << ns / 1e9 << " s";  }
+
+        return output.str();
+    }
+
+    uint64_t BlackStopwatch::readTicks()
+    {
+        if( this->clockType == BlackStopwatch::ClockCycleCounter )
+        {
+            return BlackStopwatch::readCycleCounter();
+        }
+
+        return static_cast<uint64_t>(BlackStopwatch::now());
+    }
+
+    int64_t BlackStopwatch::ticksToNanoseconds(uint64_t from, uint64_t to)
+    {
+        if( this->clockType == BlackStopwatch::ClockCycleCounter )
+        {
+            // 32 bit counter, unsigned difference handles one wrap around
+            uint64_t cycles = static_cast<uint32_t>(to - from);
+            return static_cast<int64_t>( (cycles * BlackStopwatch::getCycleScale()) >> 24 );
+        }
+
+        return static_cast<int64_t>(to - from);
+    }
+
+    bool BlackStopwatch::isCycleCounterEnabled()
+    {
+        #if defined(__arm__) && defined(__ARM_ARCH_7A__)
+            uint32_t userEnable;
+            uint32_t counterEnable;
+
+            // PMUSERENR is readable from user mode, other registers only if its EN bit is set
+            __asm__ __volatile__("mrc p15, 0, %0, c9, c14, 0" : "=r"(userEnable));
+            if( (userEnable & 1) == 0 )
+            {
+                return false;
+            }
+
+            __asm__ __volatile__("mrc p15, 0, %0, c9, c12, 1" : "=r"(counterEnable));
+            return ( (counterEnable & 0x80000000) != 0 );
+        #else
+            return false;
+        #endif
+    }
+
+    uint32_t BlackStopwatch::readCycleCounter()
+    {
+        #if defined(__arm__) && defined(__ARM_ARCH_7A__)
+            uint32_t cycles;
+            __asm__ __volatile__("mrc p15, 0, %0, c9, c13, 0" : "=r"(cycles));
+            return cycles;
+        #else
+            return 0;
+        #endif
+    }
+
+    uint64_t BlackStopwatch::getCycleScale()
+    {
+        // calibrated once, static initialization is thread safe
+        static const uint64_t scale = BlackStopwatch::calibrateCycleCounter();
+        return scale;
+    }
+
+    uint64_t BlackStopwatch::calibrateCycleCounter()
+    {
+        // count cycles during ~2 ms of CLOCK_MONOTONIC_RAW
+        int64_t  startNs     = BlackStopwatch::now();
+        uint32_t startCycles = BlackStopwatch::readCycleCounter();
+        int64_t  endNs       = startNs;
+
+        while( endNs - startNs < 2000000 )
+        {
+            endNs = BlackStopwatch::now();
+        }
+
+        uint32_t cycles = BlackStopwatch::readCycleCounter() - startCycles;
+
+        return (cycles > 0) ? ( (static_cast<uint64_t>(endNs - startNs) << 24) / cycles ) : (1ULL << 24);
+    }
+    // ############################################ BLACKSTOPWATCH DEFINITION ENDS ############################################ //
+
+
+} /* namespace BlackLib */
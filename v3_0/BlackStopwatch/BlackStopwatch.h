@@ -0,0 +1,222 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKSTOPWATCH_H_
+#define BLACKSTOPWATCH_H_
+
+#include "../BlackTime/BlackTime.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <time.h>
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKSTOPWATCH DECLARATION STARTS ########################################## //
+
+    /*! @brief Measures elapsed time in nanoseconds.
+    *
+    *    This class reads @b CLOCK_MONOTONIC_RAW, which is not slewed by NTP and doesn't jump with
+    *    wall-clock changes, so loop timing measurements stay correct while the system time is adjusted.
+    *    All results are plain @a int64_t nanoseconds; conversion to hours/minutes/seconds or text is done
+    *    only when toElapsed() or toString() is called.
+    *
+    *    Optionally the ARM cycle counter (PMCCNTR) can be used. It is read without a system call, but it
+    *    must be enabled for user space by the kernel (PMUSERENR). If it is not enabled or the platform is
+    *    not ARMv7, the stopwatch falls back to CLOCK_MONOTONIC_RAW silently; getClock() tells the used
+    *    source. Cycle counter is 32 bits wide, so it can measure intervals up to 2^32 cycles (about four
+    *    seconds at 1 GHz) and its frequency is calibrated once per process.
+    *
+    * @par Example
+    * @code{.cpp}
+    *  // Filename: myStopwatchProject.cpp
+    *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+    *
+    *  #include <iostream>
+    *  #include "BlackLib/BlackStopwatch/BlackStopwatch.h"
+    *
+    *  int main()
+    *  {
+    *       BlackLib::BlackStopwatch watch;
+    *       watch.start();
+    *
+    *       for( int i = 0 ; i < 3 ; i++ )
+    *       {
+    *           // loop body here
+    *           watch.lap();
+    *       }
+    *
+    *       int64_t total = watch.stop();
+    *
+    *       for( size_t i = 0 ; i < watch.getLaps().size() ; i++ )
+    *       {
+    *           std::cout << "Lap " << i << ": " << BlackLib::BlackStopwatch::toString(watch.getLaps()[i]) << std::endl;
+    *       }
+    *       std::cout << "Total: " << total << " ns" << std::endl;
+    *
+    *       return 0;
+    *  }
+    * @endcode
+    * @code{.cpp}
+    *   // Possible Output:
+    *   // Lap 0: 12.418 us
+    *   // Lap 1: 9.102 us
+    *   // Lap 2: 9.377 us
+    *   // Total: 30931 ns
+    * @endcode
+    */
+    class BlackStopwatch
+    {
+        public:
+
+            /*!
+            * This enum is used to define time source of the stopwatch.
+            */
+            enum stopwatchClock
+            {
+                ClockMonotonicRaw   = 0,        /*!< enumeration for @a CLOCK_MONOTONIC_RAW time source */
+                ClockCycleCounter   = 1         /*!< enumeration for @a ARM cycle counter time source */
+            };
+
+            /*! @brief Constructor of BlackStopwatch class.
+            *
+            * Stopwatch doesn't start until start() is called.
+            * @param [in] clk   requested time source
+            */
+            BlackStopwatch(BlackStopwatch::stopwatchClock clk = BlackStopwatch::ClockMonotonicRaw);
+
+            /*! @brief Clears the laps and starts the measurement.
+            */
+            void                    start();
+
+            /*! @brief Stops the measurement.
+            *
+            * @return Elapsed time in nanoseconds.
+            */
+            int64_t                 stop();
+
+            /*! @brief Restarts the measurement.
+            *
+            * @return Elapsed time before restarting, in nanoseconds.
+            */
+            int64_t                 restart();
+
+            /*! @brief Exports the elapsed time.
+            *
+            * If the stopwatch is stopped, the time between start() and stop() is exported.
+            * @return Elapsed time in nanoseconds.
+            */
+            int64_t                 elapsed();
+
+            /*! @brief Records a lap.
+            *
+            * @return Time since the previous lap or start() in nanoseconds.
+            */
+            int64_t                 lap();
+
+            /*! @brief Exports the recorded laps.
+            *
+            * @return Lap times in nanoseconds.
+            */
+            const std::vector<int64_t>& getLaps();
+
+            /*! @brief Checks the stopwatch is running or not.
+            */
+            bool                    isRunning();
+
+            /*! @brief Exports the used time source.
+            *
+            * @return BlackStopwatch::ClockCycleCounter if it is requested and available, else BlackStopwatch::ClockMonotonicRaw.
+            */
+            BlackStopwatch::stopwatchClock getClock();
+
+            /*! @brief Exports the current CLOCK_MONOTONIC_RAW time.
+            *
+            * @return Time in nanoseconds.
+            */
+            static int64_t          now();
+
+            /*! @brief Converts nanoseconds to BlackTimeElapsed.
+            *
+            * @param [in] ns    time in nanoseconds
+            */
+            static BlackTimeElapsed toElapsed(int64_t ns);
+
+            /*! @brief Converts nanoseconds to readable text with a suitable unit.
+            *
+            * @param [in] ns    time in nanoseconds
+            * @return Text like "850 ns", "12.418 us", "3.250 ms" or "1.500 s".
+            */
+            static std::string      toString(int64_t ns);
+
+        private:
+            BlackStopwatch::stopwatchClock clockType;   /*!< @brief is used to hold the used time source */
+            bool                    running;            /*!< @brief is used to hold the stopwatch is running or not */
+            uint64_t                startTicks;         /*!< @brief is used to hold the start time in ticks */
+            uint64_t                lapTicks;           /*!< @brief is used to hold the previous lap time in ticks */
+            int64_t                 stoppedTime;        /*!< @brief is used to hold the elapsed time at stop() */
+            std::vector<int64_t>    laps;               /*!< @brief is used to hold the lap times */
+
+            /*! @brief Reads the time source.
+            */
+            uint64_t                readTicks();
+
+            /*! @brief Converts tick difference of the time source to nanoseconds.
+            */
+            int64_t                 ticksToNanoseconds(uint64_t from, uint64_t to);
+
+            /*! @brief Checks the cycle counter can be read from user space.
+            */
+            static bool             isCycleCounterEnabled();
+
+            /*! @brief Reads the cycle counter.
+            */
+            static uint32_t         readCycleCounter();
+
+            /*! @brief Exports the calibrated nanoseconds per cycle as 8.24 fixed point number.
+            */
+            static uint64_t         getCycleScale();
+
+            /*! @brief Measures the cycle counter frequency against CLOCK_MONOTONIC_RAW.
+            */
+            static uint64_t         calibrateCycleCounter();
+    };
+
+    // ############################################ BLACKSTOPWATCH DECLARATION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKSTOPWATCH_H_ */
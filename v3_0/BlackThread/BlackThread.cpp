@@ -15,13 +15,40 @@ namespace BlackLib
         this->nativeThread      = 0;
         this->threadState       = BlackThread::Stateless;
         this->threadPriority    = BlackThread::PriorityDEFAULT;
+        this->threadPolicy      = BlackThread::PolicyRR;
         this->isCreated         = false;
+        this->isJoinable        = false;
+        this->isAffinityEnabled = false;
+        this->stackSize         = 0;
+        this->guardSize         = 0;
+        this->isGuardSizeSet    = false;
+
+        CPU_ZERO(&(this->cpuAffinity));
+
+        this->parkPermit        = false;
+        this->stopRequest       = false;
+        this->pauseRequest      = false;
+
+        pthread_condattr_t conditionAttr;
+        pthread_condattr_init(&conditionAttr);
+        pthread_condattr_setclock(&conditionAttr, CLOCK_MONOTONIC);
+
+        pthread_mutex_init( &(this->parkMutex), NULL);
+        pthread_cond_init( &(this->parkCondition), &conditionAttr);
+        pthread_condattr_destroy(&conditionAttr);
 
         this->calculatePriorities();
     }
 
     BlackThread::~BlackThread()
     {
+        if( this->isJoinable )
+        {
+            pthread_detach(this->nativeThread);
+        }
+
+        pthread_cond_destroy( &(this->parkCondition) );
+        pthread_mutex_destroy( &(this->parkMutex) );
     }
 
     void BlackThread::calculatePriorities()
@@ -86,7 +113,7 @@ namespace BlackLib
                     priority.__sched_priority = this->priorities[tempThreadPriority];
 
                     isSet = ( (pthread_attr_setinheritsched(attr, PTHREAD_EXPLICIT_SCHED) == 0) and
-                              (pthread_attr_setschedpolicy( attr, SCHED_RR              ) == 0) and
+                              (pthread_attr_setschedpolicy( attr, this->getNativePolicy()) == 0) and
                               (pthread_attr_setschedparam(  attr, &priority             ) == 0)
                             );
                 }
@@ -126,7 +153,7 @@ namespace BlackLib
                 }
                 else
                 {
-                    policy                          = SCHED_RR;
+                    policy                          = this->getNativePolicy();
                     priority.__sched_priority       = this->priorities[tp];
                 }
 
@@ -173,6 +200,7 @@ namespace BlackLib
                         }
                     #endif
 
+                    case SCHED_FIFO:
                     case SCHED_RR:
                     {
                         if( priority.__sched_priority <= this->priorities[BlackThread::PriorityLOWEST] )
@@ -210,6 +238,220 @@ namespace BlackLib
         return this->threadPriority;
     }
 
+    BlackThread::policy BlackThread::setPolicy(BlackThread::policy tp)
+    {
+        this->threadPolicy = tp;
+
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            this->setPriority(this->threadPriority);
+        }
+
+        return this->threadPolicy;
+    }
+
+    BlackThread::policy BlackThread::getPolicy()
+    {
+        return this->threadPolicy;
+    }
+
+    int BlackThread::getNativePolicy()
+    {
+        return (this->threadPolicy == BlackThread::PolicyFIFO) ? SCHED_FIFO : SCHED_RR;
+    }
+
+    bool BlackThread::setCpuAffinity(const cpu_set_t &cpus)
+    {
+        if( CPU_COUNT(&cpus) == 0 )
+        {
+            return false;
+        }
+
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            if( pthread_setaffinity_np(this->nativeThread, sizeof(cpu_set_t), &cpus) != 0 )
+            {
+                return false;
+            }
+        }
+
+        this->cpuAffinity       = cpus;
+        this->isAffinityEnabled = true;
+        return true;
+    }
+
+    bool BlackThread::setCpuAffinity(int cpu)
+    {
+        if( cpu < 0 or cpu >= CPU_SETSIZE )
+        {
+            return false;
+        }
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(cpu, &cpus);
+
+        return this->setCpuAffinity(cpus);
+    }
+
+    int BlackThread::pinToIsolatedCore()
+    {
+        std::ifstream isolatedFile("/sys/devices/system/cpu/isolated", std::ios::in);
+        if( ! isolatedFile )
+        {
+            return -1;
+        }
+
+        // file content is a cpu list like "1-3,5", first cpu of the list is enough
+        std::string cpuList;
+        std::getline(isolatedFile, cpuList);
+        isolatedFile.close();
+
+        int  cpu      = 0;
+        bool hasDigit = false;
+        for( size_t i = 0 ; i < cpuList.size() and cpuList[i] >= '0' and cpuList[i] <= '9' ; i++ )
+        {
+            cpu      = cpu * 10 + (cpuList[i] - '0');
+            hasDigit = true;
+        }
+
+        if( not hasDigit or not this->setCpuAffinity(cpu) )
+        {
+            return -1;
+        }
+
+        return cpu;
+    }
+
+    void BlackThread::clearCpuAffinity()
+    {
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            cpu_set_t allCpus;
+            CPU_ZERO(&allCpus);
+
+            long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+            for( long i = 0 ; i < cpuCount and i < CPU_SETSIZE ; i++ )
+            {
+                CPU_SET(i, &allCpus);
+            }
+
+            pthread_setaffinity_np(this->nativeThread, sizeof(cpu_set_t), &allCpus);
+        }
+
+        CPU_ZERO(&(this->cpuAffinity));
+        this->isAffinityEnabled = false;
+    }
+
+    bool BlackThread::getCpuAffinity(cpu_set_t &cpus)
+    {
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            return (pthread_getaffinity_np(this->nativeThread, sizeof(cpu_set_t), &cpus) == 0);
+        }
+
+        if( this->isAffinityEnabled )
+        {
+            cpus = this->cpuAffinity;
+            return true;
+        }
+
+        return (sched_getaffinity(0, sizeof(cpu_set_t), &cpus) == 0);
+    }
+
+    bool BlackThread::setStackSize(size_t bytes)
+    {
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            return false;
+        }
+
+        this->stackSize = bytes;
+        return true;
+    }
+
+    size_t BlackThread::getStackSize()
+    {
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            pthread_attr_t  attr;
+            size_t          bytes = this->stackSize;
+
+            if( pthread_getattr_np(this->nativeThread, &attr) == 0 )
+            {
+                pthread_attr_getstacksize(&attr, &bytes);
+                pthread_attr_destroy(&attr);
+            }
+
+            return bytes;
+        }
+
+        return this->stackSize;
+    }
+
+    bool BlackThread::setGuardSize(size_t bytes)
+    {
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            return false;
+        }
+
+        this->guardSize         = bytes;
+        this->isGuardSizeSet    = true;
+        return true;
+    }
+
+    size_t BlackThread::getGuardSize()
+    {
+        pthread_attr_t  attr;
+        size_t          bytes = this->guardSize;
+
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            if( pthread_getattr_np(this->nativeThread, &attr) == 0 )
+            {
+                pthread_attr_getguardsize(&attr, &bytes);
+                pthread_attr_destroy(&attr);
+            }
+        }
+        else
+        if( not this->isGuardSizeSet )
+        {
+            pthread_attr_init(&attr);
+            pthread_attr_getguardsize(&attr, &bytes);
+            pthread_attr_destroy(&attr);
+        }
+
+        return bytes;
+    }
+
+    bool BlackThread::setName(const std::string &name)
+    {
+        // kernel keeps 16 bytes with the terminating null
+        this->threadName = name.substr(0, 15);
+
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            return (pthread_setname_np(this->nativeThread, this->threadName.c_str()) == 0);
+        }
+
+        return true;
+    }
+
+    std::string BlackThread::getName()
+    {
+        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        {
+            char name[16];
+            if( pthread_getname_np(this->nativeThread, name, sizeof(name)) == 0 )
+            {
+                return std::string(name);
+            }
+        }
+
+        return this->threadName;
+    }
+
 
 
 
@@ -218,11 +460,39 @@ namespace BlackLib
     {
         if( (this->threadState == BlackThread::Stateless) or (this->threadState == BlackThread::Stopped))
         {
+            // previous thread is finished, its resources are released before starting a new one
+            this->waitUntilFinish();
+
+            // state is set before the thread starts, so a body which finishes at once isn't reported as running
+            pthread_mutex_lock( &(this->parkMutex) );
+            BlackThread::state previousState = this->threadState;
+            this->parkPermit    = false;
+            this->stopRequest   = false;
+            this->pauseRequest  = false;
+            this->threadState   = BlackThread::Running;
+            pthread_mutex_unlock( &(this->parkMutex) );
+
             pthread_attr_t      threadConstructorAttrs;
             pthread_attr_init(&(threadConstructorAttrs));
 
             this->setAttribute(&(threadConstructorAttrs), this->threadPriority);
 
+            if( this->stackSize > 0 )
+            {
+                size_t minStackSize  = static_cast<size_t>(PTHREAD_STACK_MIN);
+                size_t tempStackSize = (this->stackSize < minStackSize) ? minStackSize : this->stackSize;
+                pthread_attr_setstacksize(&(threadConstructorAttrs), tempStackSize);
+            }
+
+            if( this->isGuardSizeSet )
+            {
+                pthread_attr_setguardsize(&(threadConstructorAttrs), this->guardSize);
+            }
+
+            if( this->isAffinityEnabled )
+            {
+                pthread_attr_setaffinity_np(&(threadConstructorAttrs), sizeof(cpu_set_t), &(this->cpuAffinity));
+            }
 
             this->isCreated = (pthread_create( &(this->nativeThread),
                                                &(threadConstructorAttrs),
@@ -231,9 +501,22 @@ namespace BlackLib
                                              ) == 0
                               );
 
-            if(this->isCreated)
+            pthread_attr_destroy(&(threadConstructorAttrs));
+
+            if( not this->isCreated )
+            {
+                pthread_mutex_lock( &(this->parkMutex) );
+                this->threadState = previousState;
+                pthread_mutex_unlock( &(this->parkMutex) );
+            }
+            else
             {
-                this->threadState = BlackThread::Running;
+                this->isJoinable  = true;
+
+                if( not this->threadName.empty() )
+                {
+                    pthread_setname_np(this->nativeThread, this->threadName.c_str());
+                }
             }
         }
 
@@ -256,14 +539,104 @@ namespace BlackLib
 
     void BlackThread::pause()
     {
-        if(this->threadState == BlackThread::Running)
+        // parked thread is woken up without a permit, so its next park() still waits
+        pthread_mutex_lock( &(this->parkMutex) );
+        this->pauseRequest = true;
+        pthread_cond_broadcast( &(this->parkCondition) );
+        pthread_mutex_unlock( &(this->parkMutex) );
+    }
+
+    void BlackThread::resume()
+    {
+        pthread_mutex_lock( &(this->parkMutex) );
+        this->pauseRequest = false;
+        pthread_cond_broadcast( &(this->parkCondition) );
+        pthread_mutex_unlock( &(this->parkMutex) );
+    }
+
+    void BlackThread::requestPause()
+    {
+        this->pauseRequest = true;
+    }
+
+    void BlackThread::requestStop()
+    {
+        this->stopRequest = true;
+        this->unpark();
+    }
+
+    bool BlackThread::isStopRequested()
+    {
+        return this->stopRequest;
+    }
+
+    bool BlackThread::checkPoint()
+    {
+        if( this->pauseRequest and not this->stopRequest )
         {
             this->threadState = BlackThread::Paused;
             this->onPauseHandler();
 
+            pthread_mutex_lock( &(this->parkMutex) );
+            while( this->pauseRequest and not this->stopRequest )
+            {
+                pthread_cond_wait( &(this->parkCondition), &(this->parkMutex) );
+            }
+            pthread_mutex_unlock( &(this->parkMutex) );
+
             this->threadState = BlackThread::Running;
             this->onResumeHandler();
         }
+
+        return (not this->stopRequest);
+    }
+
+    void BlackThread::park()
+    {
+        pthread_mutex_lock( &(this->parkMutex) );
+        while( not this->parkPermit and not this->stopRequest and not this->pauseRequest )
+        {
+            pthread_cond_wait( &(this->parkCondition), &(this->parkMutex) );
+        }
+        this->parkPermit = false;
+        pthread_mutex_unlock( &(this->parkMutex) );
+    }
+
+    bool BlackThread::parkFor(unsigned int usec)
+    {
+        timespec until;
+        clock_gettime(CLOCK_MONOTONIC, &until);
+
+        unsigned long long nanoseconds = until.tv_nsec + static_cast<unsigned long long>(usec) * 1000;
+        until.tv_sec    += nanoseconds / 1000000000;
+        until.tv_nsec    = nanoseconds % 1000000000;
+
+        return this->parkUntil(until);
+    }
+
+    bool BlackThread::parkUntil(const timespec &until)
+    {
+        pthread_mutex_lock( &(this->parkMutex) );
+        while( not this->parkPermit and not this->stopRequest and not this->pauseRequest )
+        {
+            if( pthread_cond_timedwait( &(this->parkCondition), &(this->parkMutex), &until) != 0 )
+            {
+                break;
+            }
+        }
+        bool isWokenUp      = ( this->parkPermit or this->stopRequest or this->pauseRequest );
+        this->parkPermit    = false;
+        pthread_mutex_unlock( &(this->parkMutex) );
+
+        return isWokenUp;
+    }
+
+    void BlackThread::unpark()
+    {
+        pthread_mutex_lock( &(this->parkMutex) );
+        this->parkPermit = true;
+        pthread_cond_signal( &(this->parkCondition) );
+        pthread_mutex_unlock( &(this->parkMutex) );
     }
 
 
@@ -275,16 +648,45 @@ namespace BlackLib
 
     void BlackThread::waitUntilFinish()
     {
-        if( (this->threadState == BlackThread::Running) or (this->threadState == BlackThread::Paused))
+        if( this->isJoinable )
         {
             pthread_join(this->nativeThread,NULL);
+            this->isJoinable = false;
+        }
+    }
+
+    bool BlackThread::waitUntilFinish(unsigned int msec)
+    {
+        if( this->isJoinable )
+        {
+            // pthread_timedjoin_np() works with CLOCK_REALTIME
+            timespec until;
+            clock_gettime(CLOCK_REALTIME, &until);
+
+            unsigned long long nanoseconds = until.tv_nsec + static_cast<unsigned long long>(msec) * 1000000;
+            until.tv_sec    += nanoseconds / 1000000000;
+            until.tv_nsec    = nanoseconds % 1000000000;
+
+            if( pthread_timedjoin_np(this->nativeThread, NULL, &until) != 0 )
+            {
+                return false;
+            }
+
+            this->isJoinable = false;
         }
+
+        return true;
     }
 
     void  BlackThread::cleanUp(void *thread)
     {
-        ((BlackLib::BlackThread*)thread)->onStopHandler();
-        ((BlackLib::BlackThread*)thread)->threadState  = BlackThread::Stopped;
+        BlackLib::BlackThread *finishedThread = (BlackLib::BlackThread*)thread;
+
+        finishedThread->onStopHandler();
+
+        pthread_mutex_lock( &(finishedThread->parkMutex) );
+        finishedThread->threadState = BlackThread::Stopped;
+        pthread_mutex_unlock( &(finishedThread->parkMutex) );
     }
 
 
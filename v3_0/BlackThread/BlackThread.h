@@ -36,6 +36,10 @@
 #include <pthread.h>
 #include <sched.h>
 #include <vector>
+#include <string>
+#include <fstream>
+#include <limits.h>
+#include <time.h>
 #include <unistd.h>
 
 
@@ -278,6 +282,16 @@ namespace BlackLib
                 #endif
             };
 
+            /*!
+            * This enum is used to define thread's real-time scheduling policy. It is used with all
+            * priorities except PriorityDEFAULT and PriorityIDLE.
+            */
+            enum policy
+            {
+                PolicyRR         = 0,         /*!< enumeration for @a round-robin (SCHED_RR) scheduling */
+                PolicyFIFO       = 1          /*!< enumeration for @a first-in first-out (SCHED_FIFO) scheduling */
+            };
+
             /*! @brief Constructor of BlackThread class.
             *
             * This function sets the thread state to "stateless", thread priority to "default"
@@ -405,6 +419,138 @@ namespace BlackLib
             */
             BlackThread::priority   getPriority();
 
+            /*! @brief Changes the real-time scheduling policy of thread.
+            *
+            * This function selects SCHED_RR or SCHED_FIFO for the priorities from PriorityLOWEST to
+            * PriorityHIGHEST. If the thread is running, current priority is applied again with new policy.
+            * Default policy is BlackThread::PolicyRR.
+            *
+            * @param [in] tp    new scheduling policy
+            * @return Current scheduling policy.
+            *
+            * @par Example
+            *  @code{.cpp}
+            *   Task1 *t1 = new Task1();
+            *   t1->setPolicy(BlackLib::BlackThread::PolicyFIFO);
+            *   t1->setPriority(BlackLib::BlackThread::PriorityHIGHEST);
+            *   t1->run();
+            * @endcode
+            */
+            BlackThread::policy     setPolicy(BlackThread::policy tp);
+
+            /*! @brief Exports the real-time scheduling policy of thread.
+            *
+            *  @return Current scheduling policy.
+            */
+            BlackThread::policy     getPolicy();
+
+            /*! @brief Selects the cpus which thread is allowed to run on.
+            *
+            * If the thread is not running, the mask is stored and applied with pthread_attr_setaffinity_np()
+            * when run() is called. Otherwise it is applied to the running thread immediately.
+            *
+            * @param [in] cpus  allowed cpu set
+            * @return true if the mask is stored or applied successfully else false.
+            *
+            * @par Example
+            *  @code{.cpp}
+            *   cpu_set_t cpus;
+            *   CPU_ZERO(&cpus);
+            *   CPU_SET(1, &cpus);
+            *
+            *   Task1 *t1 = new Task1();
+            *   t1->setCpuAffinity(cpus);
+            *   t1->run();
+            * @endcode
+            */
+            bool                    setCpuAffinity(const cpu_set_t &cpus);
+
+            /*! @brief Pins the thread to a single cpu.
+            *
+            * @param [in] cpu   cpu index
+            * @return true if the cpu index is valid and setting is successful else false.
+            * @sa setCpuAffinity(const cpu_set_t&)
+            */
+            bool                    setCpuAffinity(int cpu);
+
+            /*! @brief Pins the thread to the first cpu which is isolated from the scheduler.
+            *
+            * Isolated cpus are read from @b /sys/devices/system/cpu/isolated, which is filled by
+            * the @b isolcpus kernel parameter. General tasks and most of the interrupts don't run on
+            * these cpus, so a thread pinned to one of them doesn't migrate and isn't preempted by
+            * unrelated work.
+            *
+            * @return Selected cpu index or -1 if there isn't any isolated cpu.
+            */
+            int                     pinToIsolatedCore();
+
+            /*! @brief Removes the cpu affinity setting.
+            *
+            * The thread can run on all cpus after this call.
+            */
+            void                    clearCpuAffinity();
+
+            /*! @brief Exports the cpu affinity of thread.
+            *
+            * If the thread is running, the mask is read from the thread. Otherwise stored setting is
+            * exported and all cpus are set in it when no affinity is selected.
+            *
+            * @param [out] cpus allowed cpu set
+            * @return true if exporting is successful else false.
+            */
+            bool                    getCpuAffinity(cpu_set_t &cpus);
+
+            /*! @brief Changes the stack size of thread.
+            *
+            * This setting is applied when run() is called. Zero means the system default size.
+            * Sizes under PTHREAD_STACK_MIN are raised to it.
+            *
+            * @param [in] bytes stack size in bytes
+            * @return false if the thread is running else true.
+            */
+            bool                    setStackSize(size_t bytes);
+
+            /*! @brief Exports the stack size of thread.
+            *
+            * If the thread is running, the size is read from the thread attributes.
+            * @return Stack size in bytes, zero means the system default.
+            */
+            size_t                  getStackSize();
+
+            /*! @brief Changes the guard area size at the end of the thread stack.
+            *
+            * This setting is applied when run() is called. Zero disables the guard area.
+            *
+            * @param [in] bytes guard size in bytes
+            * @return false if the thread is running else true.
+            */
+            bool                    setGuardSize(size_t bytes);
+
+            /*! @brief Exports the guard area size of thread stack.
+            *
+            * If the thread is running, the size is read from the thread attributes.
+            * @return Guard size in bytes.
+            */
+            size_t                  getGuardSize();
+
+            /*! @brief Changes the name of thread.
+            *
+            * The name is visible in @b top, @b ps and @b /proc. Names are truncated to 15 characters
+            * because of the kernel limit. If the thread is not running, the name is applied when
+            * run() is called.
+            *
+            * @param [in] name  new thread name
+            * @return true if the name is stored or applied successfully else false.
+            */
+            bool                    setName(const std::string &name);
+
+            /*! @brief Exports the name of thread.
+            *
+            * If the thread is running, the name is read from the thread.
+            * @return Thread name.
+            */
+            std::string             getName();
+
             /*! @brief Exports the thread native id.
             *
             *  @return thread id.
@@ -684,7 +830,8 @@ namespace BlackLib
 
             /*! @brief Waits thread until it finished.
             *
-            *  This function joins the thread if thread's state is "running" or "paused". This means
+            *  This function joins the thread if it is started and not joined yet, even if it has already
+            *  reached "stopped" state, so every started thread is joined exactly once. This means
             *  the program will wait here until the thread function (in other words @a onStartHandler
             *  function) finishes. This function should use before the last line of main code (before
             *  "return 0;" line at the main.cpp). Users can use WAIT_THREAD_FINISH() macro also. It is
@@ -744,6 +891,23 @@ namespace BlackLib
             */
             void                    waitUntilFinish();
 
+            /*! @brief Waits thread until it finished or timeout occurs.
+            *
+            *  @param [in] msec     timeout in milliseconds
+            *  @return true if the thread is joined or there isn't a started thread to join else false.
+            *
+            * @par Example
+            *  @code{.cpp}
+            *   t1->requestStop();
+            *
+            *   if( ! t1->waitUntilFinish(100) )
+            *   {
+            *       std::cout << "Task1 didn't stop in 100 ms." << std::endl;
+            *   }
+            * @endcode
+            */
+            bool                    waitUntilFinish(unsigned int msec);
+
             /*! @brief Exports thread's run state.
             *
             *  @return true if thread's state is "running" or "paused" else false.
@@ -858,10 +1022,13 @@ namespace BlackLib
 
             /*! @brief Pauses thread execution.
             *
-            *  Actually this function calls onPauseHandler() and then calls onResumeHandler() function
-            *  only. Users should define the behaviour of thread when this function called(thread paused),
-            *  by overloading onPauseHandler() and onResumeHandler() function on theirs own derived class.
-            *  If users did not overload this/these function(s) on derived class, this function does nothing.
+            *  This function doesn't block the caller. It sets the pause request like requestPause() and
+            *  wakes up the thread if it is parked, so the thread pauses at its next checkPoint() call.
+            *  There the thread calls onPauseHandler(), waits until resume() or requestStop() is called
+            *  and then calls onResumeHandler(); both handlers run on the paused thread. The thread waits
+            *  on a condition variable, so it doesn't use cpu while it is paused. Users should define the
+            *  behaviour of thread when it is paused and resumed, by overloading onPauseHandler() and
+            *  onResumeHandler() function on theirs own derived class.
             *
             * @par Example
             *  @code{.cpp}
@@ -870,11 +1037,10 @@ namespace BlackLib
             *       public:
             *           void onStartHandler()
             *           {
-            *               // do something here
-            *
-            *               this->pause();
-            *
-            *               // do something here
+            *               while( this->checkPoint() )
+            *               {
+            *                   // do something here
+            *               }
             *           }
             *
             *           void onStopHandler()
@@ -915,6 +1081,11 @@ namespace BlackLib
             *       t1->run();
             *       t2->run();
             *
+            *       t1->pause();            // t1 pauses at its next checkPoint() call
+            *       BlackLib::BlackThread::sleep(1);
+            *       t1->resume();
+            *       t1->requestStop();
+            *
             *       WAIT_THREAD_FINISH(t1)
             *       WAIT_THREAD_FINISH(t2)
             *
@@ -924,18 +1095,143 @@ namespace BlackLib
             *
             * @sa onPauseHandler()
             * @sa onResumeHandler()
+            * @sa checkPoint()
+            * @sa resume()
             */
             void                    pause();
 
+            /*! @brief Resumes a paused thread.
+            *
+            *  This function is called from another thread. It clears the pause request, so if the thread
+            *  isn't paused yet, its next checkPoint() call doesn't pause.
+            *
+            * @sa pause()
+            * @sa requestPause()
+            */
+            void                    resume();
+
+            /*! @brief Asks the thread to pause at its next checkPoint() call.
+            *
+            *  This function is called from another thread. The thread stays paused until resume() or
+            *  requestStop() is called.
+            *
+            * @par Example
+            *  @code{.cpp}
+            *  class Sampler : public BlackLib::BlackThread
+            *  {
+            *       public:
+            *           void onStartHandler()
+            *           {
+            *               while( this->checkPoint() )
+            *               {
+            *                   // read a sample here
+            *               }
+            *           }
+            *  };
+            *
+            *  int main()
+            *  {
+            *       Sampler *s = new Sampler();
+            *       s->run();
+            *
+            *       s->requestPause();      // sampler sleeps without using cpu
+            *       BlackLib::BlackThread::sleep(1);
+            *       s->resume();            // sampler continues
+            *
+            *       s->requestStop();
+            *       WAIT_THREAD_FINISH(s)
+            *
+            *       return 0;
+            *  }
+            * @endcode
+            *
+            * @sa checkPoint()
+            */
+            void                    requestPause();
+
+            /*! @brief Asks the thread to finish.
+            *
+            *  This function sets the stop request which is read by isStopRequested() and checkPoint()
+            *  and wakes up the thread if it is paused or parked. The thread finishes when its
+            *  onStartHandler() function returns. Unlike stop(), this function is safe to call from
+            *  other threads.
+            */
+            void                    requestStop();
+
+            /*! @brief Checks the stop request.
+            *
+            *  @return true if requestStop() is called after the last run() else false.
+            */
+            bool                    isStopRequested();
+
+            /*! @brief Handles pause and stop requests.
+            *
+            *  This function is called from the thread itself, generally as the condition of its
+            *  main loop. If requestPause() is called before, the thread pauses here.
+            *
+            *  @return false if the thread should finish else true.
+            *
+            * @sa requestPause()
+            * @sa requestStop()
+            */
+            bool                    checkPoint();
+
+            /*! @brief Blocks the thread until unpark(), requestStop() or pause() is called.
+            *
+            *  This function is called from the thread itself. Every unpark() call gives one permit.
+            *  If the permit is given before, this function consumes it and returns immediately. A pending
+            *  pause request also makes it return, so the thread can reach its checkPoint() call.
+            *
+            * @sa unpark()
+            */
+            void                    park();
+
+            /*! @brief Blocks the thread until unpark(), requestStop() or pause() is called or timeout occurs.
+            *
+            *  @param [in] usec     timeout in microseconds
+            *  @return true if the thread is woken up by unpark(), requestStop() or a pause request else false.
+            */
+            bool                    parkFor(unsigned int usec);
+
+            /*! @brief Blocks the thread until unpark(), requestStop() or pause() is called or deadline passes.
+            *
+            *  The deadline is absolute, so periodic waits which add their period to the previous deadline
+            *  don't drift.
+            *  @param [in] until    absolute @b CLOCK_MONOTONIC deadline
+            *  @return true if the thread is woken up by unpark(), requestStop() or a pause request else false.
+            */
+            bool                    parkUntil(const timespec &until);
+
+            /*! @brief Wakes up the parked thread.
+            *
+            *  This function is called from another thread.
+            *
+            * @sa park()
+            */
+            void                    unpark();
+
 
 
         private:
 
             bool                    isCreated;                  /*!< @brief is used to hold the thread is created or not */
+            bool                    isJoinable;                 /*!< @brief is used to hold the thread is started and not joined yet */
             pthread_t               nativeThread;               /*!< @brief is used to hold the thread's posix id */
             BlackThread::state      threadState;                /*!< @brief is used to hold the thread state */
             BlackThread::priority   threadPriority;             /*!< @brief is used to hold the thread priority */
+            BlackThread::policy     threadPolicy;               /*!< @brief is used to hold the thread real-time scheduling policy */
+            cpu_set_t               cpuAffinity;                /*!< @brief is used to hold the selected cpu affinity mask */
+            bool                    isAffinityEnabled;          /*!< @brief is used to hold the cpu affinity is selected or not */
+            size_t                  stackSize;                  /*!< @brief is used to hold the stack size, zero means default */
+            size_t                  guardSize;                  /*!< @brief is used to hold the stack guard size */
+            bool                    isGuardSizeSet;             /*!< @brief is used to hold the guard size is selected or not */
+            std::string             threadName;                 /*!< @brief is used to hold the thread name */
             std::vector<int>        priorities;                 /*!< @brief is used to hold the OS based calculated priority values */
+            pthread_mutex_t         parkMutex;                  /*!< @brief is used to protect the park permit */
+            pthread_cond_t          parkCondition;              /*!< @brief is used to wake up the parked thread */
+            bool                    parkPermit;                 /*!< @brief is used to hold the unpark() permit */
+            volatile bool           stopRequest;                /*!< @brief is used to hold the stop request */
+            volatile bool           pauseRequest;               /*!< @brief is used to hold the pause request */
 
 
             /*! @brief Thread's stop handler function.
@@ -995,8 +1291,8 @@ namespace BlackLib
 
             /*! @brief Thread's pause handler function.
             *
-            *  This function should overload at user's derived class. This function calls from
-            *  pause() function. Users should not call this function directly.
+            *  This function should overload at user's derived class. This function is called
+            *  from checkPoint() on the thread itself, when it pauses. Users should not call this function directly.
             *
             * @par Example
             *  @code{.cpp}
@@ -1005,11 +1301,10 @@ namespace BlackLib
             *       public:
             *           void onStartHandler()
             *           {
-            *               // do something here
-            *
-            *               this->pause();
-            *
-            *               // do something here
+            *               while( this->checkPoint() )
+            *               {
+            *                   // do something here
+            *               }
             *           }
             *
             *           void onStopHandler()
@@ -1063,8 +1358,8 @@ namespace BlackLib
 
             /*! @brief Thread's resume handler function.
             *
-            *  This function should overload at user's derived class. This function calls from
-            *  pause() function. Users should not call this function directly.
+            *  This function should overload at user's derived class. This function is called
+            *  from checkPoint() on the thread itself, when it pauses. Users should not call this function directly.
             *
             * @par Example
             *  @code{.cpp}
@@ -1073,11 +1368,10 @@ namespace BlackLib
             *       public:
             *           void onStartHandler()
             *           {
-            *               // do something here
-            *
-            *               this->pause();
-            *
-            *               // do something here
+            *               while( this->checkPoint() )
+            *               {
+            *                   // do something here
+            *               }
             *           }
             *
             *           void onStopHandler()
@@ -1210,6 +1504,12 @@ namespace BlackLib
             */
             void                    calculatePriorities();
 
+            /*! @brief Exports posix scheduling policy of current real-time policy.
+            *
+            *  @return SCHED_RR or SCHED_FIFO.
+            */
+            int                     getNativePolicy();
+
             /*! @brief Thread's exit function.
             *
             *  This function calls onStopHandler() function when it called by posix thread's
@@ -0,0 +1,440 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackThreadPool.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ############################################ BLACKTASKSTATE DEFINITION STARTS ########################################### //
+    BlackTaskState::BlackTaskState()
+    {
+        this->done = false;
+
+        pthread_condattr_t conditionAttr;
+        pthread_condattr_init(&conditionAttr);
+        pthread_condattr_setclock(&conditionAttr, CLOCK_MONOTONIC);
+
+        pthread_mutex_init( &(this->mutex), NULL);
+        pthread_cond_init( &(this->condition), &conditionAttr);
+        pthread_condattr_destroy(&conditionAttr);
+    }
+
+    BlackTaskState::~BlackTaskState()
+    {
+        pthread_cond_destroy( &(this->condition) );
+        pthread_mutex_destroy( &(this->mutex) );
+    }
+
+    void BlackTaskState::setDone()
+    {
+        pthread_mutex_lock( &(this->mutex) );
+        this->done = true;
+        pthread_cond_broadcast( &(this->condition) );
+        pthread_mutex_unlock( &(this->mutex) );
+    }
+
+    bool BlackTaskState::isDone()
+    {
+        pthread_mutex_lock( &(this->mutex) );
+        bool isFinished = this->done;
+        pthread_mutex_unlock( &(this->mutex) );
+
+        return isFinished;
+    }
+
+    void BlackTaskState::wait()
+    {
+        pthread_mutex_lock( &(this->mutex) );
+        while( not this->done )
+        {
+            pthread_cond_wait( &(this->condition), &(this->mutex) );
+        }
+        pthread_mutex_unlock( &(this->mutex) );
+    }
+
+    bool BlackTaskState::waitFor(unsigned int msec)
+    {
+        timespec until;
+        clock_gettime(CLOCK_MONOTONIC, &until);
+
+        uint64_t nanoseconds = until.tv_nsec + static_cast<uint64_t>(msec) * 1000000;
+        until.tv_sec        += nanoseconds / 1000000000;
+        until.tv_nsec        = nanoseconds % 1000000000;
+
+        pthread_mutex_lock( &(this->mutex) );
+        while( not this->done )
+        {
+            if( pthread_cond_timedwait( &(this->condition), &(this->mutex), &until) != 0 )
+            {
+                break;
+            }
+        }
+        bool isFinished = this->done;
+        pthread_mutex_unlock( &(this->mutex) );
+
+        return isFinished;
+    }
+    // ############################################# BLACKTASKSTATE DEFINITION ENDS ############################################ //
+
+
+
+
+
+    // ########################################### BLACKTHREADPOOL DEFINITION STARTS ########################################### //
+    BlackThreadPool::worker::worker(BlackThreadPool *ownerPool, size_t queueIndex)
+    {
+        this->pool  = ownerPool;
+        this->index = queueIndex;
+    }
+
+    void BlackThreadPool::worker::onStartHandler()
+    {
+        this->pool->workerLoop(this->index);
+    }
+
+    void BlackThreadPool::indexLoop::operator()(size_t first, size_t last)
+    {
+        for( size_t i = first ; i < last ; i++ )
+        {
+            (*(this->body))(i);
+        }
+    }
+
+    void BlackThreadPool::rangeTask::operator()()
+    {
+        (*(this->body))(this->begin, this->end);
+
+        if( __sync_sub_and_fetch( &(this->group->remaining), 1) == 0 )
+        {
+            this->group->state.setDone();
+        }
+    }
+
+
+
+    BlackThreadPool::BlackThreadPool(unsigned int workerCount, BlackThread::priority tp)
+    {
+        this->pendingTasks      = 0;
+        this->stolenTasks       = 0;
+        this->nextQueue         = 0;
+        this->isStopping        = false;
+        this->runningWorkers    = 0;
+
+        pthread_mutex_init( &(this->idleMutex), NULL);
+        pthread_cond_init( &(this->idleCondition), NULL);
+
+        if( workerCount == 0 )
+        {
+            long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+            workerCount   = (cpuCount > 0) ? static_cast<unsigned int>(cpuCount) : 1;
+        }
+
+        for( unsigned int i = 0 ; i < workerCount ; i++ )
+        {
+            this->queues.push_back( new taskQueue() );
+        }
+
+        for( unsigned int i = 0 ; i < workerCount ; i++ )
+        {
+            worker *newWorker = new worker(this, i);
+            newWorker->setPriority(tp);
+            newWorker->run();
+
+            if( newWorker->isRunning() )
+            {
+                this->runningWorkers++;
+            }
+
+            this->workers.push_back(newWorker);
+        }
+    }
+
+    BlackThreadPool::~BlackThreadPool()
+    {
+        this->shutdown();
+
+        for( size_t i = 0 ; i < this->workers.size() ; i++ )
+        {
+            delete this->workers[i];
+        }
+
+        for( size_t i = 0 ; i < this->queues.size() ; i++ )
+        {
+            delete this->queues[i];
+        }
+
+        pthread_cond_destroy( &(this->idleCondition) );
+        pthread_mutex_destroy( &(this->idleMutex) );
+    }
+
+    bool BlackThreadPool::pushTask(const std::function<void()> &task)
+    {
+        if( this->isStopping )
+        {
+            return false;
+        }
+
+        if( this->runningWorkers == 0 )
+        {
+            task();
+            return true;
+        }
+
+        size_t index = __sync_fetch_and_add( &(this->nextQueue), 1) % this->queues.size();
+
+        // counted before queueing, so the counter never goes under the real task count
+        __sync_fetch_and_add( &(this->pendingTasks), 1);
+
+        this->queues[index]->mutex.lock();
+        this->queues[index]->tasks.push_back(task);
+        this->queues[index]->mutex.unlock();
+
+        pthread_mutex_lock( &(this->idleMutex) );
+        pthread_cond_signal( &(this->idleCondition) );
+        pthread_mutex_unlock( &(this->idleMutex) );
+
+        return true;
+    }
+
+    bool BlackThreadPool::popTask(size_t index, std::function<void()> &task)
+    {
+        taskQueue *queue = this->queues[index];
+        bool isPopped    = false;
+
+        queue->mutex.lock();
+        if( not queue->tasks.empty() )
+        {
+            task = queue->tasks.back();
+            queue->tasks.pop_back();
+            isPopped = true;
+        }
+        queue->mutex.unlock();
+
+        if( isPopped )
+        {
+            __sync_fetch_and_sub( &(this->pendingTasks), 1);
+        }
+
+        return isPopped;
+    }
+
+    bool BlackThreadPool::stealTask(size_t thiefIndex, std::function<void()> &task)
+    {
+        size_t queueCount = this->queues.size();
+
+        for( size_t i = 1 ; i <= queueCount ; i++ )
+        {
+            taskQueue *victim = this->queues[(thiefIndex + i) % queueCount];
+            bool isStolen     = false;
+
+            victim->mutex.lock();
+            if( not victim->tasks.empty() )
+            {
+                task = victim->tasks.front();
+                victim->tasks.pop_front();
+                isStolen = true;
+            }
+            victim->mutex.unlock();
+
+            if( isStolen )
+            {
+                __sync_fetch_and_sub( &(this->pendingTasks), 1);
+                __sync_fetch_and_add( &(this->stolenTasks), 1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool BlackThreadPool::runPendingTask()
+    {
+        if( this->pendingTasks == 0 )
+        {
+            return false;
+        }
+
+        std::function<void()> task;
+        size_t startIndex = __sync_fetch_and_add( &(this->nextQueue), 1) % this->queues.size();
+
+        if( this->popTask(startIndex, task) or this->stealTask(startIndex, task) )
+        {
+            task();
+            return true;
+        }
+
+        return false;
+    }
+
+    void BlackThreadPool::helpUntilDone(BlackTaskState &state)
+    {
+        while( not state.isDone() )
+        {
+            if( not this->runPendingTask() )
+            {
+                // remaining tasks are already running on the workers
+                state.wait();
+            }
+        }
+    }
+
+    void BlackThreadPool::workerLoop(size_t index)
+    {
+        std::function<void()> task;
+
+        while( true )
+        {
+            if( this->popTask(index, task) or this->stealTask(index, task) )
+            {
+                task();
+                task = std::function<void()>();
+                continue;
+            }
+
+            pthread_mutex_lock( &(this->idleMutex) );
+            while( this->pendingTasks == 0 and not this->isStopping )
+            {
+                pthread_cond_wait( &(this->idleCondition), &(this->idleMutex) );
+            }
+            bool isFinished = ( this->isStopping and this->pendingTasks == 0 );
+            pthread_mutex_unlock( &(this->idleMutex) );
+
+            if( isFinished )
+            {
+                break;
+            }
+        }
+    }
+
+    bool BlackThreadPool::execute(const std::function<void()> &task)
+    {
+        return this->pushTask(task);
+    }
+
+    void BlackThreadPool::parallelFor(size_t begin, size_t end,
+                                      const std::function<void(size_t)> &body,
+                                      size_t grainSize)
+    {
+        indexLoop loop;
+        loop.body = &body;
+
+        this->parallelForRange(begin, end, loop, grainSize);
+    }
+
+    void BlackThreadPool::parallelForRange(size_t begin, size_t end,
+                                           const std::function<void(size_t, size_t)> &body,
+                                           size_t grainSize)
+    {
+        if( begin >= end )
+        {
+            return;
+        }
+
+        size_t length = end - begin;
+
+        if( grainSize == 0 )
+        {
+            // a few chunks per worker keeps the load balanced without queueing tiny tasks
+            size_t chunkCount = this->runningWorkers * 4;
+            grainSize         = (chunkCount > 0) ? (length + chunkCount - 1) / chunkCount : length;
+        }
+
+        size_t chunkCount = (length + grainSize - 1) / grainSize;
+
+        if( this->isStopping or this->runningWorkers == 0 or chunkCount == 1 )
+        {
+            body(begin, end);
+            return;
+        }
+
+        std::shared_ptr<rangeGroup> group(new rangeGroup());
+        group->remaining = chunkCount;
+
+        for( size_t first = begin ; first < end ; first += grainSize )
+        {
+            rangeTask chunk;
+            chunk.group = group;
+            chunk.body  = &body;
+            chunk.begin = first;
+            chunk.end   = (end - first > grainSize) ? first + grainSize : end;
+
+            if( not this->pushTask(chunk) )
+            {
+                chunk();
+            }
+        }
+
+        this->helpUntilDone(group->state);
+    }
+
+    void BlackThreadPool::shutdown()
+    {
+        pthread_mutex_lock( &(this->idleMutex) );
+        this->isStopping = true;
+        pthread_cond_broadcast( &(this->idleCondition) );
+        pthread_mutex_unlock( &(this->idleMutex) );
+
+        for( size_t i = 0 ; i < this->workers.size() ; i++ )
+        {
+            WAIT_THREAD_FINISH(this->workers[i])
+        }
+
+        this->runningWorkers = 0;
+    }
+
+    bool BlackThreadPool::isShutdown()
+    {
+        return this->isStopping;
+    }
+
+    size_t BlackThreadPool::getWorkerCount()
+    {
+        return this->runningWorkers;
+    }
+
+    unsigned long BlackThreadPool::getPendingTaskCount()
+    {
+        return this->pendingTasks;
+    }
+
+    unsigned long BlackThreadPool::getStolenTaskCount()
+    {
+        return this->stolenTasks;
+    }
+    // ############################################ BLACKTHREADPOOL DEFINITION ENDS ############################################ //
+
+
+} /* namespace BlackLib */
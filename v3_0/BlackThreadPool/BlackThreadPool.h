@@ -0,0 +1,471 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKTHREADPOOL_H_
+#define BLACKTHREADPOOL_H_
+
+#include "../BlackThread/BlackThread.h"
+#include "../BlackMutex/BlackMutex.h"
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <type_traits>
+#include <time.h>
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKTASKSTATE DECLARATION STARTS ########################################### //
+
+    /*! @brief Completion flag of a task which is run by BlackThreadPool.
+    *
+    *    This class is the shared part of BlackFuture objects. Users don't need to use it directly.
+    */
+    class BlackTaskState
+    {
+        public:
+            /*! @brief Constructor of BlackTaskState class.
+            */
+                                    BlackTaskState();
+
+            /*! @brief Destructor of BlackTaskState class.
+            */
+            virtual                 ~BlackTaskState();
+
+            /*! @brief Marks the task as finished and wakes up all waiters.
+            */
+            void                    setDone();
+
+            /*! @brief Checks the task is finished or not.
+            *
+            *  @return true if the task is finished else false.
+            */
+            bool                    isDone();
+
+            /*! @brief Waits until the task is finished.
+            */
+            void                    wait();
+
+            /*! @brief Waits until the task is finished or timeout occurs.
+            *
+            *  @param [in] msec     timeout in milliseconds
+            *  @return true if the task is finished else false.
+            */
+            bool                    waitFor(unsigned int msec);
+
+        private:
+            pthread_mutex_t         mutex;                      /*!< @brief is used to hold the state mutex */
+            pthread_cond_t          condition;                  /*!< @brief is used to hold the completion condition */
+            volatile bool           done;                       /*!< @brief is used to hold the task is finished or not */
+    };
+
+
+
+    /*! @brief Completion flag and return value of a task.
+    */
+    template <typename T>
+    class BlackTaskResult : public BlackTaskState
+    {
+        public:
+            T                       value;                      /*!< @brief is used to hold the return value of task */
+
+            /*! @brief Exports the return value of task.
+            */
+            T                       getValue()  { return this->value; }
+    };
+
+    /*! @brief Completion flag of a task which doesn't return value.
+    */
+    template <>
+    class BlackTaskResult<void> : public BlackTaskState
+    {
+        public:
+            /*! @brief Does nothing, exists for using same code with non-void tasks.
+            */
+            void                    getValue()  {}
+    };
+    // ############################################ BLACKTASKSTATE DECLARATION ENDS ############################################ //
+
+
+
+
+    // ############################################# BLACKFUTURE DECLARATION STARTS ############################################ //
+
+    /*! @brief Handle of a task which is submitted to BlackThreadPool.
+    *
+    *    This class is returned from BlackThreadPool::submit() function. It is used for waiting the task
+    *    and reading its return value. Copies of the object refer to the same task.
+    *
+    * @sa BlackThreadPool::submit()
+    */
+    template <typename T>
+    class BlackFuture
+    {
+        public:
+            /*! @brief Constructs an invalid future.
+            */
+                                    BlackFuture() {}
+
+            /*! @brief Constructs a future of given task state.
+            */
+            explicit                BlackFuture(const std::shared_ptr< BlackTaskResult<T> > &taskState) : state(taskState) {}
+
+            /*! @brief Checks the future refers to a task or not.
+            *
+            *  Submitting to a shut down pool returns an invalid future.
+            *  @return true if the future refers to a task else false.
+            */
+            bool                    isValid()                   { return static_cast<bool>(this->state); }
+
+            /*! @brief Checks the task is finished or not.
+            *
+            *  @return true if the task is finished else false.
+            */
+            bool                    isReady()                   { return ( this->isValid() and this->state->isDone() ); }
+
+            /*! @brief Waits until the task is finished.
+            */
+            void                    wait()                      { if( this->isValid() ) { this->state->wait(); } }
+
+            /*! @brief Waits until the task is finished or timeout occurs.
+            *
+            *  @param [in] msec     timeout in milliseconds
+            *  @return true if the task is finished else false.
+            */
+            bool                    waitFor(unsigned int msec)  { return ( this->isValid() and this->state->waitFor(msec) ); }
+
+            /*! @brief Waits until the task is finished and exports its return value.
+            *
+            *  Future must be valid.
+            *  @return Return value of task.
+            */
+            T                       get()                       { this->state->wait(); return this->state->getValue(); }
+
+        private:
+            friend class BlackThreadPool;
+
+            std::shared_ptr< BlackTaskResult<T> > state;        /*!< @brief is used to hold the shared task state */
+    };
+    // ############################################## BLACKFUTURE DECLARATION ENDS ############################################# //
+
+
+
+
+    // ########################################### BLACKTHREADPOOL DECLARATION STARTS ########################################## //
+
+    /*! @brief Runs short tasks on a fixed set of BlackThread workers.
+    *
+    *    This class creates its worker threads once and runs submitted tasks on them, so users don't need
+    *    to create and join a thread for every small job. Every worker has its own task deque. Tasks are
+    *    distributed to the deques in round-robin order, a worker takes tasks from the back of its own deque
+    *    and when it is empty, it steals from the front of the other workers' deques. So busy workers don't
+    *    leave the idle ones without work.
+    *
+    *    Tasks can be any callable object which takes no argument. submit() returns a BlackFuture for
+    *    waiting the task and reading its return value, execute() only queues the task. parallelFor() and
+    *    parallelForRange() split an index range to chunks, run them on the workers and wait until all of
+    *    them finish. The waiting thread runs queued tasks too, while it waits.
+    *
+    *    Workers are created with the priority which is given to the constructor. shutdown() stops accepting
+    *    new tasks, waits the queued tasks to finish and joins the workers. The destructor calls it also.
+    *
+    * @par Example
+    * @code{.cpp}
+    *  // Filename: myThreadPoolProject.cpp
+    *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+    *
+    *  #include <iostream>
+    *  #include <vector>
+    *  #include "BlackLib/BlackThreadPool/BlackThreadPool.h"
+    *
+    *  std::vector<float> samples(4096);
+    *
+    *  void scale(size_t index)
+    *  {
+    *       samples[index] = samples[index] * 1.8f / 4095.0f;
+    *  }
+    *
+    *  int sum()
+    *  {
+    *       return 2 + 3;
+    *  }
+    *
+    *  int main()
+    *  {
+    *       BlackLib::BlackThreadPool pool(4, BlackLib::BlackThread::PriorityHIGH);
+    *
+    *       pool.parallelFor(0, samples.size(), &scale);
+    *
+    *       BlackLib::BlackFuture<int> result = pool.submit(&sum);
+    *       std::cout << "Sum: " << result.get() << std::endl;
+    *
+    *       pool.shutdown();
+    *       return 0;
+    *  }
+    * @endcode
+    * @code{.cpp}
+    *   // Possible Output:
+    *   // Sum: 5
+    * @endcode
+    */
+    class BlackThreadPool
+    {
+        private:
+            /*! @brief Task deque of a worker.
+            */
+            struct taskQueue
+            {
+                std::deque< std::function<void()> > tasks;      /*!< @brief is used to hold the queued tasks */
+                BlackMutex                          mutex;      /*!< @brief is used to protect the queued tasks */
+            };
+
+            /*! @brief Worker thread of the pool.
+            */
+            class worker : public BlackThread
+            {
+                public:
+                                    worker(BlackThreadPool *ownerPool, size_t queueIndex);
+
+                private:
+                    BlackThreadPool *pool;                      /*!< @brief is used to hold the owner pool */
+                    size_t          index;                      /*!< @brief is used to hold the worker's own queue index */
+
+                    void            onStartHandler();
+            };
+
+            /*! @brief Runs a callable object and stores its return value to a task state.
+            */
+            template <typename R, typename F>
+            struct taskRunner
+            {
+                std::shared_ptr< BlackTaskResult<R> > state;
+                F                                     function;
+
+                taskRunner(const std::shared_ptr< BlackTaskResult<R> > &s, const F &f) : state(s), function(f) {}
+                void operator()()   { this->state->value = this->function(); this->state->setDone(); }
+            };
+
+            /*! @brief Runs a callable object which doesn't return value and marks its task state.
+            */
+            template <typename F>
+            struct taskRunner<void, F>
+            {
+                std::shared_ptr< BlackTaskResult<void> > state;
+                F                                        function;
+
+                taskRunner(const std::shared_ptr< BlackTaskResult<void> > &s, const F &f) : state(s), function(f) {}
+                void operator()()   { this->function(); this->state->setDone(); }
+            };
+
+            /*! @brief Shared counter of the chunks of a parallelForRange() call.
+            */
+            struct rangeGroup
+            {
+                BlackTaskState      state;                      /*!< @brief is used to hold the completion of all chunks */
+                volatile size_t     remaining;                  /*!< @brief is used to hold the unfinished chunk count */
+            };
+
+            /*! @brief Calls an index function for every index of a chunk.
+            */
+            struct indexLoop
+            {
+                const std::function<void(size_t)>                  *body;
+
+                void operator()(size_t first, size_t last);
+            };
+
+            /*! @brief Runs a chunk of parallelForRange() call.
+            */
+            struct rangeTask
+            {
+                std::shared_ptr<rangeGroup>                         group;
+                const std::function<void(size_t, size_t)>          *body;
+                size_t                                              begin;
+                size_t                                              end;
+
+                void operator()();
+            };
+
+            std::vector<taskQueue*>     queues;                 /*!< @brief is used to hold the task deques of workers */
+            std::vector<worker*>        workers;                /*!< @brief is used to hold the worker threads */
+            pthread_mutex_t             idleMutex;              /*!< @brief is used to protect the sleeping of idle workers */
+            pthread_cond_t              idleCondition;          /*!< @brief is used to wake up idle workers */
+            volatile unsigned long      pendingTasks;           /*!< @brief is used to hold the queued but not started task count */
+            volatile unsigned long      stolenTasks;            /*!< @brief is used to hold the stolen task count */
+            volatile unsigned long      nextQueue;              /*!< @brief is used to hold the round-robin queue counter */
+            volatile bool               isStopping;             /*!< @brief is used to hold the shutdown request */
+            size_t                      runningWorkers;         /*!< @brief is used to hold the successfully started worker count */
+
+            /*! @brief Queues a task to one of the worker deques.
+            *
+            *  If the pool doesn't have any running worker, the task is run at the caller thread.
+            *  @return false if the pool is shut down else true.
+            */
+            bool                        pushTask(const std::function<void()> &task);
+
+            /*! @brief Takes a task from the back of given deque.
+            */
+            bool                        popTask(size_t index, std::function<void()> &task);
+
+            /*! @brief Takes a task from the front of one of the other deques.
+            */
+            bool                        stealTask(size_t thiefIndex, std::function<void()> &task);
+
+            /*! @brief Runs one queued task at the caller thread.
+            *
+            *  @return true if a task is run else false.
+            */
+            bool                        runPendingTask();
+
+            /*! @brief Waits a task state while running queued tasks at the caller thread.
+            */
+            void                        helpUntilDone(BlackTaskState &state);
+
+            /*! @brief Main loop of workers.
+            */
+            void                        workerLoop(size_t index);
+
+        public:
+            /*! @brief Constructor of BlackThreadPool class.
+            *
+            *  This function creates and starts the worker threads.
+            *
+            *  @param [in] workerCount  worker thread count, zero means online cpu count
+            *  @param [in] tp           priority of worker threads
+            */
+                                        BlackThreadPool(unsigned int workerCount = 0,
+                                                        BlackThread::priority tp = BlackThread::PriorityDEFAULT);
+
+            /*! @brief Destructor of BlackThreadPool class.
+            *
+            *  This function calls shutdown().
+            */
+            virtual                     ~BlackThreadPool();
+
+            /*! @brief Queues a task and returns its future.
+            *
+            *  @param [in] task         callable object which takes no argument
+            *  @return Future of the task. It is invalid if the pool is shut down.
+            */
+            template <typename F>
+            BlackFuture<typename std::result_of<F()>::type> submit(F task)
+            {
+                typedef typename std::result_of<F()>::type resultType;
+
+                std::shared_ptr< BlackTaskResult<resultType> > state(new BlackTaskResult<resultType>());
+
+                if( ! this->pushTask(taskRunner<resultType, F>(state, task)) )
+                {
+                    return BlackFuture<resultType>();
+                }
+
+                return BlackFuture<resultType>(state);
+            }
+
+            /*! @brief Queues a task without future.
+            *
+            *  @param [in] task         task function
+            *  @return false if the pool is shut down else true.
+            */
+            bool                        execute(const std::function<void()> &task);
+
+            /*! @brief Waits a future while running queued tasks at the caller thread.
+            *
+            *  This function should be used instead of BlackFuture::wait() at tasks which wait other tasks,
+            *  because it keeps the worker busy instead of blocking it.
+            *
+            *  @param [in] future       submitted task's future
+            */
+            template <typename T>
+            void                        waitFor(BlackFuture<T> &future)
+            {
+                if( future.isValid() )
+                {
+                    this->helpUntilDone( *(future.state) );
+                }
+            }
+
+            /*! @brief Runs body function for every index in [begin, end) on the workers.
+            *
+            *  @param [in] begin        first index
+            *  @param [in] end          one past the last index
+            *  @param [in] body         function which is called with an index
+            *  @param [in] grainSize    minimum index count of a chunk, zero means automatic
+            */
+            void                        parallelFor(size_t begin, size_t end,
+                                                    const std::function<void(size_t)> &body,
+                                                    size_t grainSize = 0);
+
+            /*! @brief Runs body function for sub-ranges of [begin, end) on the workers.
+            *
+            *  The range is split to chunks and body function is called once for every chunk with
+            *  chunk's [begin, end) indexes. This function returns after all chunks are finished.
+            *
+            *  @param [in] begin        first index
+            *  @param [in] end          one past the last index
+            *  @param [in] body         function which is called with a chunk's begin and end indexes
+            *  @param [in] grainSize    minimum index count of a chunk, zero means automatic
+            */
+            void                        parallelForRange(size_t begin, size_t end,
+                                                         const std::function<void(size_t, size_t)> &body,
+                                                         size_t grainSize = 0);
+
+            /*! @brief Stops the pool gracefully.
+            *
+            *  New tasks are rejected, already queued tasks are run and all workers are joined.
+            */
+            void                        shutdown();
+
+            /*! @brief Checks the pool is shut down or not.
+            */
+            bool                        isShutdown();
+
+            /*! @brief Exports the running worker count.
+            */
+            size_t                      getWorkerCount();
+
+            /*! @brief Exports the queued but not started task count.
+            */
+            unsigned long               getPendingTaskCount();
+
+            /*! @brief Exports the count of tasks which are stolen from other workers' deques.
+            */
+            unsigned long               getStolenTaskCount();
+    };
+    // ############################################ BLACKTHREADPOOL DECLARATION ENDS ########################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKTHREADPOOL_H_ */
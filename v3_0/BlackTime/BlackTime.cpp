@@ -16,6 +16,8 @@ namespace BlackLib
         this->minute = 0;
         this->second = 0;
 
+        this->measureStartTime.tv_sec  = 0;
+        this->measureStartTime.tv_nsec = 0;
     }
 
     BlackTime::BlackTime(int h,int m,int s)
@@ -89,7 +91,7 @@ namespace BlackLib
 
     void BlackTime::start()
     {
-        ::gettimeofday(&(this->measureStartTime),NULL);
+        ::clock_gettime(CLOCK_MONOTONIC_RAW, &(this->measureStartTime));
     }
 
     BlackTimeElapsed BlackTime::restart()
@@ -101,25 +103,28 @@ namespace BlackLib
 
     BlackTimeElapsed BlackTime::elapsed()
     {
-        timeval now;
-        ::gettimeofday(&now,NULL);
+        timespec now;
+        ::clock_gettime(CLOCK_MONOTONIC_RAW, &now);
 
         BlackTimeElapsed temp;
 
-        unsigned long int microDiff = (now.tv_sec*1000000 + now.tv_usec) - (this->measureStartTime.tv_sec*1000000 + this->measureStartTime.tv_usec);
-        temp.microSecond            = microDiff%1000;
+        long long int nanoDiff           = static_cast<long long int>(now.tv_sec - this->measureStartTime.tv_sec) * 1000000000
+                                         + (now.tv_nsec - this->measureStartTime.tv_nsec);
 
-        unsigned long int miliDiff  = (microDiff - temp.microSecond) / 1000;
-        temp.miliSecond             = miliDiff%1000;
+        unsigned long long int microDiff = static_cast<unsigned long long int>(nanoDiff) / 1000;
+        temp.microSecond                 = microDiff%1000;
 
-        unsigned long int secDiff   = ((miliDiff - temp.miliSecond) / 1000);
-        temp.second                 = secDiff%60;
+        unsigned long long int miliDiff  = (microDiff - temp.microSecond) / 1000;
+        temp.miliSecond                  = miliDiff%1000;
 
-        unsigned long int minDiff   = (secDiff - temp.second)/60;
-        temp.minute                 = minDiff%60;
+        unsigned long long int secDiff   = ((miliDiff - temp.miliSecond) / 1000);
+        temp.second                      = secDiff%60;
 
-        unsigned long int hour      = (minDiff - temp.minute)/60;
-        temp.hour                   = static_cast<unsigned int>(hour);
+        unsigned long long int minDiff   = (secDiff - temp.second)/60;
+        temp.minute                      = minDiff%60;
+
+        unsigned long long int hour      = (minDiff - temp.minute)/60;
+        temp.hour                        = static_cast<unsigned int>(hour);
 
         return temp;
     }
@@ -187,104 +192,11 @@ namespace BlackLib
 
     std::string BlackTime::toString(std::string format)
     {
-        std::string retVal  = "";
-        int editedHour      = this->hour;
-
-        if( format.find("ap")!= std::string::npos or format.find("AP")!= std::string::npos )
-        {
-            if( editedHour == 0 )       { editedHour = 12; }
-            else if( editedHour > 12 )  { editedHour = editedHour%12; }
-        }
-
-        size_t i = 0 ;
-        while( i<format.size() )
-        {
-            if( format[i] == '\'' )
-            {
-                size_t endQuoteSignPos = format.find_first_of('\'',i+1);
-                if( endQuoteSignPos == std::string::npos )
-                {
-                    retVal = retVal + format.substr(i+1,format.size()-i);
-                    return retVal;
-                }
-                else
-                {
-                    retVal = retVal + format.substr(i+1,endQuoteSignPos-i-1);
-                    i = endQuoteSignPos+1;
-                }
-            }
-            else
-            if( format[i] == 'h' or format[i] == 'H' )
-            {
-                std::string ho = std::to_string(editedHour);
-                if( format[i+1] == 'h' or format[i+1] == 'H' )
-                {
-                    retVal = retVal + ( ho.size()==1 ? "0"+ho : ho );
-                    i +=2 ;
-                }
-                else
-                {
-                    retVal = retVal + ho;
-                    i++;
-                }
-            }
-            else
-            if( format[i] == 'm' or format[i] == 'M' )
-            {
-                std::string mi = std::to_string(this->minute);
-                if( format[i+1] == 'm' or format[i+1] == 'M' )
-                {
-                    retVal = retVal + ( mi.size()==1 ? "0"+mi : mi );
-                    i +=2 ;
-                }
-                else
-                {
-                    retVal = retVal + mi;
-                    i++;
-                }
-            }
-            else
-            if( format[i] == 's' or format[i] == 'S' )
-            {
-                std::string se = std::to_string(this->second);
-                if( format[i+1] == 's' or format[i+1] == 'S' )
-                {
-                    retVal = retVal + ( se.size()==1 ? "0"+se : se );
-                    i +=2 ;
-                }
-                else
-                {
-                    retVal = retVal + se;
-                    i++;
-                }
-            }
-            else
-            if( format[i] == ':' or format[i] == '/' or format[i] == '.' or format[i] == '-' or format[i] == ' ')
-            {
-                retVal = retVal + format[i];
-                i++;
-            }
-            else
-            if( format[i] == 'a' or format[i] == 'A')
-            {
-                if( format[i+1] == 'p' or format[i+1] == 'P' )
-                {
-                    retVal = retVal + ( this->hour >= 12 ? "pm" : "am" );
-                    i +=2 ;
-                }
-                else
-                {
-                    i++;
-                }
-            }
-            else
-            {
-                i++;
-            }
-
-        }
+        BlackTimeFormat formatter(format, BlackTimeFormat::SourceRealtime, false);
+        std::vector<char> buffer(formatter.getMaxLength() + 1);
 
-        return retVal;
+        size_t length = formatter.format(&buffer[0], buffer.size(), *this);
+        return std::string(&buffer[0], length);
     }
 
 
@@ -356,4 +268,254 @@ namespace BlackLib
 
 
 
+    BlackTimeFormat::BlackTimeFormat(const std::string &pattern, BlackTimeFormat::timeSource src)
+    {
+        this->pattern             = pattern;
+        this->source              = src;
+        this->isTwelveHour        = false;
+        this->hasSubSecondFields  = true;
+        this->maxLength           = 0;
+        this->cachedSecond        = static_cast<time_t>(-1);
+
+        this->compile();
+    }
+
+    BlackTimeFormat::BlackTimeFormat(const std::string &pattern, BlackTimeFormat::timeSource src, bool subSecondFields)
+    {
+        this->pattern             = pattern;
+        this->source              = src;
+        this->isTwelveHour        = false;
+        this->hasSubSecondFields  = subSecondFields;
+        this->maxLength           = 0;
+        this->cachedSecond        = static_cast<time_t>(-1);
+
+        this->compile();
+    }
+
+    size_t BlackTimeFormat::format(char *buffer, size_t size)
+    {
+        timespec now;
+        ::clock_gettime( (this->source == SourceMonotonic) ? CLOCK_MONOTONIC : CLOCK_REALTIME, &now);
+
+        return this->format(buffer, size, now);
+    }
+
+    size_t BlackTimeFormat::format(char *buffer, size_t size, const timespec &ts)
+    {
+        unsigned int h, m, s;
+
+        if( this->source == SourceMonotonic )
+        {
+            h = static_cast<unsigned int>(ts.tv_sec / 3600);
+            m = static_cast<unsigned int>((ts.tv_sec / 60) % 60);
+            s = static_cast<unsigned int>(ts.tv_sec % 60);
+        }
+        else
+        {
+            if( ts.tv_sec != this->cachedSecond )
+            {
+                ::localtime_r(&ts.tv_sec, &(this->cachedLocalTime));
+                this->cachedSecond        = ts.tv_sec;
+            }
+
+            h = static_cast<unsigned int>(this->cachedLocalTime.tm_hour);
+            m = static_cast<unsigned int>(this->cachedLocalTime.tm_min);
+            s = static_cast<unsigned int>(this->cachedLocalTime.tm_sec);
+        }
+
+        return this->render(buffer, size, h, m, s, static_cast<unsigned int>(ts.tv_nsec / 1000));
+    }
+
+    size_t BlackTimeFormat::format(char *buffer, size_t size, BlackTime &t)
+    {
+        return this->render(buffer, size, static_cast<unsigned int>(t.getHour()),
+                                          static_cast<unsigned int>(t.getMinute()),
+                                          static_cast<unsigned int>(t.getSecond()), 0);
+    }
+
+    size_t BlackTimeFormat::getMaxLength() const
+    {
+        return this->maxLength;
+    }
+
+    std::string BlackTimeFormat::getPattern() const
+    {
+        return this->pattern;
+    }
+
+    BlackTimeFormat::timeSource BlackTimeFormat::getSource() const
+    {
+        return this->source;
+    }
+
+    void BlackTimeFormat::addField(tokenType type, unsigned int width)
+    {
+        token field;
+        field.type      = type;
+        field.width     = width;
+        field.offset    = 0;
+        field.length    = 0;
+
+        this->tokens.push_back(field);
+
+        // monotonic hours aren't wrapped, 32 bit value fits to 10 digits
+        this->maxLength += (type == TokenAmPm) ? 2 : ( (width > 10) ? width : 10 );
+    }
+
+    void BlackTimeFormat::compile()
+    {
+        const std::string &f = this->pattern;
+        size_t i = 0;
+
+        while( i < f.size() )
+        {
+            char c      = f[i];
+            char next   = (i + 1 < f.size()) ? f[i+1] : '\0';
+
+            if( c == '\'' )
+            {
+                size_t endQuoteSignPos = f.find_first_of('\'', i+1);
+                size_t textEnd         = (endQuoteSignPos == std::string::npos) ? f.size() : endQuoteSignPos;
+
+                token text;
+                text.type       = TokenLiteral;
+                text.width      = 0;
+                text.offset     = this->literals.size();
+                text.length     = textEnd - i - 1;
+
+                this->literals.append(f, i+1, text.length);
+                this->tokens.push_back(text);
+                this->maxLength += text.length;
+
+                i = (endQuoteSignPos == std::string::npos) ? f.size() : endQuoteSignPos + 1;
+            }
+            else
+            if( c == 'h' or c == 'H' or c == 'm' or c == 'M' or c == 's' or c == 'S' )
+            {
+                tokenType type  = (c == 'h' or c == 'H') ? TokenHour : ( (c == 'm' or c == 'M') ? TokenMinute : TokenSecond );
+                bool isPadded   = ( std::tolower(next) == std::tolower(c) );
+
+                this->addField(type, isPadded ? 2 : 0);
+                i += isPadded ? 2 : 1;
+            }
+            else
+            if( (c == 'z' or c == 'Z') and this->hasSubSecondFields )
+            {
+                bool isPadded = ( f.compare(i, 3, "zzz") == 0 or f.compare(i, 3, "ZZZ") == 0 );
+
+                this->addField(TokenMiliSecond, isPadded ? 3 : 0);
+                i += isPadded ? 3 : 1;
+            }
+            else
+            if( (c == 'u' or c == 'U') and this->hasSubSecondFields )
+            {
+                bool isPadded = ( f.compare(i, 6, "uuuuuu") == 0 or f.compare(i, 6, "UUUUUU") == 0 );
+
+                this->addField(TokenMicroSecond, isPadded ? 6 : 0);
+                i += isPadded ? 6 : 1;
+            }
+            else
+            if( c == ':' or c == '/' or c == '.' or c == '-' or c == ' ' )
+            {
+                token separator;
+                separator.type      = TokenLiteral;
+                separator.width     = 0;
+                separator.offset    = this->literals.size();
+                separator.length    = 1;
+
+                this->literals.push_back(c);
+                this->tokens.push_back(separator);
+                this->maxLength++;
+                i++;
+            }
+            else
+            if( (c == 'a' or c == 'A') and (next == 'p' or next == 'P') )
+            {
+                this->addField(TokenAmPm, 0);
+                this->isTwelveHour        = true;
+                i += 2;
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    size_t BlackTimeFormat::render(char *buffer, size_t size, unsigned int h, unsigned int m, unsigned int s, unsigned int us)
+    {
+        if( size == 0 )
+        {
+            return 0;
+        }
+
+        unsigned int editedHour = h;
+        if( this->isTwelveHour )
+        {
+            if( editedHour == 0 )       { editedHour = 12; }
+            else if( editedHour > 12 )  { editedHour = editedHour%12; }
+        }
+
+        size_t limit    = size - 1;
+        size_t length   = 0;
+
+        for( size_t t = 0 ; t < this->tokens.size() and length < limit ; t++ )
+        {
+            const token &current = this->tokens[t];
+
+            if( current.type == TokenLiteral )
+            {
+                size_t count = (current.length < limit - length) ? current.length : limit - length;
+                this->literals.copy(buffer + length, count, current.offset);
+                length += count;
+                continue;
+            }
+
+            if( current.type == TokenAmPm )
+            {
+                const char *text = (h >= 12) ? "pm" : "am";
+                for( size_t k = 0 ; k < 2 and length < limit ; k++ )
+                {
+                    buffer[length++] = text[k];
+                }
+                continue;
+            }
+
+            unsigned int value;
+            switch( current.type )
+            {
+                case TokenHour:         { value = editedHour;   break; }
+                case TokenMinute:       { value = m;            break; }
+                case TokenSecond:       { value = s;            break; }
+                case TokenMiliSecond:   { value = us / 1000;    break; }
+                default:                { value = us;           break; }
+            }
+
+            // digits are produced backwards to a small scratch area
+            char   digits[10];
+            size_t digitCount = 0;
+            do
+            {
+                digits[digitCount++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while( value > 0 and digitCount < sizeof(digits) );
+
+            while( digitCount < current.width and digitCount < sizeof(digits) )
+            {
+                digits[digitCount++] = '0';
+            }
+
+            while( digitCount > 0 and length < limit )
+            {
+                buffer[length++] = digits[--digitCount];
+            }
+        }
+
+        buffer[length] = '\0';
+        return length;
+    }
+
+
+
+
 } /* namespace BlackLib */
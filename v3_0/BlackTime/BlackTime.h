@@ -34,7 +34,9 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
 #include <cmath>
+#include <cctype>
 #include <sys/time.h>
 
 
@@ -297,6 +299,9 @@ namespace BlackLib
 
             /*! @brief Starts the time measurement.
             *
+            * Measurement uses CLOCK_MONOTONIC_RAW, so it isn't affected by NTP or wall-clock changes.
+            * BlackStopwatch should be preferred for high resolution measurements.
+            *
             * @par Example
             *  @code{.cpp}
             *   BlackLib::BlackTime  myTime();
@@ -457,6 +462,9 @@ namespace BlackLib
             *    seperator                    | allowed seperators are ':', '/', '.', '-' and ' '
             *    'ap' or 'AP'                 | prints "am" or "pm"
             *
+            * Milisecond and microsecond fields of BlackTimeFormat aren't parsed here, because BlackTime
+            * doesn't hold sub-second values; 'z' and 'u' are skipped like other unknown characters.
+            * BlackTimeFormat should be preferred when the same format is used repeatedly.
             *
             * @return formatted time string.
             *
@@ -749,7 +757,7 @@ namespace BlackLib
             int hour;                    /*!< @brief is used to hold the hour value */
             int minute;                  /*!< @brief is used to hold the minute value */
             int second;                  /*!< @brief is used to hold the second value */
-            timeval measureStartTime;    /*!< @brief is used to hold the start point for measuring elapsed time */
+            timespec measureStartTime;   /*!< @brief is used to hold the start point for measuring elapsed time */
     };
 
 
@@ -757,6 +765,169 @@ namespace BlackLib
 
 
 
+    // ######################################## BLACKTIMEFORMAT DECLARATION STARTS ######################################### //
+
+    /*! @brief Formats time values to a caller buffer with a precompiled pattern.
+    *
+    *    The pattern is parsed once at construction, so formatting doesn't parse, allocate or use
+    *    streams. It is intended for timestamping log lines at high rate. The pattern uses the syntax
+    *    of BlackTime::toString() and adds these fields:
+    *
+    *    Expression                   | Output
+    *    ---------------------------- | -------------
+    *    single 'z' or 'Z'            | milisecond without zero
+    *    'zzz' or 'ZZZ'               | milisecond with zeros (3 digits)
+    *    single 'u' or 'U'            | microsecond of second without zero
+    *    'uuuuuu' or 'UUUUUU'         | microsecond of second with zeros (6 digits)
+    *
+    *    Realtime source prints local wall-clock time, monotonic source prints time since boot
+    *    (hours aren't wrapped at 24). Broken down local time is cached per second, so localtime_r()
+    *    is called at most once in a second.
+    *
+    *    Objects aren't thread safe because of this cache, every thread should use its own object.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   BlackLib::BlackTimeFormat stamp("hh:mm:ss.zzz");
+    *   char line[32];
+    *
+    *   stamp.format(line, sizeof(line));
+    *   std::cout << line << " sensor read" << std::endl;
+    *
+    *   BlackLib::BlackTimeFormat uptime("'up 'h:mm:ss.uuuuuu", BlackLib::BlackTimeFormat::SourceMonotonic);
+    *   uptime.format(line, sizeof(line));
+    *   std::cout << line << std::endl;
+    * @endcode
+    * @code{.cpp}
+    *   // Possible Output:
+    *   // 16:41:34.052 sensor read
+    *   // up 3:12:09.118204
+    * @endcode
+    */
+    class BlackTimeFormat
+    {
+        friend class BlackTime;
+
+        public:
+
+            /*!
+            * This enum is used to define the clock which is used by the current time formatting.
+            */
+            enum timeSource
+            {
+                SourceRealtime      = 0,        /*!< enumeration for @a CLOCK_REALTIME in local time */
+                SourceMonotonic     = 1         /*!< enumeration for @a CLOCK_MONOTONIC since boot */
+            };
+
+            /*! @brief Constructor of BlackTimeFormat class.
+            *
+            * @param [in] pattern   format pattern, same syntax as BlackTime::toString() plus sub-second fields
+            * @param [in] src       clock of the current time formatting
+            */
+            BlackTimeFormat(const std::string &pattern, BlackTimeFormat::timeSource src = BlackTimeFormat::SourceRealtime);
+
+            /*! @brief Formats the current time of selected source.
+            *
+            * Output is always null terminated if @a size isn't zero and it is truncated if buffer is short.
+            *
+            * @param [out] buffer   destination buffer
+            * @param [in]  size     size of the buffer in bytes
+            *
+            * @return Count of written characters, without null terminator.
+            */
+            size_t                  format(char *buffer, size_t size);
+
+            /*! @brief Formats a timestamp which is taken from the selected source before.
+            *
+            * @param [out] buffer   destination buffer
+            * @param [in]  size     size of the buffer in bytes
+            * @param [in]  ts       timestamp of the selected source
+            *
+            * @return Count of written characters, without null terminator.
+            */
+            size_t                  format(char *buffer, size_t size, const timespec &ts);
+
+            /*! @brief Formats hour, minute and second of a BlackTime object.
+            *
+            * Sub-second fields are printed as zero.
+            *
+            * @return Count of written characters, without null terminator.
+            */
+            size_t                  format(char *buffer, size_t size, BlackTime &t);
+
+            /*! @brief Exports the longest possible output length, without null terminator.
+            */
+            size_t                  getMaxLength() const;
+
+            /*! @brief Exports the pattern.
+            */
+            std::string             getPattern() const;
+
+            /*! @brief Exports the time source.
+            */
+            BlackTimeFormat::timeSource getSource() const;
+
+        private:
+
+            /*! @brief Constructor of BlackTimeFormat class, which is used by BlackTime::toString().
+            *
+            * @param [in] pattern           format pattern
+            * @param [in] src               clock of the current time formatting
+            * @param [in] subSecondFields   'z' and 'u' are parsed as fields or skipped like unknown characters
+            */
+            BlackTimeFormat(const std::string &pattern, BlackTimeFormat::timeSource src, bool subSecondFields);
+
+            /*!
+            * This enum is used to define the pattern tokens.
+            */
+            enum tokenType
+            {
+                TokenLiteral        = 0,
+                TokenHour           = 1,
+                TokenMinute         = 2,
+                TokenSecond         = 3,
+                TokenMiliSecond     = 4,
+                TokenMicroSecond    = 5,
+                TokenAmPm           = 6
+            };
+
+            /*! @brief Holds one compiled pattern element.
+            */
+            struct token
+            {
+                tokenType           type;           /*!< @brief is used to hold the token type */
+                unsigned int        width;          /*!< @brief is used to hold the zero padded width, 0 for no padding */
+                size_t              offset;         /*!< @brief is used to hold the literal start in literals string */
+                size_t              length;         /*!< @brief is used to hold the literal length */
+            };
+
+            /*! @brief Parses the pattern to the tokens.
+            */
+            void                    compile();
+
+            /*! @brief Writes the tokens with given field values.
+            */
+            size_t                  render(char *buffer, size_t size, unsigned int h, unsigned int m, unsigned int s, unsigned int us);
+
+            /*! @brief Adds a field token.
+            */
+            void                    addField(tokenType type, unsigned int width);
+
+            std::string             pattern;            /*!< @brief is used to hold the pattern */
+            std::string             literals;           /*!< @brief is used to hold the plain text parts of the pattern */
+            std::vector<token>      tokens;             /*!< @brief is used to hold the compiled pattern */
+            timeSource              source;             /*!< @brief is used to hold the time source */
+            bool                    isTwelveHour;       /*!< @brief is used to hold the 12-hour clock state */
+            bool                    hasSubSecondFields; /*!< @brief is used to hold the 'z' and 'u' fields are parsed or not */
+            size_t                  maxLength;          /*!< @brief is used to hold the longest output length */
+            time_t                  cachedSecond;       /*!< @brief is used to hold the second of cached local time */
+            struct tm               cachedLocalTime;    /*!< @brief is used to hold the cached local time */
+    };
+
+    // ######################################### BLACKTIMEFORMAT DECLARATION ENDS ########################################## //
+
+
+
 } /* namespace BlackLib */
 
 #endif /* BLACKTIME_H_ */
@@ -0,0 +1,524 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackTimerWheel.h"
+
+
+
+
+
+namespace BlackLib
+{
+
+    // ########################################### BLACKTIMERWHEEL DEFINITION STARTS ########################################## //
+    BlackTimerWheel::dispatcher::dispatcher(BlackTimerWheel *ownerWheel)
+    {
+        this->wheel = ownerWheel;
+    }
+
+    void BlackTimerWheel::dispatcher::onStartHandler()
+    {
+        while( this->checkPoint() )
+        {
+            this->wheel->dispatch(100);
+        }
+    }
+
+
+
+    BlackTimerWheel::BlackTimerWheel(uint64_t resolution, timeType tType, size_t initialCapacity)
+    {
+        this->resolutionNs      = toNanoseconds(resolution, tType);
+        if( this->resolutionNs == 0 or this->resolutionNs == UINT64_MAX )
+        {
+            this->resolutionNs  = 1000000;
+        }
+
+        this->freeList          = -1;
+        this->currentTick       = 0;
+        this->baseTimeNs        = monotonicTime();
+        this->armedTick         = 0;
+        this->activeTimers      = 0;
+        this->isArmed           = false;
+        this->dispatchThread    = NULL;
+        this->timerFd           = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+        this->slots.assign(levelCount * slotCount, -1);
+        this->timers.reserve(initialCapacity);
+        this->firing.reserve(64);
+    }
+
+    BlackTimerWheel::~BlackTimerWheel()
+    {
+        this->stop();
+
+        if( this->timerFd >= 0 )
+        {
+            ::close(this->timerFd);
+        }
+    }
+
+    BlackTimerId BlackTimerWheel::addOneShot(uint64_t delay, timeType tType, const std::function<void()> &callback)
+    {
+        return this->addTimer(toNanoseconds(delay, tType), 0, callback);
+    }
+
+    BlackTimerId BlackTimerWheel::addPeriodic(uint64_t period, timeType tType, const std::function<void()> &callback)
+    {
+        uint64_t periodNs = toNanoseconds(period, tType);
+        return this->addTimer(periodNs, periodNs, callback);
+    }
+
+    BlackTimerId BlackTimerWheel::addTimer(uint64_t delayNs, uint64_t periodNs, const std::function<void()> &callback)
+    {
+        if( this->timerFd < 0 )
+        {
+            return 0;
+        }
+
+        BlackLockGuard<BlackMutex> guard(this->wheelMutex);
+
+        int32_t index;
+        if( this->freeList >= 0 )
+        {
+            index           = this->freeList;
+            this->freeList  = this->timers[index].next;
+        }
+        else
+        {
+            timerEntry newEntry;
+            newEntry.generation = 0;
+            newEntry.isActive   = false;
+
+            this->timers.push_back(newEntry);
+            index = static_cast<int32_t>(this->timers.size() - 1);
+        }
+
+        timerEntry &entry   = this->timers[index];
+
+        // zero generation would make a zero handle
+        entry.generation    = (entry.generation + 1 == 0) ? 1 : entry.generation + 1;
+        entry.callback      = callback;
+        entry.delayTicks    = this->toTicks(delayNs);
+        entry.periodTicks   = (periodNs > 0) ? this->toTicks(periodNs) : 0;
+        entry.slot          = -1;
+        entry.isActive      = true;
+        entry.expireTick    = this->startTick() + entry.delayTicks;
+
+        uint64_t eventTick  = this->link(index);
+        this->activeTimers++;
+
+        if( not this->isArmed or eventTick < this->armedTick )
+        {
+            this->armAt(eventTick);
+        }
+
+        return ( static_cast<BlackTimerId>(entry.generation) << 32 ) | static_cast<uint32_t>(index);
+    }
+
+    bool BlackTimerWheel::cancel(BlackTimerId id)
+    {
+        BlackLockGuard<BlackMutex> guard(this->wheelMutex);
+
+        int32_t index = this->findTimer(id);
+        if( index < 0 )
+        {
+            return false;
+        }
+
+        this->unlink(index);
+        this->release(index);
+        return true;
+    }
+
+    bool BlackTimerWheel::restart(BlackTimerId id)
+    {
+        BlackLockGuard<BlackMutex> guard(this->wheelMutex);
+
+        int32_t index = this->findTimer(id);
+        if( index < 0 )
+        {
+            return false;
+        }
+
+        this->unlink(index);
+        this->timers[index].expireTick = this->startTick() + this->timers[index].delayTicks;
+
+        uint64_t eventTick = this->link(index);
+        if( not this->isArmed or eventTick < this->armedTick )
+        {
+            this->armAt(eventTick);
+        }
+
+        return true;
+    }
+
+    bool BlackTimerWheel::isActive(BlackTimerId id)
+    {
+        BlackLockGuard<BlackMutex> guard(this->wheelMutex);
+        return ( this->findTimer(id) >= 0 );
+    }
+
+    size_t BlackTimerWheel::getActiveCount()
+    {
+        BlackLockGuard<BlackMutex> guard(this->wheelMutex);
+        return this->activeTimers;
+    }
+
+    int BlackTimerWheel::getFileDescriptor()
+    {
+        return this->timerFd;
+    }
+
+    unsigned int BlackTimerWheel::dispatch(int timeoutMs)
+    {
+        if( this->timerFd < 0 )
+        {
+            return 0;
+        }
+
+        pollfd descriptor;
+        descriptor.fd       = this->timerFd;
+        descriptor.events   = POLLIN;
+        descriptor.revents  = 0;
+
+        if( ::poll(&descriptor, 1, timeoutMs) <= 0 )
+        {
+            return 0;
+        }
+
+        // it fails with EAGAIN when timerfd is re-armed after poll(), the new setting expires later
+        uint64_t expirations = 0;
+        if( ::read(this->timerFd, &expirations, sizeof(expirations)) != sizeof(expirations) )
+        {
+            return 0;
+        }
+
+        this->wheelMutex.lock();
+
+        // timerfd is one-shot, the ticks which are passed since the previous wakeup are counted from the clock
+        uint64_t nowTick = (monotonicTime() - this->baseTimeNs) / this->resolutionNs;
+        while( this->currentTick < nowTick )
+        {
+            this->advance();
+        }
+
+        uint64_t eventTick = this->nextEventTick();
+        if( this->activeTimers == 0 or eventTick == UINT64_MAX )
+        {
+            this->disarm();
+        }
+        else
+        {
+            this->armAt(eventTick);
+        }
+
+        this->wheelMutex.unlock();
+
+
+        // callbacks run without the lock, they can use the wheel
+        unsigned int callbackCount = static_cast<unsigned int>(this->firing.size());
+        for( size_t i = 0 ; i < this->firing.size() ; i++ )
+        {
+            this->firing[i]();
+        }
+        this->firing.clear();
+
+        return callbackCount;
+    }
+
+    bool BlackTimerWheel::start(BlackThread::priority tp)
+    {
+        if( this->dispatchThread != NULL and this->dispatchThread->isRunning() )
+        {
+            return true;
+        }
+
+        this->stop();
+
+        this->dispatchThread = new dispatcher(this);
+        this->dispatchThread->setPriority(tp);
+        this->dispatchThread->setName("BlackTimerWheel");
+        this->dispatchThread->run();
+
+        return this->dispatchThread->isRunning();
+    }
+
+    void BlackTimerWheel::stop()
+    {
+        if( this->dispatchThread != NULL )
+        {
+            this->dispatchThread->requestStop();
+            WAIT_THREAD_FINISH(this->dispatchThread)
+
+            delete this->dispatchThread;
+            this->dispatchThread = NULL;
+        }
+    }
+
+    int32_t BlackTimerWheel::findTimer(BlackTimerId id)
+    {
+        uint32_t index      = static_cast<uint32_t>(id & 0xFFFFFFFF);
+        uint32_t generation = static_cast<uint32_t>(id >> 32);
+
+        if( index >= this->timers.size() or not this->timers[index].isActive or this->timers[index].generation != generation )
+        {
+            return -1;
+        }
+
+        return static_cast<int32_t>(index);
+    }
+
+    uint64_t BlackTimerWheel::toTicks(uint64_t ns)
+    {
+        uint64_t ticks = (ns / this->resolutionNs) + ( (ns % this->resolutionNs) ? 1 : 0 );
+        return (ticks > 0) ? ticks : 1;
+    }
+
+    uint64_t BlackTimerWheel::startTick()
+    {
+        uint64_t now = monotonicTime();
+
+        if( not this->isArmed )
+        {
+            this->baseTimeNs = now - this->currentTick * this->resolutionNs;
+            return this->currentTick;
+        }
+
+        // a running wheel is somewhere in the current tick, one more tick keeps the delay as minimum
+        uint64_t nowTick = (now - this->baseTimeNs) / this->resolutionNs;
+        return ( (nowTick > this->currentTick) ? nowTick : this->currentTick ) + 1;
+    }
+
+    uint64_t BlackTimerWheel::link(int32_t index)
+    {
+        timerEntry &entry   = this->timers[index];
+        uint64_t   expire   = (entry.expireTick < this->currentTick) ? this->currentTick : entry.expireTick;
+        uint64_t   delta    = expire - this->currentTick;
+        uint64_t   maxDelta = (1ULL << (slotBits * levelCount)) - 1;
+
+        if( delta > maxDelta )
+        {
+            // placed at the top level's farthest slot, it is re-placed when that slot cascades
+            expire = this->currentTick + maxDelta;
+            delta  = maxDelta;
+        }
+
+        unsigned int level = 0;
+        while( level < levelCount - 1 and delta >= (1ULL << (slotBits * (level + 1))) )
+        {
+            level++;
+        }
+
+        int32_t head    = static_cast<int32_t>( level * slotCount + ((expire >> (slotBits * level)) & (slotCount - 1)) );
+
+        entry.slot      = head;
+        entry.previous  = -1;
+        entry.next      = this->slots[head];
+
+        if( entry.next >= 0 )
+        {
+            this->timers[entry.next].previous = index;
+        }
+
+        this->slots[head] = index;
+
+        return (expire >> (slotBits * level)) << (slotBits * level);
+    }
+
+    void BlackTimerWheel::unlink(int32_t index)
+    {
+        timerEntry &entry = this->timers[index];
+
+        if( entry.slot < 0 )
+        {
+            return;
+        }
+
+        if( entry.previous >= 0 )   { this->timers[entry.previous].next = entry.next; }
+        else                        { this->slots[entry.slot]           = entry.next; }
+
+        if( entry.next >= 0 )       { this->timers[entry.next].previous = entry.previous; }
+
+        entry.slot      = -1;
+        entry.previous  = -1;
+        entry.next      = -1;
+    }
+
+    void BlackTimerWheel::release(int32_t index)
+    {
+        timerEntry &entry   = this->timers[index];
+
+        entry.isActive      = false;
+        entry.callback      = std::function<void()>();
+        entry.next          = this->freeList;
+        this->freeList      = index;
+
+        this->activeTimers--;
+    }
+
+    void BlackTimerWheel::cascade(unsigned int level)
+    {
+        int32_t head    = static_cast<int32_t>( level * slotCount + ((this->currentTick >> (slotBits * level)) & (slotCount - 1)) );
+        int32_t index   = this->slots[head];
+
+        this->slots[head] = -1;
+
+        while( index >= 0 )
+        {
+            int32_t next = this->timers[index].next;
+
+            this->timers[index].slot = -1;
+            this->link(index);
+
+            index = next;
+        }
+    }
+
+    void BlackTimerWheel::advance()
+    {
+        this->currentTick++;
+
+        // lower level is cascaded first, higher level timers then fall to the right place directly
+        for( unsigned int level = 1 ; level < levelCount ; level++ )
+        {
+            if( ( this->currentTick & ((1ULL << (slotBits * level)) - 1) ) != 0 )
+            {
+                break;
+            }
+
+            this->cascade(level);
+        }
+
+        int32_t head    = static_cast<int32_t>( this->currentTick & (slotCount - 1) );
+        int32_t index   = this->slots[head];
+
+        this->slots[head] = -1;
+
+        while( index >= 0 )
+        {
+            timerEntry &entry   = this->timers[index];
+            int32_t    next     = entry.next;
+
+            entry.slot          = -1;
+            this->firing.push_back(entry.callback);
+
+            if( entry.periodTicks > 0 )
+            {
+                entry.expireTick += entry.periodTicks;
+
+                // skip the periods which are missed while dispatch() wasn't called
+                if( entry.expireTick <= this->currentTick )
+                {
+                    uint64_t missed   = (this->currentTick - entry.expireTick) / entry.periodTicks + 1;
+                    entry.expireTick += missed * entry.periodTicks;
+                }
+
+                this->link(index);
+            }
+            else
+            {
+                this->release(index);
+            }
+
+            index = next;
+        }
+    }
+
+    uint64_t BlackTimerWheel::nextEventTick()
+    {
+        uint64_t eventTick = UINT64_MAX;
+
+        // a level's slots are checked until the nearest occupied one, a higher level can only be nearer by a cascade
+        for( unsigned int level = 0 ; level < levelCount ; level++ )
+        {
+            unsigned int shift = slotBits * level;
+
+            for( uint64_t step = 1 ; step <= slotCount ; step++ )
+            {
+                uint64_t tick = ((this->currentTick >> shift) + step) << shift;
+                if( tick >= eventTick )
+                {
+                    break;
+                }
+
+                if( this->slots[level * slotCount + ((tick >> shift) & (slotCount - 1))] >= 0 )
+                {
+                    eventTick = tick;
+                    break;
+                }
+            }
+        }
+
+        return eventTick;
+    }
+
+    void BlackTimerWheel::armAt(uint64_t tick)
+    {
+        uint64_t   expireNs = this->baseTimeNs + tick * this->resolutionNs;
+
+        itimerspec setting;
+        setting.it_value.tv_sec     = static_cast<time_t>(expireNs / 1000000000);
+        setting.it_value.tv_nsec    = static_cast<long>(expireNs % 1000000000);
+        setting.it_interval.tv_sec  = 0;
+        setting.it_interval.tv_nsec = 0;
+
+        if( timerfd_settime(this->timerFd, TFD_TIMER_ABSTIME, &setting, NULL) == 0 )
+        {
+            this->isArmed   = true;
+            this->armedTick = tick;
+        }
+    }
+
+    void BlackTimerWheel::disarm()
+    {
+        itimerspec setting;
+        setting.it_value.tv_sec     = 0;
+        setting.it_value.tv_nsec    = 0;
+        setting.it_interval         = setting.it_value;
+
+        if( timerfd_settime(this->timerFd, 0, &setting, NULL) == 0 )
+        {
+            this->isArmed = false;
+        }
+    }
+
+    uint64_t BlackTimerWheel::monotonicTime()
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + now.tv_nsec;
+    }
+    // ############################################ BLACKTIMERWHEEL DEFINITION ENDS ########################################### //
+
+
+} /* namespace BlackLib */
@@ -0,0 +1,312 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKTIMERWHEEL_H_
+#define BLACKTIMERWHEEL_H_
+
+#include "../BlackDef.h"
+#include "../BlackThread/BlackThread.h"
+#include "../BlackMutex/BlackMutex.h"
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+
+
+namespace BlackLib
+{
+    typedef uint64_t BlackTimerId;      //!< Handle of a timer at BlackTimerWheel, zero is the invalid handle.
+
+
+
+    // ########################################### BLACKTIMERWHEEL DECLARATION STARTS ######################################### //
+
+    /*! @brief Schedules many one-shot and periodic timers with one timerfd.
+    *
+    *    Timers are kept in a hierarchical timing wheel. It has four levels with 64 slots each; a level
+    *    covers 64 times the range of the previous one, so with 1 ms resolution the timers up to about
+    *    4.6 hours are placed directly and the longer ones are re-placed when the top level turns. Adding,
+    *    cancelling and restarting a timer are constant time operations, and timers are stored in a
+    *    pool, so they don't allocate after the pool reaches its working size.
+    *
+    *    The wheel is driven by one one-shot @b timerfd. It is armed for the nearest occupied slot or
+    *    cascade point, and every wakeup processes all ticks which are elapsed since the previous one, so
+    *    the process doesn't wake up at every tick while the timers are far away. It is disarmed when
+    *    there isn't any active timer. Callbacks run on the thread which calls dispatch().
+    *    The file descriptor can be added to users' own poll/epoll loop with getFileDescriptor(), or
+    *    start() can be used to run an internal dispatcher thread with the given priority.
+    *
+    *    All functions are thread safe. Callbacks run without holding the wheel lock, so they can add,
+    *    cancel or restart timers.
+    *
+    * @par Example
+    * @code{.cpp}
+    *  // Filename: myTimerProject.cpp
+    *  // Author:   Yiğit Yüce - ygtyce@gmail.com
+    *
+    *  #include <iostream>
+    *  #include "BlackLib/BlackTimerWheel/BlackTimerWheel.h"
+    *
+    *  void onResponseTimeout()
+    *  {
+    *       std::cout << "Slave didn't respond." << std::endl;
+    *  }
+    *
+    *  void onPoll()
+    *  {
+    *       std::cout << "Polling slaves." << std::endl;
+    *  }
+    *
+    *  int main()
+    *  {
+    *       BlackLib::BlackTimerWheel wheel;
+    *
+    *       BlackLib::BlackTimerId timeout = wheel.addOneShot(50, BlackLib::milisecond, &onResponseTimeout);
+    *       wheel.addPeriodic(1, BlackLib::second, &onPoll);
+    *
+    *       // response is received, push the deadline forward
+    *       wheel.restart(timeout);
+    *
+    *       while( true )
+    *       {
+    *           wheel.dispatch();
+    *       }
+    *  }
+    * @endcode
+    */
+    class BlackTimerWheel
+    {
+        private:
+            static const unsigned int   levelCount  = 4;    /*!< @brief is used to hold the wheel level count */
+            static const unsigned int   slotBits    = 6;    /*!< @brief is used to hold the bit count of slot index */
+            static const unsigned int   slotCount   = 64;   /*!< @brief is used to hold the slot count of a level */
+
+            /*! @brief Timer record at the pool.
+            */
+            struct timerEntry
+            {
+                std::function<void()>   callback;           /*!< @brief is used to hold the timer function */
+                uint64_t                expireTick;         /*!< @brief is used to hold the expiration tick */
+                uint64_t                periodTicks;        /*!< @brief is used to hold the period, zero for one-shot timers */
+                uint64_t                delayTicks;         /*!< @brief is used to hold the first delay, it is used by restart() */
+                uint32_t                generation;         /*!< @brief is used to hold the reuse count of the record */
+                int32_t                 previous;           /*!< @brief is used to hold the previous record at the slot list */
+                int32_t                 next;               /*!< @brief is used to hold the next record at the slot list, or the next free record */
+                int32_t                 slot;               /*!< @brief is used to hold the slot list head index, -1 if not linked */
+                bool                    isActive;           /*!< @brief is used to hold the record is in use or not */
+            };
+
+            /*! @brief Internal dispatcher thread.
+            */
+            class dispatcher : public BlackThread
+            {
+                public:
+                                        dispatcher(BlackTimerWheel *ownerWheel);
+
+                private:
+                    BlackTimerWheel     *wheel;             /*!< @brief is used to hold the owner wheel */
+
+                    void                onStartHandler();
+            };
+
+            std::vector<timerEntry>     timers;             /*!< @brief is used to hold the timer pool */
+            std::vector<int32_t>        slots;              /*!< @brief is used to hold the list heads of all slots, level by level */
+            std::vector< std::function<void()> > firing;    /*!< @brief is used to hold the expired callbacks of current dispatch */
+            int32_t                     freeList;           /*!< @brief is used to hold the first free record */
+            uint64_t                    currentTick;        /*!< @brief is used to hold the processed tick count */
+            uint64_t                    resolutionNs;       /*!< @brief is used to hold the tick length in nanoseconds */
+            uint64_t                    baseTimeNs;         /*!< @brief is used to hold the CLOCK_MONOTONIC time of tick zero */
+            uint64_t                    armedTick;          /*!< @brief is used to hold the tick which timerfd is armed for */
+            size_t                      activeTimers;       /*!< @brief is used to hold the active timer count */
+            bool                        isArmed;            /*!< @brief is used to hold the timerfd is armed or not */
+            int                         timerFd;            /*!< @brief is used to hold the timerfd */
+            BlackMutex                  wheelMutex;         /*!< @brief is used to protect the wheel */
+            dispatcher                  *dispatchThread;    /*!< @brief is used to hold the internal dispatcher thread */
+
+            /*! @brief Takes a record from the pool and places it to the wheel.
+            */
+            BlackTimerId                addTimer(uint64_t delayNs, uint64_t periodNs, const std::function<void()> &callback);
+
+            /*! @brief Converts a handle to the record index.
+            *
+            *  @return Record index, -1 if the handle is not active.
+            */
+            int32_t                     findTimer(BlackTimerId id);
+
+            /*! @brief Converts nanoseconds to ticks, rounds up and returns at least one tick.
+            */
+            uint64_t                    toTicks(uint64_t ns);
+
+            /*! @brief Calculates the tick which a new delay starts from.
+            *
+            *  The time base of an idle wheel is moved to now, because the wheel doesn't count ticks while
+            *  timerfd is disarmed.
+            */
+            uint64_t                    startTick();
+
+            /*! @brief Adds a record to the slot which is selected by its expiration tick.
+            *
+            *  @return Tick which the record expires at, or is cascaded at if it is placed at a higher level.
+            */
+            uint64_t                    link(int32_t index);
+
+            /*! @brief Removes a record from its slot.
+            */
+            void                        unlink(int32_t index);
+
+            /*! @brief Returns a record to the pool.
+            */
+            void                        release(int32_t index);
+
+            /*! @brief Moves the records of current slot at given level to the lower levels.
+            */
+            void                        cascade(unsigned int level);
+
+            /*! @brief Processes one tick and collects the expired callbacks.
+            */
+            void                        advance();
+
+            /*! @brief Finds the nearest tick which has an occupied slot or an occupied cascade point.
+            *
+            *  @return Tick number, UINT64_MAX if the wheel is empty.
+            */
+            uint64_t                    nextEventTick();
+
+            /*! @brief Arms timerfd once for the start of given tick.
+            */
+            void                        armAt(uint64_t tick);
+
+            /*! @brief Stops timerfd.
+            */
+            void                        disarm();
+
+            /*! @brief Exports CLOCK_MONOTONIC time in nanoseconds.
+            */
+            static uint64_t             monotonicTime();
+
+            BlackTimerWheel(const BlackTimerWheel&);
+            BlackTimerWheel& operator=(const BlackTimerWheel&);
+
+        public:
+            /*! @brief Constructor of BlackTimerWheel class.
+            *
+            *  @param [in] resolution       tick length
+            *  @param [in] tType            time type of tick length
+            *  @param [in] initialCapacity  timer count which is allocated at construction
+            */
+                                        BlackTimerWheel(uint64_t resolution = 1, timeType tType = milisecond,
+                                                        size_t initialCapacity = 256);
+
+            /*! @brief Destructor of BlackTimerWheel class.
+            *
+            *  This function stops the internal dispatcher thread and closes the timerfd.
+            */
+            virtual                     ~BlackTimerWheel();
+
+            /*! @brief Adds a timer which runs once.
+            *
+            *  Delay is rounded up to the resolution.
+            *  @param [in] delay        time until expiration
+            *  @param [in] tType        time type of delay
+            *  @param [in] callback     timer function
+            *  @return Timer handle, zero if the timerfd couldn't be created.
+            */
+            BlackTimerId                addOneShot(uint64_t delay, timeType tType, const std::function<void()> &callback);
+
+            /*! @brief Adds a timer which runs repeatedly.
+            *
+            *  Next expirations are calculated from the previous expiration, so the period doesn't drift.
+            *  @param [in] period       time between expirations
+            *  @param [in] tType        time type of period
+            *  @param [in] callback     timer function
+            *  @return Timer handle, zero if the timerfd couldn't be created.
+            */
+            BlackTimerId                addPeriodic(uint64_t period, timeType tType, const std::function<void()> &callback);
+
+            /*! @brief Removes a timer.
+            *
+            *  @param [in] id           timer handle
+            *  @return true if the timer is active and removed, else false.
+            */
+            bool                        cancel(BlackTimerId id);
+
+            /*! @brief Starts the timer's first delay again from now.
+            *
+            *  It is useful for response timeouts which are pushed forward at every received message.
+            *  @param [in] id           timer handle
+            *  @return true if the timer is active, else false.
+            */
+            bool                        restart(BlackTimerId id);
+
+            /*! @brief Checks the timer is active or not.
+            *
+            *  One-shot timers become inactive after their callback is dispatched.
+            */
+            bool                        isActive(BlackTimerId id);
+
+            /*! @brief Exports the active timer count.
+            */
+            size_t                      getActiveCount();
+
+            /*! @brief Exports the timerfd for users' own poll/epoll loop.
+            *
+            *  When the descriptor is readable, dispatch(0) should be called.
+            */
+            int                         getFileDescriptor();
+
+            /*! @brief Waits for timerfd and runs the expired timers' callbacks at the caller thread.
+            *
+            *  @param [in] timeoutMs    wait time in milliseconds, negative means wait until timerfd expires
+            *  @return Run callback count.
+            */
+            unsigned int                dispatch(int timeoutMs = -1);
+
+            /*! @brief Runs an internal thread which calls dispatch().
+            *
+            *  @param [in] tp           priority of the dispatcher thread
+            *  @return true if the thread is running else false.
+            */
+            bool                        start(BlackThread::priority tp = BlackThread::PriorityDEFAULT);
+
+            /*! @brief Stops the internal dispatcher thread and waits until it finishes.
+            */
+            void                        stop();
+    };
+
+    // ############################################ BLACKTIMERWHEEL DECLARATION ENDS ########################################## //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKTIMERWHEEL_H_ */
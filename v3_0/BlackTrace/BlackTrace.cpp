@@ -0,0 +1,307 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#include "BlackTrace.h"
+
+
+
+namespace BlackLib
+{
+
+    // ############################################ BLACKTRACE DEFINITION STARTS ############################################ //
+
+    std::vector<BlackTrace::threadBuffer*>  BlackTrace::buffers;
+    BlackMutex                              BlackTrace::buffersMutex;
+    __thread BlackTrace::threadBuffer      *BlackTrace::currentBuffer  = NULL;
+    volatile bool                           BlackTrace::enabledFlag    = true;
+    size_t                                  BlackTrace::bufferSize     = 4096;
+
+
+    BlackTrace::threadBuffer *BlackTrace::getThreadBuffer()
+    {
+        if( currentBuffer == NULL )
+        {
+            threadBuffer *newBuffer = new threadBuffer();
+            newBuffer->threadId     = static_cast<uint32_t>( ::syscall(SYS_gettid) );
+            newBuffer->head         = 0;
+            newBuffer->tail         = 0;
+
+            BlackLockGuard<BlackMutex> guard(buffersMutex);
+
+            newBuffer->records.resize(bufferSize);
+            newBuffer->mask         = static_cast<uint32_t>(bufferSize - 1);
+
+            buffers.push_back(newBuffer);
+            currentBuffer = newBuffer;
+        }
+
+        return currentBuffer;
+    }
+
+    void        BlackTrace::copyRecords(threadBuffer *buffer, std::vector<BlackTraceEvent> &output)
+    {
+        uint32_t capacity   = buffer->mask + 1;
+        uint32_t head       = buffer->head;
+        __sync_synchronize();
+
+        uint32_t first      = buffer->tail;
+        if( head - first > capacity )
+        {
+            first = head - capacity;
+        }
+
+        size_t outputStart  = output.size();
+        BlackTraceEvent event;
+        event.threadId      = buffer->threadId;
+
+        for( uint32_t index = first ; index != head ; index++ )
+        {
+            event.record = buffer->records[index & buffer->mask];
+            output.push_back(event);
+        }
+
+        // records which are overwritten by the owner thread while copying are dropped, the slot of
+        // the next record is dropped too because the owner may be writing it now
+        __sync_synchronize();
+        uint32_t newHead    = buffer->head;
+        uint32_t overwritten = (newHead - first >= capacity) ? (newHead - capacity - first + 1) : 0;
+
+        if( overwritten > 0 )
+        {
+            size_t dropCount = std::min(static_cast<size_t>(overwritten), output.size() - outputStart);
+            output.erase(output.begin() + outputStart, output.begin() + outputStart + dropCount);
+        }
+    }
+
+    bool        BlackTrace::compareEvents(const BlackTraceEvent &first, const BlackTraceEvent &second)
+    {
+        return (first.record.startTime < second.record.startTime);
+    }
+
+    bool        BlackTrace::isEnabled()
+    {
+        #ifdef BLACKLIB_TRACE
+        return enabledFlag;
+        #else
+        return false;
+        #endif
+    }
+
+    void        BlackTrace::setEnabled(bool enable)
+    {
+        enabledFlag = enable;
+        __sync_synchronize();
+    }
+
+    void        BlackTrace::setBufferSize(size_t recordCount)
+    {
+        size_t roundedSize = 16;
+        while( roundedSize < recordCount and roundedSize < (1u << 30) )
+        {
+            roundedSize <<= 1;
+        }
+
+        BlackLockGuard<BlackMutex> guard(buffersMutex);
+        bufferSize = roundedSize;
+    }
+
+    void        BlackTrace::record(const BlackTraceRecord &traceRecord)
+    {
+        threadBuffer *buffer    = getThreadBuffer();
+        uint32_t head           = buffer->head;
+
+        buffer->records[head & buffer->mask] = traceRecord;
+        __sync_synchronize();
+        buffer->head            = head + 1;
+    }
+
+    size_t      BlackTrace::collect(std::vector<BlackTraceEvent> &output)
+    {
+        size_t firstSize = output.size();
+
+        {
+            BlackLockGuard<BlackMutex> guard(buffersMutex);
+
+            for( size_t i = 0 ; i < buffers.size() ; i++ )
+            {
+                copyRecords(buffers[i], output);
+            }
+        }
+
+        std::sort(output.begin() + firstSize, output.end(), compareEvents);
+        return output.size() - firstSize;
+    }
+
+    void        BlackTrace::clear()
+    {
+        BlackLockGuard<BlackMutex> guard(buffersMutex);
+
+        for( size_t i = 0 ; i < buffers.size() ; i++ )
+        {
+            buffers[i]->tail = buffers[i]->head;
+        }
+        __sync_synchronize();
+    }
+
+    bool        BlackTrace::exportChromeJson(const std::string &path)
+    {
+        std::vector<BlackTraceEvent> events;
+        collect(events);
+
+        FILE *traceFile = ::fopen(path.c_str(), "w");
+        if( traceFile == NULL )
+        {
+            return false;
+        }
+
+        unsigned processId = static_cast<unsigned>( ::getpid() );
+
+        ::fputs("{\"traceEvents\":[\n", traceFile);
+        for( size_t i = 0 ; i < events.size() ; i++ )
+        {
+            const BlackTraceRecord &traced = events[i].record;
+
+            ::fprintf(traceFile,
+                      "%s{\"name\":\"%s\",\"cat\":\"BlackLib\",\"ph\":\"X\",\"ts\":%llu.%03u,\"dur\":%u.%03u,"
+                      "\"pid\":%u,\"tid\":%u,\"args\":{\"target\":%u,\"bytes\":%u,\"result\":\"%s\"}}",
+                      (i == 0) ? "" : ",\n",
+                      toString( static_cast<traceOperation>(traced.operation) ),
+                      static_cast<unsigned long long>(traced.startTime / 1000), static_cast<unsigned>(traced.startTime % 1000),
+                      traced.duration / 1000, traced.duration % 1000,
+                      processId, events[i].threadId,
+                      traced.target, traced.bytes, traced.isFailed ? "failed" : "ok");
+        }
+        ::fputs("\n]}\n", traceFile);
+
+        bool isWritten = (::ferror(traceFile) == 0);
+        return (::fclose(traceFile) == 0) and isWritten;
+    }
+
+    bool        BlackTrace::exportBinary(const std::string &path)
+    {
+        std::vector<BlackTraceEvent> events;
+        collect(events);
+
+        FILE *traceFile = ::fopen(path.c_str(), "wb");
+        if( traceFile == NULL )
+        {
+            return false;
+        }
+
+        const uint32_t header[3] = { 0x52544C42, 1, static_cast<uint32_t>(events.size()) };   // "BLTR", version, count
+        ::fwrite(header, sizeof(header), 1, traceFile);
+
+        for( size_t i = 0 ; i < events.size() ; i++ )
+        {
+            ::fwrite(&events[i].threadId, sizeof(uint32_t), 1, traceFile);
+            ::fwrite(&events[i].record, sizeof(BlackTraceRecord), 1, traceFile);
+        }
+
+        bool isWritten = (::ferror(traceFile) == 0);
+        return (::fclose(traceFile) == 0) and isWritten;
+    }
+
+    const char *BlackTrace::toString(traceOperation operation)
+    {
+        switch( operation )
+        {
+            case TraceGpioRead:     { return "GpioRead";    }
+            case TraceGpioWrite:    { return "GpioWrite";   }
+            case TraceAdcRead:      { return "AdcRead";     }
+            case TracePwmRead:      { return "PwmRead";     }
+            case TracePwmWrite:     { return "PwmWrite";    }
+            case TraceSpiTransfer:  { return "SpiTransfer"; }
+            case TraceI2cRead:      { return "I2cRead";     }
+            case TraceI2cWrite:     { return "I2cWrite";    }
+            case TraceUartRead:     { return "UartRead";    }
+            case TraceUartWrite:    { return "UartWrite";   }
+        }
+
+        return "Unknown";
+    }
+
+    uint64_t    BlackTrace::getTime()
+    {
+        timespec now;
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+    }
+
+    // ############################################# BLACKTRACE DEFINITION ENDS ############################################# //
+
+
+
+
+
+
+
+
+
+
+    // ########################################## BLACKTRACESCOPE DEFINITION STARTS ######################################### //
+
+    BlackTraceScope::BlackTraceScope(traceOperation operation, uint32_t target, uint32_t bytes, const bool *flag)
+    {
+        this->isActive                  = BlackTrace::isEnabled();
+        this->failFlag                  = flag;
+
+        if( this->isActive )
+        {
+            this->traceRecord.operation = static_cast<uint16_t>(operation);
+            this->traceRecord.isFailed  = 0;
+            this->traceRecord.reserved  = 0;
+            this->traceRecord.target    = target;
+            this->traceRecord.bytes     = bytes;
+            this->traceRecord.duration  = 0;
+            this->traceRecord.startTime = BlackTrace::getTime();
+        }
+    }
+
+    BlackTraceScope::~BlackTraceScope()
+    {
+        if( this->isActive )
+        {
+            uint64_t duration           = BlackTrace::getTime() - this->traceRecord.startTime;
+            this->traceRecord.duration  = (duration > 0xFFFFFFFFULL) ? 0xFFFFFFFFu : static_cast<uint32_t>(duration);
+            this->traceRecord.isFailed  = (*this->failFlag) ? 1 : 0;
+
+            BlackTrace::record(this->traceRecord);
+        }
+    }
+
+    void        BlackTraceScope::setBytes(uint32_t bytes)
+    {
+        this->traceRecord.bytes = bytes;
+    }
+
+    // ########################################### BLACKTRACESCOPE DEFINITION ENDS ########################################## //
+
+} /* namespace BlackLib */
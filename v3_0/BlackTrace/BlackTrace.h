@@ -0,0 +1,288 @@
+ /*
+
+ ####################################################################################
+ #  BlackLib Library controls Beaglebone Black's inputs and outputs.                #
+ #  Copyright (C) 2013-2015 by Yigit YUCE                                           #
+ ####################################################################################
+ #                                                                                  #
+ #  This file is part of BlackLib library.                                          #
+ #                                                                                  #
+ #  BlackLib library is free software: you can redistribute it and/or modify        #
+ #  it under the terms of the GNU Lesser General Public License as published by     #
+ #  the Free Software Foundation, either version 3 of the License, or               #
+ #  (at your option) any later version.                                             #
+ #                                                                                  #
+ #  BlackLib library is distributed in the hope that it will be useful,             #
+ #  but WITHOUT ANY WARRANTY; without even the implied warranty of                  #
+ #  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the                   #
+ #  GNU Lesser General Public License for more details.                             #
+ #                                                                                  #
+ #  You should have received a copy of the GNU Lesser General Public License        #
+ #  along with this program.  If not, see <http://www.gnu.org/licenses/>.           #
+ #                                                                                  #
+ #  For any comment or suggestion please contact the creator of BlackLib Library    #
+ #  at ygtyce@gmail.com                                                             #
+ #                                                                                  #
+ ####################################################################################
+
+ */
+
+
+
+#ifndef BLACKTRACE_H_
+#define BLACKTRACE_H_
+
+#include "../BlackMutex/BlackMutex.h"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+
+
+
+/*! @brief Peripheral access tracing is compiled in only if this macro is defined.
+*
+*    Add @b -DBLACKLIB_TRACE to the compiler flags (TRACEFLAGS variable of the makefile) to enable it.
+*    If it is not defined, the trace macros expand to empty statements and their arguments aren't
+*    evaluated, so tracing doesn't cost anything.
+*/
+#ifdef BLACKLIB_TRACE
+    #define BLACKLIB_TRACE_SCOPE(operation, target, bytes, failFlag)    BlackLib::BlackTraceScope blackTraceScope((operation), (target), (bytes), &(failFlag))
+    #define BLACKLIB_TRACE_BYTES(bytes)                                 blackTraceScope.setBytes(bytes)
+#else
+    #define BLACKLIB_TRACE_SCOPE(operation, target, bytes, failFlag)    do {} while(0)
+    #define BLACKLIB_TRACE_BYTES(bytes)                                 do {} while(0)
+#endif
+
+
+
+namespace BlackLib
+{
+
+    /*!
+     * This enum is used to name the traced peripheral operations.
+     */
+    enum traceOperation     {   TraceGpioRead       = 0,    /*!< enumeration for @a gpio value reading */
+                                TraceGpioWrite      = 1,    /*!< enumeration for @a gpio value writing */
+                                TraceAdcRead        = 2,    /*!< enumeration for @a adc value reading */
+                                TracePwmRead        = 3,    /*!< enumeration for @a pwm file reading */
+                                TracePwmWrite       = 4,    /*!< enumeration for @a pwm file writing */
+                                TraceSpiTransfer    = 5,    /*!< enumeration for @a spi transfer */
+                                TraceI2cRead        = 6,    /*!< enumeration for @a i2c register reading */
+                                TraceI2cWrite       = 7,    /*!< enumeration for @a i2c register writing */
+                                TraceUartRead       = 8,    /*!< enumeration for @a uart reading */
+                                TraceUartWrite      = 9     /*!< enumeration for @a uart writing */
+                            };
+
+
+
+    // ######################################### BLACKTRACERECORD DECLARATION STARTS ######################################## //
+
+    /*! @brief Holds one traced peripheral call.
+    *
+    *    The layout is fixed (24 bytes), records are written to binary logs as is.
+    */
+    struct BlackTraceRecord
+    {
+        uint64_t        startTime;          /*!< @brief is used to hold the monotonic start time of the call in nanoseconds */
+        uint32_t        duration;           /*!< @brief is used to hold the duration of the call in nanoseconds */
+        uint16_t        operation;          /*!< @brief is used to hold the traceOperation of the call */
+        uint8_t         isFailed;           /*!< @brief is used to hold the call is failed(1) or not(0) */
+        uint8_t         reserved;           /*!< @brief is used to align the record, it is always zero */
+        uint32_t        target;             /*!< @brief is used to hold the peripheral number (gpio number, i2c address, ...) */
+        uint32_t        bytes;              /*!< @brief is used to hold the transferred byte count */
+    };
+
+    /*! @brief Holds one traced peripheral call with its thread.
+    */
+    struct BlackTraceEvent
+    {
+        uint32_t            threadId;       /*!< @brief is used to hold the kernel thread id of the caller */
+        BlackTraceRecord    record;         /*!< @brief is used to hold the traced call */
+    };
+
+    // ########################################## BLACKTRACERECORD DECLARATION ENDS ######################################### //
+
+
+
+
+
+    // ############################################ BLACKTRACE DECLARATION STARTS ########################################### //
+
+    /*! @brief Records peripheral calls of the library and exports them.
+    *
+    *    BlackGPIO, BlackADC, BlackPWM, BlackSPI, BlackI2C and BlackUART record their hot calls with
+    *    operation, target, byte count, result and duration, if the library is compiled with
+    *    @b BLACKLIB_TRACE macro. Each thread writes to its own ring buffer, so recording doesn't use
+    *    any lock or atomic read-modify-write operation. When a ring buffer is full, the oldest records
+    *    are overwritten, so the buffers always hold the last calls of each thread.
+    *
+    *    Records can be exported as Chrome trace event JSON (chrome://tracing, Perfetto) or as a compact
+    *    binary log. Binary log starts with "BLTR" magic, 32 bit version(1) and 32 bit record count; then
+    *    each record is written as 32 bit thread id and BlackTraceRecord. All values are little endian.
+    *
+    *    Buffers of finished threads are kept until process exit, so their records can be exported too.
+    *
+    * @par Example
+    * @code{.cpp}
+    *   // compiled with -DBLACKLIB_TRACE
+    *   BlackLib::BlackTrace::setBufferSize(8192);
+    *
+    *   BlackLib::BlackGPIO led(BlackLib::GPIO_60, BlackLib::output, BlackLib::FastMode);
+    *   for( int i = 0 ; i < 100 ; i++ )
+    *   {
+    *       led.toggleValue();
+    *   }
+    *
+    *   BlackLib::BlackTrace::exportChromeJson("/tmp/blacklib-trace.json");
+    * @endcode
+    */
+    class BlackTrace
+    {
+        private:
+
+            /*! @brief Holds the ring buffer of one thread.
+            */
+            struct threadBuffer
+            {
+                uint32_t                        threadId;   /*!< @brief is used to hold the kernel thread id of the owner */
+                uint32_t                        mask;       /*!< @brief is used to hold the capacity - 1, capacity is a power of two */
+                volatile uint32_t               head;       /*!< @brief is used to hold the written record count, only the owner changes it */
+                volatile uint32_t               tail;       /*!< @brief is used to hold the first record which isn't cleared */
+                std::vector<BlackTraceRecord>   records;    /*!< @brief is used to hold the records */
+            };
+
+            static std::vector<threadBuffer*>   buffers;        /*!< @brief is used to hold the ring buffers of all threads */
+            static BlackMutex                   buffersMutex;   /*!< @brief is used to protect buffer list at buffer creation and export */
+            static __thread threadBuffer       *currentBuffer;  /*!< @brief is used to hold the ring buffer of the calling thread */
+            static volatile bool                enabledFlag;    /*!< @brief is used to hold the runtime state of tracing */
+            static size_t                       bufferSize;     /*!< @brief is used to hold the capacity of new ring buffers */
+
+            /*! @brief Returns the ring buffer of the calling thread, creates it at first call.
+            */
+            static threadBuffer                *getThreadBuffer();
+
+            /*! @brief Copies the current records of a ring buffer without stopping its owner.
+            */
+            static void                         copyRecords(threadBuffer *buffer, std::vector<BlackTraceEvent> &output);
+
+            /*! @brief Compares start times of two events, it is used for sorting.
+            */
+            static bool                         compareEvents(const BlackTraceEvent &first, const BlackTraceEvent &second);
+
+
+        public:
+
+            /*! @brief Checks tracing is compiled in and enabled at runtime.
+            */
+            static bool                         isEnabled();
+
+            /*! @brief Enables or disables recording at runtime.
+            *
+            *  Tracing is enabled by default, if it is compiled in. Disabled tracing costs one flag check
+            *  per call.
+            */
+            static void                         setEnabled(bool enable);
+
+            /*! @brief Sets the record capacity of ring buffers which will be created.
+            *
+            *  The size is rounded up to a power of two. Buffers which are created before are not changed,
+            *  so it should be called before the peripherals are used. Default size is 4096 records.
+            *  A full buffer exports its last (size - 1) records, because the owner thread may be writing the oldest slot.
+            */
+            static void                         setBufferSize(size_t recordCount);
+
+            /*! @brief Records a finished call to the ring buffer of the calling thread.
+            */
+            static void                         record(const BlackTraceRecord &traceRecord);
+
+            /*! @brief Copies the records of all threads to @b output, sorted with start time.
+            *
+            *  @return Copied record count.
+            */
+            static size_t                       collect(std::vector<BlackTraceEvent> &output);
+
+            /*! @brief Marks the current records of all threads as cleared.
+            *
+            *  Records aren't erased, they are just not exported anymore.
+            */
+            static void                         clear();
+
+            /*! @brief Exports the records as Chrome trace event JSON file.
+            *
+            *  @return True if the file is written, else false.
+            */
+            static bool                         exportChromeJson(const std::string &path);
+
+            /*! @brief Exports the records as binary log.
+            *
+            *  @return True if the file is written, else false.
+            */
+            static bool                         exportBinary(const std::string &path);
+
+            /*! @brief Returns the name of a traced operation.
+            */
+            static const char                  *toString(traceOperation operation);
+
+            /*! @brief Returns monotonic clock in nanoseconds.
+            */
+            static uint64_t                     getTime();
+    };
+
+    // ############################################# BLACKTRACE DECLARATION ENDS ############################################ //
+
+
+
+
+
+    // ########################################## BLACKTRACESCOPE DECLARATION STARTS ######################################## //
+
+    /*! @brief Records the enclosing call when it goes out of scope.
+    *
+    *    This class isn't used directly, BLACKLIB_TRACE_SCOPE macro creates it at the beginning of the traced
+    *    function. The result of the call is taken from the fail flag of the peripheral when the scope ends,
+    *    so early returns don't need any extra code.
+    */
+    class BlackTraceScope
+    {
+        private:
+            BlackTraceRecord    traceRecord;        /*!< @brief is used to hold the record which will be written */
+            const bool         *failFlag;           /*!< @brief is used to hold the error flag of the traced call */
+            bool                isActive;           /*!< @brief is used to hold the tracing is enabled at scope start */
+
+            BlackTraceScope(const BlackTraceScope&);
+            BlackTraceScope& operator=(const BlackTraceScope&);
+
+        public:
+
+            /*! @brief Constructor of BlackTraceScope class.
+            *
+            *  @param [in] operation    traced operation
+            *  @param [in] target       peripheral number
+            *  @param [in] bytes        requested byte count
+            *  @param [in] flag         error flag which the traced call sets
+            */
+                                BlackTraceScope(traceOperation operation, uint32_t target, uint32_t bytes, const bool *flag);
+
+            /*! @brief Destructor of BlackTraceScope class.
+            *
+            *  This function calculates the duration and records the call.
+            */
+                                ~BlackTraceScope();
+
+            /*! @brief Changes the byte count with the transferred byte count.
+            */
+            void                setBytes(uint32_t bytes);
+    };
+
+    // ########################################### BLACKTRACESCOPE DECLARATION ENDS ######################################### //
+
+} /* namespace BlackLib */
+
+#endif /* BLACKTRACE_H_ */
@@ -35,51 +35,73 @@
 namespace BlackLib
 {
 
-    BlackUART::BlackUART(uartName uart, baudRate uartBaud, parity uartParity, stopBits uartStopBits, characterSize uartCharSize)
+    // names of the BlackUART::flags values, they are used as error labels of metrics
+    static const char *const uartFlagNames[BlackIoMetrics::flagCount] =
+    {
+        NULL, "dtErr", "openErr", "closeErr",
+        "directionErr", "flushErr", "readErr", "writeErr",
+        "baudRateErr", "parityErr", "stopBitsErr", "charSizeErr",
+        "statisticsErr"
+    };
+
+
+    BlackUART::BlackUART(uartName uart, baudRate uartBaud, parity uartParity, stopBits uartStopBits, characterSize uartCharSize) : uartErrors(this->getErrorsFromCore()), ioMetrics("uart", uartFlagNames)
     {
         this->dtUartFilename            = "BB-UART" + tostr(static_cast<int>(uart));
+        this->uartPortNumber            = static_cast<int>(uart);
         this->uartPortPath              = "/dev/ttyO" + tostr(static_cast<int>(uart));
 
         this->readBufferSize            = 1024;
         this->uartFD                    = -1;
         this->isOpenFlag                = false;
         this->isCurrentEqDefault        = false;
+        this->epollFD                   = -1;
+
 
-        this->uartErrors                = new errorUART( this->getErrorsFromCore() );
+        memset(&(this->rxCounterBase), 0, sizeof(this->rxCounterBase));
+        clock_gettime(CLOCK_MONOTONIC, &(this->rxStatisticsStart));
         this->constructorProperties     = BlackUartProperties(uartBaud, uartBaud, uartParity, uartStopBits, uartCharSize);
 
         this->loadDeviceTree();
     }
 
 
-    BlackUART::BlackUART(uartName uart, BlackUartProperties uartProperties)
+    BlackUART::BlackUART(uartName uart, BlackUartProperties uartProperties) : uartErrors(this->getErrorsFromCore()), ioMetrics("uart", uartFlagNames)
     {
         this->dtUartFilename            = "BB-UART" + tostr(static_cast<int>(uart));
+        this->uartPortNumber            = static_cast<int>(uart);
         this->uartPortPath              = "/dev/ttyO" + tostr(static_cast<int>(uart));
 
         this->readBufferSize            = 1024;
         this->uartFD                    = -1;
         this->isOpenFlag                = false;
         this->isCurrentEqDefault        = false;
+        this->epollFD                   = -1;
 
-        this->uartErrors                = new errorUART( this->getErrorsFromCore() );
+
+        memset(&(this->rxCounterBase), 0, sizeof(this->rxCounterBase));
+        clock_gettime(CLOCK_MONOTONIC, &(this->rxStatisticsStart));
         this->constructorProperties     = uartProperties;
 
         this->loadDeviceTree();
     }
 
 
-    BlackUART::BlackUART(uartName uart)
+    BlackUART::BlackUART(uartName uart) : uartErrors(this->getErrorsFromCore()), ioMetrics("uart", uartFlagNames)
     {
         this->dtUartFilename            = "BB-UART" + tostr(static_cast<int>(uart));
+        this->uartPortNumber            = static_cast<int>(uart);
         this->uartPortPath              = "/dev/ttyO" + tostr(static_cast<int>(uart));
 
         this->readBufferSize            = 1024;
         this->uartFD                    = -1;
         this->isOpenFlag                = false;
         this->isCurrentEqDefault        = true;
+        this->epollFD                   = -1;
+
 
-        this->uartErrors                = new errorUART( this->getErrorsFromCore() );
+        memset(&(this->rxCounterBase), 0, sizeof(this->rxCounterBase));
+        clock_gettime(CLOCK_MONOTONIC, &(this->rxStatisticsStart));
 
         this->loadDeviceTree();
     }
@@ -88,28 +110,20 @@ namespace BlackLib
     BlackUART::~BlackUART()
     {
         this->close();
-        delete this->uartErrors;
     }
 
 
 
     bool        BlackUART::loadDeviceTree()
     {
-        std::string file = this->getSlotsFilePath();
-
-        std::ofstream slotsFile;
-        slotsFile.open(file.c_str(),std::ios::out);
-        if(slotsFile.fail())
+        if( not this->loadOverlay(this->dtUartFilename) )
         {
-            this->uartErrors->dtError = true;
-            slotsFile.close();
+            this->uartErrors.dtError = true;
             return false;
         }
         else
         {
-            this->uartErrors->dtError = false;
-            slotsFile << this->dtUartFilename;
-            slotsFile.close();
+            this->uartErrors.dtError = false;
             return true;
         }
     }
@@ -131,17 +145,34 @@ namespace BlackLib
 
         if( this->uartFD < 0 )
         {
-            this->uartErrors->openError = true;
+            this->uartErrors.openError = true;
             this->isOpenFlag            = false;
             return false;
         }
 
 
 
-        this->uartErrors->openError     = false;
+        this->uartErrors.openError      = false;
         this->isOpenFlag                = true;
         this->defaultUartProperties     = this->getProperties();
 
+        this->epollFD = epoll_create(1);
+        if( this->epollFD >= 0 )
+        {
+            epoll_event event;
+            memset(&event, 0, sizeof(event));
+            event.events  = EPOLLIN;
+            event.data.fd = this->uartFD;
+
+            if( epoll_ctl(this->epollFD, EPOLL_CTL_ADD, this->uartFD, &event) < 0 )
+            {
+                ::close(this->epollFD);
+                this->epollFD = -1;
+            }
+        }
+
+        this->resetStatistics();
+
         if( this->isCurrentEqDefault )
         {
             this->currentUartProperties = this->defaultUartProperties;
@@ -163,14 +194,20 @@ namespace BlackLib
 
     bool        BlackUART::close()
     {
+        if( this->epollFD >= 0 )
+        {
+            ::close(this->epollFD);
+            this->epollFD = -1;
+        }
+
         if( ::close(this->uartFD) < 0 )
         {
-            this->uartErrors->closeError    = true;
+            this->uartErrors.closeError     = true;
             return false;
         }
         else
         {
-            this->uartErrors->closeError    = false;
+            this->uartErrors.closeError     = false;
             this->isOpenFlag                = false;
             return true;
         }
@@ -185,33 +222,33 @@ namespace BlackLib
 
         if( whichDirection == input )
         {
-            this->uartErrors->directionError = false;
+            this->uartErrors.directionError = false;
             isFlushed = tcflush(this->uartFD, TCIFLUSH);
         }
         else if( whichDirection == output )
         {
-            this->uartErrors->directionError = false;
+            this->uartErrors.directionError = false;
             isFlushed = tcflush(this->uartFD, TCOFLUSH);
         }
         else if( whichDirection == bothDirection )
         {
-            this->uartErrors->directionError = false;
+            this->uartErrors.directionError = false;
             isFlushed = tcflush(this->uartFD, TCIOFLUSH);
         }
         else
         {
-            this->uartErrors->directionError = true;
+            this->uartErrors.directionError = true;
         }
 
 
         if( isFlushed == 0 )
         {
-            this->uartErrors->flushError = false;
+            this->uartErrors.flushError = false;
             return true;
         }
         else
         {
-            this->uartErrors->flushError = true;
+            this->uartErrors.flushError = true;
             return false;
         }
     }
@@ -220,19 +257,41 @@ namespace BlackLib
 
     bool        BlackUART::read(char *readBuffer, size_t size)
     {
-        char tempReadBuffer[size];
-        memset(&tempReadBuffer, 0, size);
+        BlackResult<size_t> result = this->tryRead(readBuffer, size);
 
-        if(::read(this->uartFD, tempReadBuffer, sizeof(tempReadBuffer)) > 0)
+        if( not result )
         {
-            memcpy(readBuffer, tempReadBuffer, sizeof(tempReadBuffer));
-            this->uartErrors->readError = false;
-            return true;
+            return false;
+        }
+
+        memset(readBuffer + result.getValue(), 0, size - result.getValue());
+        return true;
+    }
+
+    BlackResult<size_t> BlackUART::tryRead(char *readBuffer, size_t size)
+    {
+        BLACKLIB_TRACE_SCOPE(TraceUartRead, static_cast<uint32_t>(this->uartPortNumber), size, this->uartErrors.readError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsRead, size, readErr, this->uartErrors.readError);
+
+        if( ! this->isOpenFlag )
+        {
+            this->uartErrors.readError = true;
+            return BlackResult<size_t>(BlackError::NotReady, 0);
+        }
+
+        ssize_t readSize = ::read(this->uartFD, readBuffer, size);
+        if( readSize > 0 )
+        {
+            this->uartErrors.readError = false;
+            this->updateRxStatistics(readSize);
+            BLACKLIB_TRACE_BYTES(readSize);
+            BLACKLIB_METRICS_BYTES(readSize);
+            return BlackResult<size_t>(static_cast<size_t>(readSize));
         }
         else
         {
-            this->uartErrors->readError = true;
-            return false;
+            this->uartErrors.readError = true;
+            return BlackResult<size_t>(BlackError::ReadFailed, (readSize < 0) ? errno : 0);
         }
     }
 
@@ -241,50 +300,138 @@ namespace BlackLib
         std::string tempReadBuffer;
         tempReadBuffer.resize(this->readBufferSize);
 
-        int readSize = ::read(this->uartFD, &tempReadBuffer[0], tempReadBuffer.size() );
-        if( readSize > 0)
+        BlackResult<size_t> result = this->tryRead(&tempReadBuffer[0], tempReadBuffer.size());
+        if( not result )
         {
-            this->uartErrors->readError = false;
-            tempReadBuffer.resize(readSize);
-            return tempReadBuffer;
+            return UART_READ_FAILED;
+        }
+
+        tempReadBuffer.resize(result.getValue());
+        return tempReadBuffer;
+    }
+
+    int         BlackUART::readTimestamped(char *readBuffer, size_t size, timespec &rxTimestamp, int timeout_ms)
+    {
+        if( this->epollFD < 0 )
+        {
+            this->uartErrors.readError = true;
+            return -1;
+        }
+
+        epoll_event event;
+        int eventCount;
+
+        do
+        {
+            eventCount = epoll_wait(this->epollFD, &event, 1, timeout_ms);
+        }
+        while( eventCount < 0 and errno == EINTR );
+
+        clock_gettime(CLOCK_MONOTONIC, &rxTimestamp);
+
+        if( eventCount == 0 )
+        {
+            return 0;
+        }
+
+        if( eventCount < 0 )
+        {
+            this->uartErrors.readError = true;
+            return -1;
+        }
+
+        int readSize = ::read(this->uartFD, readBuffer, size);
+        if( readSize > 0 )
+        {
+            this->uartErrors.readError = false;
+            this->updateRxStatistics(readSize);
+            return readSize;
+        }
+        else if( readSize < 0 and (errno == EAGAIN or errno == EWOULDBLOCK) )
+        {
+            return 0;
         }
         else
         {
-            this->uartErrors->readError = true;
-            return UART_READ_FAILED;
+            this->uartErrors.readError = true;
+            return -1;
         }
     }
 
+    void        BlackUART::updateRxStatistics(size_t readSize)
+    {
+        this->rxStatistics.rxBytes  += readSize;
+        this->rxStatistics.rxChunks += 1;
+    }
 
-
-    bool        BlackUART::write(char *writeBuffer, size_t size)
+    void        BlackUART::markConsumed(const timespec &rxTimestamp)
     {
-        if(::write(this->uartFD, writeBuffer, size) > 0)
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        int64_t latency = static_cast<int64_t>(now.tv_sec - rxTimestamp.tv_sec) * 1000000000LL
+                        + (now.tv_nsec - rxTimestamp.tv_nsec);
+        if( latency < 0 )
         {
-            this->uartErrors->writeError = false;
-            return true;
+            latency = 0;
         }
-        else
+
+        uint64_t latencyUs = static_cast<uint64_t>(latency) / 1000;
+        unsigned int bucket = 0;
+        while( latencyUs > 1 and bucket < BlackUartStatistics::latencyBucketCount - 1 )
         {
-            this->uartErrors->writeError = true;
-            return false;
+            latencyUs >>= 1;
+            bucket++;
+        }
+
+        this->rxStatistics.latencyHistogram[bucket] += 1;
+        this->rxStatistics.latencyTotalNanoseconds  += latency;
+        this->rxStatistics.latencySamples           += 1;
+
+        if( static_cast<uint64_t>(latency) > this->rxStatistics.latencyMaxNanoseconds )
+        {
+            this->rxStatistics.latencyMaxNanoseconds = latency;
         }
     }
 
-    bool        BlackUART::write(std::string writeBuffer)
+
+
+    bool        BlackUART::write(char *writeBuffer, size_t size)
     {
-        if(::write(this->uartFD, writeBuffer.c_str(), writeBuffer.size() ) > 0)
+        return this->tryWrite(writeBuffer, size).isOk();
+    }
+
+    BlackResult<size_t> BlackUART::tryWrite(const char *writeBuffer, size_t size)
+    {
+        BLACKLIB_TRACE_SCOPE(TraceUartWrite, static_cast<uint32_t>(this->uartPortNumber), size, this->uartErrors.writeError);
+        BLACKLIB_METRICS_SCOPE(this->ioMetrics, MetricsWrite, size, writeErr, this->uartErrors.writeError);
+
+        if( ! this->isOpenFlag )
         {
-            this->uartErrors->writeError = false;
-            return true;
+            this->uartErrors.writeError = true;
+            return BlackResult<size_t>(BlackError::NotReady, 0);
+        }
+
+        ssize_t writeSize = ::write(this->uartFD, writeBuffer, size);
+        if( writeSize > 0 )
+        {
+            this->uartErrors.writeError = false;
+            BLACKLIB_TRACE_BYTES(writeSize);
+            BLACKLIB_METRICS_BYTES(writeSize);
+            return BlackResult<size_t>(static_cast<size_t>(writeSize));
         }
         else
         {
-            this->uartErrors->writeError = true;
-            return false;
+            this->uartErrors.writeError = true;
+            return BlackResult<size_t>(BlackError::WriteFailed, (writeSize < 0) ? errno : 0);
         }
     }
 
+    bool        BlackUART::write(std::string writeBuffer)
+    {
+        return this->tryWrite(writeBuffer.c_str(), writeBuffer.size()).isOk();
+    }
+
 
 
 
@@ -292,11 +439,11 @@ namespace BlackLib
     {
         if(::write(this->uartFD, writeBuffer, size ) > 0)
         {
-            this->uartErrors->writeError = false;
+            this->uartErrors.writeError = false;
         }
         else
         {
-            this->uartErrors->writeError = true;
+            this->uartErrors.writeError = true;
             return false;
         }
 
@@ -306,15 +453,17 @@ namespace BlackLib
         char tempReadBuffer[ size ];
         memset(&tempReadBuffer, 0, size);
 
-        if(::read(this->uartFD, tempReadBuffer, sizeof(tempReadBuffer)) > 0)
+        int readSize = ::read(this->uartFD, tempReadBuffer, sizeof(tempReadBuffer));
+        if( readSize > 0 )
         {
             memcpy(readBuffer,tempReadBuffer,sizeof(tempReadBuffer));
-            this->uartErrors->readError = false;
+            this->uartErrors.readError = false;
+            this->updateRxStatistics(readSize);
             return true;
         }
         else
         {
-            this->uartErrors->readError = true;
+            this->uartErrors.readError = true;
             return false;
         }
     }
@@ -323,11 +472,11 @@ namespace BlackLib
     {
         if(::write(this->uartFD,writeBuffer.c_str(),writeBuffer.size() ) > 0)
         {
-            this->uartErrors->writeError = false;
+            this->uartErrors.writeError = false;
         }
         else
         {
-            this->uartErrors->writeError = true;
+            this->uartErrors.writeError = true;
             return UART_WRITE_FAILED;
         }
 
@@ -339,13 +488,14 @@ namespace BlackLib
         int readSize = ::read(this->uartFD, &tempReadBuffer[0], tempReadBuffer.size() );
         if( readSize > 0 )
         {
-            this->uartErrors->readError = false;
+            this->uartErrors.readError = false;
+            this->updateRxStatistics(readSize);
             tempReadBuffer.resize(readSize);
             return tempReadBuffer;
         }
         else
         {
-            this->uartErrors->readError = true;
+            this->uartErrors.readError = true;
             return UART_READ_FAILED;
         }
 
@@ -378,20 +528,20 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->baudRateError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.baudRateError  = true;
+            this->uartErrors.openError      = true;
             return Baud0;
         }
 
         termios tempProperties;
         if( tcgetattr(this->uartFD, &tempProperties) != 0 )
         {
-            this->uartErrors->baudRateError = true;
+            this->uartErrors.baudRateError = true;
             return Baud0;
         }
         else
         {
-            this->uartErrors->baudRateError = false;
+            this->uartErrors.baudRateError = false;
         }
 
 
@@ -417,8 +567,8 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->baudRateError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.baudRateError  = true;
+            this->uartErrors.openError      = true;
             return false;
         }
 
@@ -442,12 +592,12 @@ namespace BlackLib
         }
         else
         {
-            this->uartErrors->directionError    = true;
-            this->uartErrors->baudRateError     = true;
+            this->uartErrors.directionError     = true;
+            this->uartErrors.baudRateError      = true;
             return false;
         }
 
-        this->uartErrors->directionError        = false;
+        this->uartErrors.directionError         = false;
 
         if( tcsetattr(this->uartFD, applyMode, &tempProperties) == 0 )
         {
@@ -467,12 +617,12 @@ namespace BlackLib
                 this->currentUartProperties.uartBaudOut = newBaud;
             }
 
-            this->uartErrors->baudRateError = false;
+            this->uartErrors.baudRateError = false;
             return true;
         }
         else
         {
-            this->uartErrors->baudRateError = true;
+            this->uartErrors.baudRateError = true;
             return false;
         }
     }
@@ -483,20 +633,20 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->parityError   = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.parityError    = true;
+            this->uartErrors.openError      = true;
             return ParityDefault;
         }
 
         termios tempProperties;
         if( tcgetattr(this->uartFD, &tempProperties) != 0 )
         {
-            this->uartErrors->parityError = true;
+            this->uartErrors.parityError = true;
             return ParityDefault;
         }
         else
         {
-            this->uartErrors->parityError = false;
+            this->uartErrors.parityError = false;
         }
 
         tcflag_t controlFlag = tempProperties.c_cflag;
@@ -525,8 +675,8 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->parityError   = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.parityError    = true;
+            this->uartErrors.openError      = true;
             return false;
         }
 
@@ -555,13 +705,13 @@ namespace BlackLib
 
         if( tcsetattr(this->uartFD, applyMode, &tempProperties) == 0 )
         {
-            this->uartErrors->parityError = false;
+            this->uartErrors.parityError = false;
             this->currentUartProperties.uartParity = (newParity == ParityDefault) ? ParityNo : newParity;;
             return true;
         }
         else
         {
-            this->uartErrors->parityError = true;
+            this->uartErrors.parityError = true;
             return false;
         }
     }
@@ -572,20 +722,20 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->stopBitsError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.stopBitsError  = true;
+            this->uartErrors.openError      = true;
             return StopDefault;
         }
 
         termios tempProperties;
         if( tcgetattr(this->uartFD, &tempProperties) != 0 )
         {
-            this->uartErrors->stopBitsError = true;
+            this->uartErrors.stopBitsError = true;
             return StopDefault;
         }
         else
         {
-            this->uartErrors->stopBitsError = false;
+            this->uartErrors.stopBitsError = false;
         }
 
 
@@ -606,8 +756,8 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->stopBitsError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.stopBitsError  = true;
+            this->uartErrors.openError      = true;
             return false;
         }
 
@@ -626,13 +776,13 @@ namespace BlackLib
 
         if( tcsetattr(this->uartFD, applyMode, &tempProperties) == 0 )
         {
-            this->uartErrors->stopBitsError = false;
+            this->uartErrors.stopBitsError = false;
             this->currentUartProperties.uartStopBits = (newStopBits == StopDefault) ? StopOne : newStopBits;
             return true;
         }
         else
         {
-            this->uartErrors->stopBitsError = true;
+            this->uartErrors.stopBitsError = true;
             return false;
         }
     }
@@ -643,20 +793,20 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->charSizeError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.charSizeError  = true;
+            this->uartErrors.openError      = true;
             return CharDefault;
         }
 
         termios tempProperties;
         if( tcgetattr(this->uartFD, &tempProperties) != 0 )
         {
-            this->uartErrors->charSizeError = true;
+            this->uartErrors.charSizeError = true;
             return CharDefault;
         }
         else
         {
-            this->uartErrors->charSizeError = false;
+            this->uartErrors.charSizeError = false;
         }
 
         tcflag_t controlFlag = tempProperties.c_cflag;
@@ -671,8 +821,8 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->charSizeError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.charSizeError  = true;
+            this->uartErrors.openError      = true;
             return false;
         }
 
@@ -720,12 +870,12 @@ namespace BlackLib
         if( tcsetattr(this->uartFD, applyMode, &tempProperties) == 0 )
         {
             this->currentUartProperties.uartCharSize = (newCharacterSize == CharDefault) ? Char8 : newCharacterSize;
-            this->uartErrors->charSizeError = false;
+            this->uartErrors.charSizeError = false;
             return true;
         }
         else
         {
-            this->uartErrors->charSizeError = true;
+            this->uartErrors.charSizeError = true;
             return false;
         }
 
@@ -738,28 +888,28 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->baudRateError = true;
-            this->uartErrors->charSizeError = true;
-            this->uartErrors->parityError   = true;
-            this->uartErrors->stopBitsError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.baudRateError = true;
+            this->uartErrors.charSizeError  = true;
+            this->uartErrors.parityError    = true;
+            this->uartErrors.stopBitsError  = true;
+            this->uartErrors.openError      = true;
             return BlackUartProperties();
         }
 
         termios tempProperties;
         if( tcgetattr(this->uartFD, &tempProperties) != 0 )
         {
-            this->uartErrors->baudRateError = true;
-            this->uartErrors->charSizeError = true;
-            this->uartErrors->parityError   = true;
-            this->uartErrors->stopBitsError = true;
+            this->uartErrors.baudRateError = true;
+            this->uartErrors.charSizeError  = true;
+            this->uartErrors.parityError    = true;
+            this->uartErrors.stopBitsError  = true;
         }
         else
         {
-            this->uartErrors->baudRateError = false;
-            this->uartErrors->charSizeError = false;
-            this->uartErrors->parityError   = false;
-            this->uartErrors->stopBitsError = false;
+            this->uartErrors.baudRateError = false;
+            this->uartErrors.charSizeError  = false;
+            this->uartErrors.parityError    = false;
+            this->uartErrors.stopBitsError  = false;
         }
 
         tcflag_t controlFlag = tempProperties.c_cflag;
@@ -783,11 +933,11 @@ namespace BlackLib
     {
         if( !(this->isOpenFlag) )
         {
-            this->uartErrors->baudRateError = true;
-            this->uartErrors->charSizeError = true;
-            this->uartErrors->parityError   = true;
-            this->uartErrors->stopBitsError = true;
-            this->uartErrors->openError     = true;
+            this->uartErrors.baudRateError = true;
+            this->uartErrors.charSizeError  = true;
+            this->uartErrors.parityError    = true;
+            this->uartErrors.stopBitsError  = true;
+            this->uartErrors.openError      = true;
             return false;
         }
 
@@ -878,10 +1028,10 @@ namespace BlackLib
 
         if( tcsetattr(this->uartFD, applyMode, &tempProperties) == 0 )
         {
-            this->uartErrors->baudRateError = false;
-            this->uartErrors->charSizeError = false;
-            this->uartErrors->parityError   = false;
-            this->uartErrors->stopBitsError = false;
+            this->uartErrors.baudRateError = false;
+            this->uartErrors.charSizeError  = false;
+            this->uartErrors.parityError    = false;
+            this->uartErrors.stopBitsError  = false;
 
             this->currentUartProperties.uartBaudIn   = props.uartBaudIn;
             this->currentUartProperties.uartBaudOut  = props.uartBaudOut;
@@ -892,10 +1042,10 @@ namespace BlackLib
         }
         else
         {
-            this->uartErrors->baudRateError = true;
-            this->uartErrors->charSizeError = true;
-            this->uartErrors->parityError   = true;
-            this->uartErrors->stopBitsError = true;
+            this->uartErrors.baudRateError = true;
+            this->uartErrors.charSizeError  = true;
+            this->uartErrors.parityError    = true;
+            this->uartErrors.stopBitsError  = true;
             return false;
         }
 
@@ -906,6 +1056,64 @@ namespace BlackLib
 
 
 
+    bool        BlackUART::readLineCounters(serial_icounter_struct &counters)
+    {
+        memset(&counters, 0, sizeof(counters));
+
+        if( !(this->isOpenFlag) or ioctl(this->uartFD, TIOCGICOUNT, &counters) < 0 )
+        {
+            this->uartErrors.statisticsError = true;
+            return false;
+        }
+
+        this->uartErrors.statisticsError = false;
+        return true;
+    }
+
+    BlackUartStatistics BlackUART::getStatistics()
+    {
+        BlackUartStatistics stats = this->rxStatistics;
+
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        int64_t elapsed = static_cast<int64_t>(now.tv_sec - this->rxStatisticsStart.tv_sec) * 1000000000LL
+                        + (now.tv_nsec - this->rxStatisticsStart.tv_nsec);
+
+        if( elapsed > 0 )
+        {
+            stats.elapsedNanoseconds = elapsed;
+            stats.bytesPerSecond     = static_cast<double>(stats.rxBytes)  * 1e9 / elapsed;
+            stats.chunksPerSecond    = static_cast<double>(stats.rxChunks) * 1e9 / elapsed;
+        }
+
+        serial_icounter_struct counters;
+        if( this->readLineCounters(counters) )
+        {
+            stats.overrunErrors       = counters.overrun     - this->rxCounterBase.overrun;
+            stats.bufferOverrunErrors = counters.buf_overrun - this->rxCounterBase.buf_overrun;
+            stats.framingErrors       = counters.frame       - this->rxCounterBase.frame;
+            stats.parityErrors        = counters.parity      - this->rxCounterBase.parity;
+            stats.breaks              = counters.brk         - this->rxCounterBase.brk;
+        }
+
+        return stats;
+    }
+
+    void        BlackUART::resetStatistics()
+    {
+        this->rxStatistics = BlackUartStatistics();
+        clock_gettime(CLOCK_MONOTONIC, &(this->rxStatisticsStart));
+
+        if( this->isOpenFlag )
+        {
+            this->readLineCounters(this->rxCounterBase);
+        }
+    }
+
+
+
+
     bool        BlackUART::isOpen()
     {
         return this->isOpenFlag;
@@ -921,37 +1129,44 @@ namespace BlackLib
 
     bool        BlackUART::fail()
     {
-        return (this->uartErrors->dtError or
-                this->uartErrors->readError or
-                this->uartErrors->writeError or
-                this->uartErrors->flushError or
-                this->uartErrors->openError or
-                this->uartErrors->closeError or
-                this->uartErrors->directionError or
-                this->uartErrors->baudRateError or
-                this->uartErrors->charSizeError or
-                this->uartErrors->stopBitsError or
-                this->uartErrors->parityError
+        return (this->uartErrors.dtError or
+                this->uartErrors.readError or
+                this->uartErrors.writeError or
+                this->uartErrors.flushError or
+                this->uartErrors.openError or
+                this->uartErrors.closeError or
+                this->uartErrors.directionError or
+                this->uartErrors.baudRateError or
+                this->uartErrors.charSizeError or
+                this->uartErrors.stopBitsError or
+                this->uartErrors.parityError or
+                this->uartErrors.statisticsError
                 );
     }
 
     bool        BlackUART::fail(BlackUART::flags f)
     {
-        if(f==dtErr)            { return this->uartErrors->dtError;         }
-        if(f==readErr)          { return this->uartErrors->readError;       }
-        if(f==writeErr)         { return this->uartErrors->writeError;      }
-        if(f==flushErr)         { return this->uartErrors->flushError;      }
-        if(f==closeErr)         { return this->uartErrors->closeError;      }
-        if(f==openErr)          { return this->uartErrors->openError;       }
-        if(f==directionErr)     { return this->uartErrors->directionError;  }
-        if(f==parityErr)        { return this->uartErrors->parityError;     }
-        if(f==baudRateErr)      { return this->uartErrors->baudRateError;   }
-        if(f==charSizeErr)      { return this->uartErrors->charSizeError;   }
-        if(f==stopBitsErr)      { return this->uartErrors->stopBitsError;   }
+        if(f==dtErr)            { return this->uartErrors.dtError;          }
+        if(f==readErr)          { return this->uartErrors.readError;        }
+        if(f==writeErr)         { return this->uartErrors.writeError;       }
+        if(f==flushErr)         { return this->uartErrors.flushError;       }
+        if(f==closeErr)         { return this->uartErrors.closeError;       }
+        if(f==openErr)          { return this->uartErrors.openError;        }
+        if(f==directionErr)     { return this->uartErrors.directionError;   }
+        if(f==parityErr)        { return this->uartErrors.parityError;      }
+        if(f==baudRateErr)      { return this->uartErrors.baudRateError;    }
+        if(f==charSizeErr)      { return this->uartErrors.charSizeError;    }
+        if(f==stopBitsErr)      { return this->uartErrors.stopBitsError;    }
+        if(f==statisticsErr)    { return this->uartErrors.statisticsError; }
 
         return true;
     }
 
+    BlackIoMetrics *BlackUART::getMetrics()
+    {
+        return &(this->ioMetrics);
+    }
+
 
 
 
@@ -959,11 +1174,11 @@ namespace BlackLib
     {
         if(::write(this->uartFD,writeFromThis.c_str(),writeFromThis.size() ) > 0)
         {
-            this->uartErrors->writeError = false;
+            this->uartErrors.writeError = false;
         }
         else
         {
-            this->uartErrors->writeError = true;
+            this->uartErrors.writeError = true;
         }
 
         return *this;
@@ -977,13 +1192,14 @@ namespace BlackLib
         int readSize = ::read(this->uartFD, &tempReadBuffer[0], tempReadBuffer.size() );
         if( readSize > 0)
         {
-            this->uartErrors->readError = false;
+            this->uartErrors.readError = false;
+            this->updateRxStatistics(readSize);
             tempReadBuffer.resize(readSize);
             readToThis = tempReadBuffer;
         }
         else
         {
-            this->uartErrors->readError = true;
+            this->uartErrors.readError = true;
             readToThis = UART_READ_FAILED;
         }
 
@@ -41,6 +41,11 @@
 
 #include <fcntl.h>
 #include <termios.h>
+#include <time.h>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
 
 
 
@@ -207,6 +212,72 @@ namespace BlackLib
 
 
 
+    // ######################################### BLACKUARTSTATISTICS DECLARATION STARTS ######################################### //
+
+    /*! @brief Holds receive statistics of UART.
+     *
+     *    This struct holds byte and chunk counters of the uart's receive side, the throughput which is
+     *    calculated from these counters, a receive latency histogram and the kernel's line error counters
+     *    which are read with TIOCGICOUNT. Latency is the time between the epoll wakeup of a timestamped
+     *    read and the BlackUART::markConsumed() call of the caller, so it covers the read and the caller's
+     *    own processing of the chunk; chunks which aren't marked aren't sampled. Histogram bucket @a i
+     *    holds the latencies in the range [2^i, 2^(i+1)) microseconds, the first bucket also holds
+     *    latencies under 1 us and the last bucket holds all latencies which don't fit to the others.
+     *    @sa BlackUART::readTimestamped()
+     *    @sa BlackUART::markConsumed()
+     *    @sa BlackUART::getStatistics()
+     */
+    struct BlackUartStatistics
+    {
+        static const unsigned int latencyBucketCount = 16;  /*!< @brief is used to hold the bucket count of latency histogram */
+
+        uint64_t        rxBytes;                            /*!< @brief is used to hold the received byte count */
+        uint64_t        rxChunks;                           /*!< @brief is used to hold the received chunk (successful read call) count */
+        double          bytesPerSecond;                     /*!< @brief is used to hold the received byte rate since last reset */
+        double          chunksPerSecond;                    /*!< @brief is used to hold the received chunk rate since last reset */
+        uint64_t        elapsedNanoseconds;                 /*!< @brief is used to hold the elapsed time since last reset */
+
+        uint64_t        latencyHistogram[latencyBucketCount];   /*!< @brief is used to hold the receive latency histogram */
+        uint64_t        latencyMaxNanoseconds;              /*!< @brief is used to hold the maximum receive latency */
+        uint64_t        latencyTotalNanoseconds;            /*!< @brief is used to hold the sum of receive latencies */
+        uint64_t        latencySamples;                     /*!< @brief is used to hold the sample count of receive latencies */
+
+        uint32_t        overrunErrors;                      /*!< @brief is used to hold the hardware FIFO overrun count (since last reset) */
+        uint32_t        bufferOverrunErrors;                /*!< @brief is used to hold the tty buffer overrun count (since last reset) */
+        uint32_t        framingErrors;                      /*!< @brief is used to hold the framing error count (since last reset) */
+        uint32_t        parityErrors;                       /*!< @brief is used to hold the parity error count (since last reset) */
+        uint32_t        breaks;                             /*!< @brief is used to hold the received break count (since last reset) */
+
+        /*! @brief Default constructor of BlackUartStatistics struct.
+         *
+         *  This function clears all counters.
+         */
+        BlackUartStatistics()
+        {
+            rxBytes                 = 0;
+            rxChunks                = 0;
+            bytesPerSecond          = 0.0;
+            chunksPerSecond         = 0.0;
+            elapsedNanoseconds      = 0;
+            latencyMaxNanoseconds   = 0;
+            latencyTotalNanoseconds = 0;
+            latencySamples          = 0;
+            overrunErrors           = 0;
+            bufferOverrunErrors     = 0;
+            framingErrors           = 0;
+            parityErrors            = 0;
+            breaks                  = 0;
+
+            memset(latencyHistogram, 0, sizeof(latencyHistogram));
+        }
+    };
+    // ########################################## BLACKUARTSTATISTICS DECLARATION ENDS ########################################### //
+
+
+
+
+
+
 
     // ########################################### BLACKUART DECLARATION STARTS ############################################ //
 
@@ -331,16 +402,23 @@ namespace BlackLib
             BlackUartProperties currentUartProperties;      /*!< @brief is used to hold the current properties of uart */
             BlackUartProperties constructorProperties;      /*!< @brief is used to hold the user specified properties of uart */
 
-            errorUART       *uartErrors;                    /*!< @brief is used to hold the errors of BlackUART class */
+            errorUART        uartErrors;                    /*!< @brief is used to hold the errors of BlackUART class */
+            BlackIoMetrics   ioMetrics;                     /*!< @brief is used to hold the I/O metrics of BlackUART class */
 
             std::string     dtUartFilename;                 /*!< @brief is used to hold the uart's device tree overlay name */
             std::string     uartPortPath;                   /*!< @brief is used to hold the uart's tty port path */
+            int             uartPortNumber;                 /*!< @brief is used to hold the uart's port number */
 
             uint32_t        readBufferSize;                 /*!< @brief is used to hold the size of temporary buffer */
             int             uartFD;                         /*!< @brief is used to hold the uart's tty file's file descriptor */
             bool            isOpenFlag;                     /*!< @brief is used to hold the uart's tty file's state */
             bool            isCurrentEqDefault;             /*!< @brief is used to hold the properties of uart is equal to default properties */
 
+            int             epollFD;                        /*!< @brief is used to hold the epoll file descriptor which waits the uart's tty file */
+            BlackUartStatistics rxStatistics;               /*!< @brief is used to hold the receive statistics of uart */
+            timespec        rxStatisticsStart;              /*!< @brief is used to hold the monotonic time of last statistics reset */
+            serial_icounter_struct rxCounterBase;           /*!< @brief is used to hold the kernel line counters at last statistics reset */
+
             /*! @brief Loads UART overlay to device tree.
             *
             *  This function loads @b BlackUART::dtUartFilename named overlay to device tree.
@@ -350,6 +428,21 @@ namespace BlackLib
             */
             bool            loadDeviceTree();
 
+            /*! @brief Updates receive statistics after a successful read.
+            *
+            *  This function increases byte and chunk counters.
+            *  @param [in] readSize        read byte count
+            */
+            void            updateRxStatistics(size_t readSize);
+
+            /*! @brief Reads kernel's line counters of uart.
+            *
+            *  This function reads the interrupt counters of the serial driver with TIOCGICOUNT ioctl.
+            *  @param [out] counters       read counters
+            *  @return True if successful, else false.
+            */
+            bool            readLineCounters(serial_icounter_struct &counters);
+
 
         public:
             /*!
@@ -365,7 +458,8 @@ namespace BlackLib
                                 baudRateErr = 8,    /*!< enumeration for @a errorUART::baudRateError status */
                                 parityErr   = 9,    /*!< enumeration for @a errorUART::parityError status */
                                 stopBitsErr = 10,   /*!< enumeration for @a errorUART::stopBitsError status */
-                                charSizeErr = 11    /*!< enumeration for @a errorUART::charSizeError status */
+                                charSizeErr = 11,   /*!< enumeration for @a errorUART::charSizeError status */
+                                statisticsErr = 12  /*!< enumeration for @a errorUART::statisticsError status */
                             };
 
             /*! @brief Constructor of BlackUART class.
@@ -462,7 +556,7 @@ namespace BlackLib
 
             /*! @brief Destructor of BlackUART class.
             *
-            * This function closes TTY file and deletes errorUART struct pointer.
+            * This function closes TTY file.
             */
             virtual ~BlackUART();
 
@@ -618,6 +712,70 @@ namespace BlackLib
             */
             bool            read(char *readBuffer, size_t size);
 
+            /*! @brief Reads values from uart line to the buffer and returns the read size with an error code.
+            *
+            *  Values are read directly to the buffer and the rest of the buffer isn't touched.
+            *
+            *  @param [out] readBuffer  buffer pointer
+            *  @param [in] size         buffer size
+            *  @return Read byte count, or BlackLib::BlackError::NotReady or ReadFailed.
+            */
+            BlackResult<size_t> tryRead(char *readBuffer, size_t size);
+
+            /*! @brief Waits and reads values from uart line with receive timestamp.
+            *
+            * This function waits the uart's tty file with epoll until data arrives or timeout expires. Then it
+            * takes @b CLOCK_MONOTONIC timestamp immediately after the wakeup and reads available values to
+            * @a @b readBuffer pointer directly. The timestamp should be passed to markConsumed() after the
+            * chunk is processed, to record the receive latency.
+            *
+            * @param [out] readBuffer          buffer pointer
+            * @param [in] size                 buffer size
+            * @param [out] rxTimestamp         monotonic receive time of the read chunk
+            * @param [in] timeout_ms           waiting timeout in milliseconds, -1 means wait forever
+            * @return read byte count if reading successful, 0 if timeout expires or nothing is available, else -1.
+            *
+            * @par Example
+            *  @code{.cpp}
+            *
+            *   BlackLib::BlackUART  myUart(BlackLib::UART1,
+            *                               BlackLib::Baud9600,
+            *                               BlackLib::ParityEven,
+            *                               BlackLib::StopOne,
+            *                               BlackLib::Char8 );
+            *
+            *   myUart.open( BlackLib::ReadWrite | BlackLib::NonBlock );
+            *
+            *   char readBuffer[64];
+            *   timespec rxTime;
+            *   int readSize = myUart.readTimestamped(readBuffer, sizeof(readBuffer), rxTime, 100);
+            *
+            *   if( readSize > 0 )
+            *   {
+            *       std::cout << readSize << " bytes received at " << rxTime.tv_sec << "." << rxTime.tv_nsec;
+            *       myUart.markConsumed(rxTime);
+            *   }
+            *
+            * @endcode
+            * @code{.cpp}
+            *   // Possible Output:
+            *   // 14 bytes received at 1532.418230911
+            * @endcode
+            * @sa BlackUART::markConsumed()
+            * @sa BlackUART::getStatistics()
+            */
+            int             readTimestamped(char *readBuffer, size_t size, timespec &rxTimestamp, int timeout_ms = -1);
+
+            /*! @brief Records the receive latency of a chunk which is read with readTimestamped().
+            *
+            * This function should be called when the caller finishes processing the chunk. The time
+            * between @a @b rxTimestamp and now is added to the latency histogram of receive statistics.
+            *
+            * @param [in] rxTimestamp          timestamp which is exported by readTimestamped()
+            * @sa BlackUART::getStatistics()
+            */
+            void            markConsumed(const timespec &rxTimestamp);
+
             /*! @brief Writes values to uart line.
             *
             * This function writes values to uart line. Values sent to this function as string type.
@@ -691,6 +849,14 @@ namespace BlackLib
             */
             bool            write(char *writeBuffer, size_t size);
 
+            /*! @brief Writes values to uart line and returns the written size with an error code.
+            *
+            *  @param [in] writeBuffer  buffer pointer
+            *  @param [in] size         buffer size
+            *  @return Written byte count, or BlackLib::BlackError::NotReady or WriteFailed.
+            */
+            BlackResult<size_t> tryWrite(const char *writeBuffer, size_t size);
+
             /*! @brief Writes and reads values sequentially to/from uart line.
             *
             * This function writes values to uart line firstly and then reads values from uart line and saves read
@@ -1135,6 +1301,53 @@ namespace BlackLib
             */
             characterSize   getCharacterSize();
 
+            /*! @brief Exports receive statistics of uart.
+            *
+            * This function calculates byte and chunk rates since last reset and reads kernel's overrun,
+            * framing, parity and break counters with TIOCGICOUNT. Kernel counters are exported as
+            * differences from the values at last reset. If counters can't be read, this function sets
+            * errorUART::statisticsError flag and leaves these counters as zero.
+            *
+            * @return receive statistics of uart.
+            *
+            * @par Example
+            *  @code{.cpp}
+            *   BlackLib::BlackUART  myUart(BlackLib::UART1,
+            *                               BlackLib::Baud9600,
+            *                               BlackLib::ParityEven,
+            *                               BlackLib::StopOne,
+            *                               BlackLib::Char8 );
+            *
+            *   myUart.open( BlackLib::ReadWrite | BlackLib::NonBlock );
+            *   myUart.resetStatistics();
+            *
+            *   // ... receive data with read functions ...
+            *
+            *   BlackLib::BlackUartStatistics stats = myUart.getStatistics();
+            *   std::cout << "Rate: " << stats.bytesPerSecond << " B/s" << std::endl;
+            *   std::cout << "Overruns: " << stats.overrunErrors << std::endl;
+            *
+            * @endcode
+            * @code{.cpp}
+            *   // Possible Output:
+            *   // Rate: 958.2 B/s
+            *   // Overruns: 0
+            * @endcode
+            *
+            * @sa BlackUartStatistics
+            */
+            BlackUartStatistics getStatistics();
+
+            /*! @brief Clears receive statistics of uart.
+            *
+            * This function clears all counters and histogram, restarts rate measurement and takes current
+            * kernel line counters as new base values.
+            *
+            * @par Example
+            *   Example usage is shown in BlackUART::getStatistics() function's example.
+            */
+            void            resetStatistics();
+
             /*! @brief Checks uart's tty file's open state.
             *
             * @return true if tty file is open, else false.
@@ -1302,6 +1515,18 @@ namespace BlackLib
             */
             bool            fail(BlackUART::flags f);
 
+            /*! @brief Exports I/O metrics of the object.
+            *
+            * Operations aren't measured until the returned metrics are registered with BlackMetrics::add().
+            * @return Pointer of BlackUART::ioMetrics variable.
+            *
+            * @par Example
+            * @code{.cpp}
+            *   BlackLib::BlackMetrics::add("my_uart", myUart.getMetrics());
+            * @endcode
+            */
+            BlackIoMetrics *getMetrics();
+
 
             /*! @brief Writes values to uart line with "<<" operator.
             *
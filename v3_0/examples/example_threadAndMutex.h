@@ -133,7 +133,7 @@ class Task4 : public BlackLib::BlackThread
 
         void onStartHandler()
         {
-            while( this->goAhead )
+            while( this->goAhead and this->checkPoint() )
             {
                 this->myString += "current loop is: " + BlackLib::tostr(this->currentLoop) + "\n";
                 this->currentLoop++;
@@ -181,7 +181,9 @@ void example_threadAndMutex()
 
 
     BlackLib::BlackThread::sleep(20);
-    t4->pause();
+    t4->requestPause();                 // t4 pauses at its next checkPoint() call
+    BlackLib::BlackThread::sleep(2);
+    t4->resume();
 
 
     bool conditionVariable = true;